@@ -92,12 +92,16 @@ namespace Kernel {
 	 *
 	 * \param  duration_us  timeout duration in microseconds
 	 * \param  sigid        local name of signal context to trigger
+	 * \param  slack_us     tolerated delay of the timeout in microseconds
 	 *
-	 * This call overwrites the last timeout installed by the thread.
+	 * This call overwrites the last timeout installed by the thread. The
+	 * slack allows the kernel to merge the timeout with other timeouts of
+	 * the CPU into one timer interrupt.
 	 */
-	inline int timeout(timeout_t const duration_us, capid_t const sigid)
+	inline int timeout(timeout_t const duration_us, capid_t const sigid,
+	                   timeout_t const slack_us = 0)
 	{
-		return (int)call(call_id_timeout(), duration_us, sigid);
+		return (int)call(call_id_timeout(), duration_us, sigid, slack_us);
 	}
 
 
@@ -31,6 +31,16 @@ namespace Kernel {
 
 	/* time slice for the round-robin mode and the idle in CPU scheduling */
 	constexpr time_t cpu_fill_us = 10000;
+
+	/*
+	 * Tolerated delay of the end of an idle time slice
+	 *
+	 * An idle CPU skips the ticks of its time slices up to this delay unless
+	 * a timeout of another thread triggers earlier. CPUs with work an idle
+	 * CPU may take over kick the idle CPU by an IPI instead of waiting for
+	 * its next tick.
+	 */
+	constexpr time_t cpu_idle_slack_us = 90000;
 }
 
 #endif /* _CORE__KERNEL__CONFIGURATION_H_ */
@@ -67,6 +67,7 @@ namespace Kernel {
 	constexpr Call_arg call_id_exception_state()        { return 126; }
 	constexpr Call_arg call_id_single_step()            { return 127; }
 	constexpr Call_arg call_id_ack_pager_signal()       { return 128; }
+	constexpr Call_arg call_id_thread_migration()       { return 129; }
 
 	/**
 	 * Invalidate TLB entries for the `pd` in region `addr`, `sz`
@@ -91,6 +92,22 @@ namespace Kernel {
 	}
 
 
+	/**
+	 * Configure the CPUs that may take over a thread when idle
+	 *
+	 * \param thread     kernel object of the targeted thread
+	 * \param first_cpu  kernel name of the first CPU
+	 * \param num_cpus   number of CPUs, a value below 2 pins the thread
+	 *                   to its current CPU
+	 */
+	inline void thread_migration(Kernel::Thread & thread, unsigned const first_cpu,
+	                             unsigned const num_cpus)
+	{
+		call(call_id_thread_migration(), (Call_arg)&thread, (Call_arg)first_cpu,
+		     (Call_arg)num_cpus);
+	}
+
+
 	/**
 	 * Pause execution of a thread until 'resume_thread' is called on it
 	 *
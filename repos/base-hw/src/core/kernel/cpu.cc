@@ -76,6 +76,9 @@ void Cpu_context::affinity(Cpu &cpu)
 }
 
 
+unsigned Cpu_context::cpu_id() const { return _cpu().id(); }
+
+
 void Cpu_context::quota(unsigned const q)
 {
 	_cpu().scheduler().quota(*this, q);
@@ -124,6 +127,37 @@ void Cpu::assign(Context &context)
 	_scheduler.ready(static_cast<Scheduler::Context&>(context));
 	if (_id != executing_id() && _scheduler.need_to_schedule())
 		trigger_ip_interrupt();
+
+	if (&current_context() != &_idle && &current_context() != &context)
+		_notify_idle_cpu(context);
+}
+
+
+void Cpu::_notify_idle_cpu(Context const &context)
+{
+	if (!context._migration_count || context._cpu_local_state())
+		return;
+
+	bool notified = false;
+
+	_cpu_pool.for_each_cpu([&] (Cpu &cpu) {
+
+		if (notified || &cpu == this || cpu._state != RUN)
+			return;
+
+		if (&cpu.current_context() != &cpu._idle || !context._stealable_by(cpu._id))
+			return;
+
+		/*
+		 * The idle CPU defers its timer interrupt by 'cpu_idle_slack_us'.
+		 * Hence, kick it to look for work right away.
+		 */
+		cpu._steal_requested = true;
+		if (cpu._id != executing_id())
+			cpu.trigger_ip_interrupt();
+
+		notified = true;
+	});
 }
 
 
@@ -144,12 +178,22 @@ Cpu::Context & Cpu::schedule_next_context(Context &last)
 	if (_state == SUSPEND || _state == HALT)
 		return _halt_job;
 
+	/* another CPU may have work for this idle CPU */
+	bool const steal_requested = _steal_requested;
+	_steal_requested = false;
+
 	/* update schedule if necessary */
-	if (_scheduler.need_to_schedule()) {
+	if (_scheduler.need_to_schedule() || steal_requested) {
 		_timer.process_timeouts();
 		_scheduler.update(_timer.time());
+
+		/* rather than idling, take over work of a busy CPU */
+		if (&current_context() == &_idle && _steal_context())
+			_scheduler.update(_timer.time());
 		time_t t = _scheduler.current_time_left();
-		_timer.set_timeout(&_timeout, t);
+		time_t const slack = (&current_context() == &_idle)
+		                   ? _timer.us_to_ticks(cpu_idle_slack_us) : 0;
+		_timer.set_timeout(&_timeout, t, slack);
 		time_t duration = _timer.schedule_timeout();
 		last.update_execution_time(duration);
 	}
@@ -159,6 +203,32 @@ Cpu::Context & Cpu::schedule_next_context(Context &last)
 }
 
 
+bool Cpu::_steal_context()
+{
+	Cpu_context *stolen = nullptr;
+
+	_cpu_pool.for_each_cpu([&] (Cpu &cpu) {
+
+		if (stolen || &cpu == this || cpu._state != RUN)
+			return;
+
+		Scheduler::Context * const context = cpu._scheduler.stealable(
+			[&] (Scheduler::Context const &c) {
+				return static_cast<Cpu_context const &>(c)._stealable_by(_id); });
+
+		if (context)
+			stolen = static_cast<Cpu_context *>(context);
+	});
+
+	if (!stolen)
+		return false;
+
+	stolen->affinity(*this);
+	_scheduler.ready(static_cast<Scheduler::Context&>(*stolen));
+	return true;
+}
+
+
 addr_t Cpu::stack_base()
 {
 	return Hw::Mm::cpu_local_memory().base +
@@ -186,7 +256,8 @@ Cpu::Cpu(unsigned                     const  id,
 	_idle             { addr_space_id_alloc, user_irq_pool, cpu_pool, *this,
 	                    core_pd },
 	_ipi_irq          { *this },
-	_global_work_list { cpu_pool.work_list() }
+	_global_work_list { cpu_pool.work_list() },
+	_cpu_pool         { cpu_pool }
 {
 	_arch_init();
 
@@ -108,7 +108,25 @@ class Kernel::Cpu : public Core::Cpu, private Irq::Pool,
 		Inter_processor_work_list &_global_work_list;
 		Inter_processor_work_list  _local_work_list {};
 
+		Cpu_pool &_cpu_pool;
+
+		/* set by another CPU with work this idle CPU may take over */
+		bool _steal_requested { false };
+
 		void     _arch_init();
+
+		/**
+		 * Take over a context waiting on another CPU
+		 *
+		 * \return true if a context got assigned to this CPU
+		 */
+		bool _steal_context();
+
+		/**
+		 * Let an idle CPU take over 'context', which waits on this CPU
+		 */
+		void _notify_idle_cpu(Context const &context);
+
 		unsigned _quota() const { return (unsigned)_timer.us_to_ticks(cpu_quota_us); }
 		unsigned _fill() const  { return (unsigned)_timer.us_to_ticks(cpu_fill_us); }
 
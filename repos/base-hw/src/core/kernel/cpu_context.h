@@ -38,6 +38,27 @@ class Kernel::Cpu_context : private Scheduler::Context
 		time_t _execution_time { 0 };
 		Cpu   *_cpu_ptr;
 
+		/* CPUs that may take over the context when idle */
+		unsigned _migration_first { 0 };
+		unsigned _migration_count { 0 };
+
+		bool _migratable_to(unsigned const cpu_id) const
+		{
+			return cpu_id >= _migration_first
+			    && cpu_id -  _migration_first < _migration_count;
+		}
+
+		/**
+		 * Return true if the context has state bound to its CPU
+		 *
+		 * For instance, a pending timeout is linked into the timeout list
+		 * of the CPU. Such a context must not be taken over by another CPU.
+		 */
+		virtual bool _cpu_local_state() const { return false; }
+
+		bool _stealable_by(unsigned const cpu_id) const {
+			return _migratable_to(cpu_id) && !_cpu_local_state(); }
+
 		/*
 		 * Noncopyable
 		 */
@@ -93,6 +114,18 @@ class Kernel::Cpu_context : private Scheduler::Context
 		 */
 		void quota(unsigned const q);
 
+		/**
+		 * Allow idle CPUs 'first' to 'first + count - 1' to take over the context
+		 *
+		 * By default, a context is pinned to its CPU, which is the case for
+		 * a 'count' of 0 or 1.
+		 */
+		void migration(unsigned const first, unsigned const count)
+		{
+			_migration_first = first;
+			_migration_count = (count > 1) ? count : 0;
+		}
+
 		/**
 		 * Update total execution time
 		 */
@@ -103,6 +136,14 @@ class Kernel::Cpu_context : private Scheduler::Context
 		 */
 		time_t execution_time() const { return _execution_time; }
 
+		/**
+		 * Return kernel name of the CPU the context is assigned to
+		 *
+		 * The CPU differs from the initial one once the context got taken
+		 * over by an idle CPU.
+		 */
+		unsigned cpu_id() const;
+
 		/**
 		 * Handle exception that occured during execution of this context
 		 */
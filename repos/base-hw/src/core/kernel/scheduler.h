@@ -252,6 +252,38 @@ class Kernel::Scheduler
 		 */
 		void quota(Context &context, unsigned const quota);
 
+		/**
+		 * Return a context another CPU may take over, or nullptr
+		 *
+		 * Candidates are ready contexts of the fill queue that wait while
+		 * another context executes. Contexts with prioritized time left
+		 * and contexts involved in helping are not considered. Of the
+		 * candidates accepted by 'fn', the one closest to the tail of the
+		 * queue is returned, i.e., the one that would be scheduled last.
+		 */
+		Context *stealable(auto const &fn)
+		{
+			if (!_current || _current == &_idle)
+				return nullptr;
+
+			Context const &running = _current->helping_destination();
+
+			Context *result = nullptr;
+			_slack_list.for_each([&] (Context &c) {
+
+				if (&c == _current || &c == &running)
+					return;
+
+				if (c._priotized_time_left || c._destination ||
+				    c._helper_list.first())
+					return;
+
+				if (fn(c))
+					result = &c;
+			});
+			return result;
+		}
+
 		Context& current();
 
 		unsigned current_time_left() const {
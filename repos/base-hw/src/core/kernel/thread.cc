@@ -305,6 +305,13 @@ void Thread::_call_thread_quota()
 }
 
 
+void Thread::_call_thread_migration()
+{
+	Thread * const thread = (Thread *)user_arg_1();
+	thread->Cpu_context::migration((unsigned)user_arg_2(), (unsigned)user_arg_3());
+}
+
+
 void Thread::_call_start_thread()
 {
 	user_arg_0(0);
@@ -501,7 +508,7 @@ void Thread::_call_timeout()
 {
 	Timer & t = _cpu().timer();
 	_timeout_sigid = (Kernel::capid_t)user_arg_2();
-	t.set_timeout(this, t.us_to_ticks(user_arg_1()));
+	t.set_timeout(this, t.us_to_ticks(user_arg_1()), t.us_to_ticks(user_arg_3()));
 }
 
 
@@ -867,6 +874,7 @@ void Thread::_call()
 		                  _core_pd, (char const *) user_arg_3());
 		return;
 	case call_id_thread_quota():           _call_thread_quota(); return;
+	case call_id_thread_migration():       _call_thread_migration(); return;
 	case call_id_delete_thread():          _call_delete_thread(); return;
 	case call_id_start_thread():           _call_start_thread(); return;
 	case call_id_resume_thread():          _call_resume_thread(); return;
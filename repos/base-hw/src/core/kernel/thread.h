@@ -266,6 +266,7 @@ class Kernel::Thread : private Kernel::Object, public Cpu_context, private Timeo
 		void _call_new_thread();
 		void _call_new_core_thread();
 		void _call_thread_quota();
+		void _call_thread_migration();
 		void _call_start_thread();
 		void _call_stop_thread();
 		void _call_pause_thread();
@@ -480,6 +481,8 @@ class Kernel::Thread : private Kernel::Object, public Cpu_context, private Timeo
 
 		void timeout_triggered() override;
 
+		bool _cpu_local_state() const override { return Timeout::listed(); }
+
 
 		/***************
 		 ** Accessors **
@@ -0,0 +1,135 @@
+/*
+ * \brief   Timeouts of the kernel timer and their coalescing
+ * \author  Genode Labs
+ * \date    2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CORE__KERNEL__TIMEOUT_H_
+#define _CORE__KERNEL__TIMEOUT_H_
+
+/* base-hw includes */
+#include <kernel/types.h>
+
+/* Genode includes */
+#include <util/list.h>
+#include <util/misc_math.h>
+
+namespace Kernel {
+	class Timeout;
+	class Timeout_list;
+}
+
+
+/**
+ * A timeout causes a kernel pass and the call of a timeout specific handle
+ */
+class Kernel::Timeout : Genode::List<Timeout>::Element
+{
+	friend class Timeout_list;
+	friend class Genode::List<Timeout>;
+
+	private:
+
+		bool   _listed     = false;
+		time_t _end        = 0;
+		time_t _slack      = 0;
+
+	public:
+
+		/**
+		 * Callback handle
+		 */
+		virtual void timeout_triggered() { }
+
+		bool listed() const { return _listed; }
+
+		virtual ~Timeout() { }
+};
+
+
+/**
+ * Timeouts ordered ascending according to their end time
+ */
+class Kernel::Timeout_list
+{
+	private:
+
+		Genode::List<Timeout> _list { };
+
+	public:
+
+		/**
+		 * Insert timeout, or re-insert it if it is already listed
+		 *
+		 * \param end    absolute time in ticks when the timeout triggers
+		 * \param slack  ticks the timeout may be deferred in favour of
+		 *               triggering it together with later timeouts
+		 */
+		void insert(Timeout &timeout, time_t const end, time_t const slack)
+		{
+			if (timeout._listed)
+				_list.remove(&timeout);
+			else
+				timeout._listed = true;
+
+			timeout._end   = end;
+			timeout._slack = slack;
+
+			Timeout * t1 = 0;
+			for (Timeout * t2 = _list.first();
+			     t2 && t2->_end < timeout._end;
+			     t1 = t2, t2 = t2->next()) { }
+
+			_list.insert(&timeout, t1);
+		}
+
+		/**
+		 * Remove and return the first timeout that ended at 'time'
+		 *
+		 * \return nullptr if no listed timeout is due
+		 */
+		Timeout *dequeue_due(time_t const time)
+		{
+			Timeout * const timeout = _list.first();
+			if (!timeout || timeout->_end > time)
+				return nullptr;
+
+			_list.remove(timeout);
+			timeout->_listed = false;
+			return timeout;
+		}
+
+		bool empty() const { return !_list.first(); }
+
+		/**
+		 * Return time at which the timer interrupt is due
+		 *
+		 * Timeouts are coalesced by deferring the interrupt as long as no
+		 * timeout is delayed beyond its slack. All timeouts that end until
+		 * then are served by the same interrupt. Timeouts ending later do
+		 * not limit the deferral because they need another interrupt anyway.
+		 *
+		 * The list must not be empty.
+		 */
+		time_t deadline() const
+		{
+			Timeout const * timeout = _list.first();
+
+			time_t limit = timeout->_end + timeout->_slack;
+
+			for (timeout = timeout->next(); timeout && timeout->_end <= limit;
+			     timeout = timeout->next())
+				limit = Genode::min(limit, timeout->_end + timeout->_slack);
+
+			return limit;
+		}
+};
+
+#endif /* _CORE__KERNEL__TIMEOUT_H_ */
@@ -36,43 +36,29 @@ time_t Timer::timeout_max_us() const
 }
 
 
-void Timer::set_timeout(Timeout * const timeout, time_t const duration)
+void Timer::set_timeout(Timeout * const timeout, time_t const duration,
+                        time_t const slack)
 {
 	/*
-	 * Remove timeout if it is already in use. Timeouts may get overridden as
-	 * result of an update.
+	 * Timeouts may get overridden as result of an update, in which case
+	 * the timeout gets re-inserted.
 	 */
-	if (timeout->_listed)
-		_timeout_list.remove(timeout);
-	else
-		timeout->_listed = true;
-
-	/* set timeout parameters */
-	timeout->_end = time() + duration;
-
-	/*
-	 * Insert timeout. Timeouts are ordered ascending according to their end
-	 * time to be able to quickly determine the nearest timeout.
-	 */
-	Timeout * t1 = 0;
-	for (Timeout * t2 = _timeout_list.first();
-	     t2 && t2->_end < timeout->_end;
-	     t1 = t2, t2 = t2->next()) { }
-
-	_timeout_list.insert(timeout, t1);
+	_timeout_list.insert(*timeout, time() + duration, slack);
 }
 
 
 time_t Timer::schedule_timeout()
 {
-	/* get the timeout with the nearest end time */
-	Timeout * timeout = _timeout_list.first();
-	assert(timeout);
+	assert(!_timeout_list.empty());
+
+	/* coalesce the nearest timeouts within their slack */
+	time_t const end = _timeout_list.deadline();
 
 	/* install timeout at timer hardware */
 	time_t duration = _duration();
 	_time          += duration;
-	_last_timeout_duration = (timeout->_end > _time) ? timeout->_end - _time : 1;
+	_last_timeout_duration = (end > _time) ? Genode::min(end - _time, _max_value())
+	                                       : 1;
 	_start_one_shot(_last_timeout_duration);
 
 	return duration;
@@ -83,20 +69,11 @@ void Timer::process_timeouts()
 {
 	/*
 	 * Walk through timeouts until the first whose end time is in the future.
+	 * With coalescing, this includes timeouts deferred within their slack.
 	 */
-	time_t t = time();
-	while (true) {
-		Timeout * const timeout = _timeout_list.first();
-		if (!timeout)
-			break;
-
-		if (timeout->_end > t)
-			break;
-
-		_timeout_list.remove(timeout);
-		timeout->_listed = false;
+	time_t const t = time();
+	while (Timeout * const timeout = _timeout_list.dequeue_due(t))
 		timeout->timeout_triggered();
-	}
 }
 
 
@@ -17,43 +17,16 @@
 /* base-hw includes */
 #include <kernel/types.h>
 #include <kernel/irq.h>
-
-/* Genode includes */
-#include <util/list.h>
+#include <kernel/timeout.h>
 
 #include <board.h>
 
 namespace Kernel {
 	class Cpu;
-	class Timeout;
 	class Timer;
 }
 
 
-/**
- * A timeout causes a kernel pass and the call of a timeout specific handle
- */
-class Kernel::Timeout : Genode::List<Timeout>::Element
-{
-	friend class Timer;
-	friend class Genode::List<Timeout>;
-
-	private:
-
-		bool   _listed     = false;
-		time_t _end        = 0;
-
-	public:
-
-		/**
-		 * Callback handle
-		 */
-		virtual void timeout_triggered() { }
-
-		virtual ~Timeout() { }
-};
-
-
 /**
  * A timer manages a continuous time and timeouts on it
  */
@@ -78,7 +51,7 @@ class Kernel::Timer
 		Irq                   _irq;
 		time_t                _time = 0;
 		time_t                _last_timeout_duration;
-		Genode::List<Timeout> _timeout_list {};
+		Timeout_list          _timeout_list {};
 
 		void _start_one_shot(time_t const ticks);
 
@@ -99,7 +72,15 @@ class Kernel::Timer
 
 		void process_timeouts();
 
-		void set_timeout(Timeout * const timeout, time_t const duration);
+		/**
+		 * Install timeout
+		 *
+		 * \param duration  ticks until the timeout triggers
+		 * \param slack     ticks the timeout may be deferred in favour of
+		 *                  triggering it together with later timeouts
+		 */
+		void set_timeout(Timeout * const timeout, time_t const duration,
+		                 time_t const slack = 0);
 
 		time_t us_to_ticks(time_t const us) const;
 
@@ -141,13 +141,29 @@ Platform_thread::~Platform_thread()
 }
 
 
-void Platform_thread::affinity(Affinity::Location const &)
+void Platform_thread::affinity(Affinity::Location const &location)
 {
-	/* yet no migration support, don't claim wrong location, e.g. for tracing */
+	/*
+	 * Yet no explicit migration support. However, a location spanning
+	 * multiple CPUs permits idle CPUs of this range to take over the thread
+	 * whereas a location of a single CPU pins the thread to its current CPU.
+	 */
+	unsigned const num_cpus = (location.height() == 1) ? location.width() : 1;
+
+	Kernel::thread_migration(*_kobj, unsigned(location.xpos()), num_cpus);
 }
 
 
-Affinity::Location Platform_thread::affinity() const { return _location; }
+Affinity::Location Platform_thread::affinity() const
+{
+	/*
+	 * Report the CPU the thread is currently assigned to, which differs from
+	 * the initial one once an idle CPU took over the thread
+	 */
+	unsigned const cpu = const_cast<Platform_thread *>(this)->_kobj->cpu_id();
+
+	return Affinity::Location(int(cpu), _location.ypos(), 1, 1);
+}
 
 
 void Platform_thread::start(void * const ip, void * const sp)
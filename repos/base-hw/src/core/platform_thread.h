@@ -263,7 +263,8 @@ class Core::Platform_thread : Noncopyable
 		/**
 		 * Set the executing CPU for this thread
 		 *
-		 * \param location  targeted location in affinity space
+		 * \param location  targeted location in physical affinity space,
+		 *                  the thread may run on any CPU of the location
 		 */
 		void affinity(Affinity::Location const & location);
 
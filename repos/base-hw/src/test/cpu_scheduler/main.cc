@@ -18,6 +18,8 @@
 
 /* core includes */
 #include <kernel/scheduler.h>
+#include <kernel/timeout.h>
+#include <kernel/configuration.h>
 
 using namespace Genode;
 using namespace Kernel;
@@ -225,6 +227,39 @@ class Scheduler_test::Main
 			}
 		}
 
+		void _check(bool const condition, unsigned const line_nr)
+		{
+			if (condition)
+				return;
+
+			error("failed check in line ", line_nr);
+			_env.parent().exit(-1);
+		}
+
+		/**
+		 * Check the selection of contexts another CPU may take over
+		 */
+		void _test_stealable();
+
+		/**
+		 * Simulate two CPUs with the whole load initially at the first one
+		 *
+		 * \return  time both CPUs spent executing contexts other than idle
+		 */
+		time_t _unbalanced_busy_time(bool const steal);
+
+		/**
+		 * Check the coalescing of kernel timeouts within their slack
+		 */
+		void _test_timeout_coalescing();
+
+		/**
+		 * Simulate the timer interrupts of an idle CPU during one second
+		 *
+		 * \return  number of timer interrupts
+		 */
+		unsigned _idle_timer_interrupts(time_t const idle_slack);
+
 	public:
 
 		Main(Env &env);
@@ -365,6 +400,183 @@ void Scheduler_test::Scheduler::print(Output &output) const
  ** Scheduler_test::Main **
  ******************************/
 
+void Scheduler_test::Main::_test_stealable()
+{
+	Context idle { 0, 0, "idle" };
+	Context a    { 0, 0, "a" }, b { 0, 0, "b" }, c { 0, 0, "c" };
+	Context p    { 3, 100, "p" };
+
+	Scheduler scheduler { idle, 1000, 100 };
+
+	auto any = [] (Kernel::Scheduler::Context const &) { return true; };
+
+	scheduler.insert(a);
+	scheduler.insert(b);
+	scheduler.insert(c);
+	scheduler.insert(p);
+
+	/* nothing to take over from an idle CPU */
+	_check(scheduler.stealable(any) == nullptr, __LINE__);
+
+	/* the executing context is never taken over */
+	scheduler.ready(a);
+	scheduler.update(10);
+	_check(&scheduler.current() == &a, __LINE__);
+	_check(scheduler.stealable(any) == nullptr, __LINE__);
+
+	/* the waiting context scheduled last is preferred */
+	scheduler.ready(b);
+	scheduler.ready(c);
+	_check(scheduler.stealable(any) == &b, __LINE__);
+
+	_check(scheduler.stealable([&] (Kernel::Scheduler::Context const &ctx) {
+		return &ctx != &b; }) == &c, __LINE__);
+
+	/* contexts with prioritized time left stay */
+	scheduler.ready(p);
+	_check(scheduler.stealable([&] (Kernel::Scheduler::Context const &ctx) {
+		return &ctx == &p; }) == nullptr, __LINE__);
+
+	/* hand over 'b' to another CPU */
+	Context   other_idle { 0, 0, "other_idle" };
+	Scheduler other      { other_idle, 1000, 100 };
+
+	scheduler.remove(b);
+	other.insert(b);
+	other.ready(b);
+	other.update(10);
+	_check(&other.current() == &b, __LINE__);
+
+	other.remove(b);
+	scheduler.remove(a);
+	scheduler.remove(c);
+	scheduler.remove(p);
+}
+
+
+time_t Scheduler_test::Main::_unbalanced_busy_time(bool const steal)
+{
+	enum { NUM_CONTEXTS = 4, NUM_STEPS = 100, STEP = 10 };
+
+	Context idle_0 { 0, 0, "idle_0" }, idle_1 { 0, 0, "idle_1" };
+
+	Scheduler cpu_0 { idle_0, 1000, 100 }, cpu_1 { idle_1, 1000, 100 };
+
+	struct Cpu { Scheduler &scheduler; Context &idle; } cpus[] {
+		{ cpu_0, idle_0 }, { cpu_1, idle_1 } };
+
+	Constructible<Context> contexts[NUM_CONTEXTS] { };
+	Scheduler             *home    [NUM_CONTEXTS] { };
+
+	for (unsigned i = 0; i < NUM_CONTEXTS; i++) {
+		contexts[i].construct(0, 0, String<32>("load_", i));
+		home[i] = &cpu_0;
+		cpu_0.insert(*contexts[i]);
+		cpu_0.ready(*contexts[i]);
+	}
+
+	time_t time = 0, busy = 0;
+
+	for (unsigned step = 0; step < NUM_STEPS; step++) {
+
+		time += STEP;
+
+		for (unsigned i = 0; i < 2; i++) {
+
+			Scheduler &thief  = cpus[i].scheduler;
+			Scheduler &victim = cpus[(i + 1) % 2].scheduler;
+
+			thief.update(time);
+
+			if (steal && &thief.current() == &cpus[i].idle) {
+
+				Kernel::Scheduler::Context * const stolen = victim.stealable(
+					[] (Kernel::Scheduler::Context const &) { return true; });
+
+				if (stolen) {
+					victim.remove(*stolen);
+					thief.insert(*stolen);
+					thief.ready(*stolen);
+					thief.update(time);
+
+					for (unsigned j = 0; j < NUM_CONTEXTS; j++)
+						if (&*contexts[j] == stolen)
+							home[j] = &thief;
+				}
+			}
+
+			if (&thief.current() != &cpus[i].idle)
+				busy += STEP;
+		}
+	}
+
+	for (unsigned i = 0; i < NUM_CONTEXTS; i++)
+		home[i]->remove(*contexts[i]);
+
+	return busy;
+}
+
+
+void Scheduler_test::Main::_test_timeout_coalescing()
+{
+	struct Timeout : Kernel::Timeout
+	{
+		unsigned triggered = 0;
+
+		void timeout_triggered() override { triggered++; }
+	};
+
+	Timeout_list list { };
+	Timeout      idle { }, user { };
+
+	/* the slack of a sole timeout defers the interrupt */
+	list.insert(idle, 100, 900);
+	_check(list.deadline() == 1000, __LINE__);
+
+	/* a timeout without slack is not deferred */
+	list.insert(idle, 100, 0);
+	_check(list.deadline() == 100, __LINE__);
+
+	/* a later timeout within the slack caps the deferral */
+	list.insert(idle, 100, 900);
+	list.insert(user, 300, 0);
+	_check(list.deadline() == 300, __LINE__);
+
+	/* a timeout beyond the slack does not cap it */
+	list.insert(user, 2000, 0);
+	_check(list.deadline() == 1000, __LINE__);
+
+	/* the deferred timeout is due at the deadline, the later one is not */
+	while (Kernel::Timeout * const t = list.dequeue_due(1000))
+		t->timeout_triggered();
+
+	_check(idle.triggered == 1 && user.triggered == 0, __LINE__);
+	_check(list.deadline() == 2000, __LINE__);
+
+	while (Kernel::Timeout * const t = list.dequeue_due(2000))
+		t->timeout_triggered();
+
+	_check(user.triggered == 1 && list.empty(), __LINE__);
+}
+
+
+unsigned Scheduler_test::Main::_idle_timer_interrupts(time_t const idle_slack)
+{
+	Timeout_list    list    { };
+	Kernel::Timeout timeout { };
+
+	unsigned interrupts = 0;
+
+	/* like 'Cpu::schedule_next_context' with the idle context current */
+	for (time_t time = 0; time < 1000000; interrupts++) {
+		list.insert(timeout, time + cpu_fill_us, idle_slack);
+		time = list.deadline();
+		while (list.dequeue_due(time));
+	}
+	return interrupts;
+}
+
+
 Scheduler_test::Main::Main(Env &env)
 :
 	_env       { env },
@@ -902,6 +1114,36 @@ Scheduler_test::Main::Main(Env &env)
 	_update_current_and_check(100,   0, 9,  40, __LINE__);
 
 
+	/************************************************
+	 ** Round #9: Take over work of a busy CPU **
+	 ************************************************/
+
+	_test_stealable();
+
+	time_t const pinned_busy_time = _unbalanced_busy_time(false);
+	time_t const stolen_busy_time = _unbalanced_busy_time(true);
+
+	log("unbalanced load on 2 CPUs, busy time: ", pinned_busy_time,
+	    " pinned, ", stolen_busy_time, " with work stealing");
+
+	_check(stolen_busy_time > pinned_busy_time, __LINE__);
+
+
+	/*****************************************************
+	 ** Round #10: Defer timer interrupts of idle CPUs **
+	 *****************************************************/
+
+	_test_timeout_coalescing();
+
+	unsigned const periodic_interrupts = _idle_timer_interrupts(0);
+	unsigned const deferred_interrupts = _idle_timer_interrupts(cpu_idle_slack_us);
+
+	log("timer interrupts of an idle CPU per second: ", periodic_interrupts,
+	    " without slack, ", deferred_interrupts, " with slack");
+
+	_check(deferred_interrupts*(cpu_fill_us + cpu_idle_slack_us)
+	       == periodic_interrupts*cpu_fill_us, __LINE__);
+
 	_env.parent().exit(0);
 }
 
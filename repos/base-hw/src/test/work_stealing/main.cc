@@ -0,0 +1,111 @@
+/*
+ * \brief  Throughput of CPU-bound threads under unbalanced load
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * All worker threads are created at the first CPU. In the first phase, the
+ * workers stay pinned to this CPU. In the second phase, their affinity spans
+ * all CPUs, which permits idle CPUs to take over workers.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/thread.h>
+#include <cpu_thread/client.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Worker;
+	struct Main;
+}
+
+
+struct Test::Worker : Thread
+{
+	enum { STACK_SIZE = 4*1024 };
+
+	unsigned long volatile count = 0;
+
+	Worker(Env &env, Name const &name)
+	:
+		Thread(env, name, STACK_SIZE, Location(0, 0, 1, 1), Weight(), env.cpu())
+	{
+		start();
+	}
+
+	void entry() override
+	{
+		for (;;)
+			count = count + 1;
+	}
+};
+
+
+struct Test::Main
+{
+	enum { PHASE_MS = 2000, MAX_WORKERS = 16 };
+
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Affinity::Space const _space = _env.cpu().affinity_space();
+
+	unsigned const _num_workers = min(2*_space.width(), unsigned(MAX_WORKERS));
+
+	Constructible<Worker> _workers[MAX_WORKERS];
+
+	unsigned long _total() const
+	{
+		unsigned long result = 0;
+		for (unsigned i = 0; i < _num_workers; i++)
+			result += _workers[i]->count;
+		return result;
+	}
+
+	unsigned long _iterations_per_s()
+	{
+		unsigned long const start = _total();
+		_timer.msleep(PHASE_MS);
+		return (_total() - start)*1000/PHASE_MS;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- work-stealing benchmark started, ", _num_workers,
+		    " workers on ", _space.width(), " CPUs ---");
+
+		for (unsigned i = 0; i < _num_workers; i++)
+			_workers[i].construct(_env, Thread::Name("worker_", i));
+
+		unsigned long const pinned = _iterations_per_s();
+		log("pinned: ", pinned, " iterations/s");
+
+		for (unsigned i = 0; i < _num_workers; i++)
+			Cpu_thread_client(_workers[i]->cap()).affinity(
+				Affinity::Location(0, 0, _space.width(), 1));
+
+		unsigned long const stealing = _iterations_per_s();
+		log("work stealing: ", stealing, " iterations/s");
+
+		if (_space.width() > 1 && stealing <= pinned)
+			error("work stealing did not improve the throughput");
+
+		log("--- work-stealing benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-work_stealing
+SRC_CC = main.cc
+LIBS   = base
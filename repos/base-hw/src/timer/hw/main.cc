@@ -18,6 +18,7 @@
 #include <root/component.h>
 #include <timer_session/timer_session.h>
 #include <trace/timestamp.h>
+#include <util/arg_string.h>
 
 /* base-internal includes */
 #include <base/internal/alarm_registry.h>
@@ -61,9 +62,12 @@ class Timer::Device : Noncopyable
 			virtual void dispatch_device_wakeup() = 0;
 		};
 
-		struct Deadline : Clock { };
+		struct Deadline : Clock
+		{
+			uint64_t slack_us;  /* tolerated delay of the wakeup */
+		};
 
-		static constexpr Deadline infinite_deadline { uint64_t(-1) };
+		static constexpr Deadline infinite_deadline { { uint64_t(-1) }, 0 };
 
 	private:
 
@@ -98,18 +102,26 @@ class Timer::Device : Noncopyable
 			                      ? min(_max_timeout_us, deadline.us - now_us)
 			                      : 0;
 
-			Kernel::timeout(Kernel::timeout_t(rel_us), _sel);
+			Kernel::timeout(Kernel::timeout_t(rel_us), _sel,
+			                Kernel::timeout_t(min(_max_timeout_us, deadline.slack_us)));
 		}
 };
 
 
 struct Timer::Alarm : Alarms::Element
 {
+	/* delay tolerated by any session, allows for merging nearby alarms */
+	static constexpr uint64_t MIN_SLACK_US = 250;
+
+	static constexpr uint64_t MAX_SLACK_US = 10*1000*1000;
+
 	Session_component &session;
 
-	Alarm(Alarms &alarms, Session_component &session, Clock time)
+	uint64_t const slack_us;
+
+	Alarm(Alarms &alarms, Session_component &session, Clock time, uint64_t slack_us)
 	:
-		Alarms::Element(alarms, *this, time), session(session)
+		Alarms::Element(alarms, *this, time), session(session), slack_us(slack_us)
 	{ }
 
 	void print(Output &out) const;
@@ -123,13 +135,26 @@ static Timer::Device::Deadline next_deadline(Timer::Alarms &alarms)
 	return alarms.soonest(Clock { 0 }).convert<Device::Deadline>(
 		[&] (Clock soonest) -> Device::Deadline {
 
-			/* scan alarms for a cluster nearby the soonest */
-			uint64_t const MAX_DELAY_US = 250;
-			Device::Deadline result { soonest.us };
-			alarms.for_each_in_range(soonest, Clock { soonest.us + MAX_DELAY_US },
-			[&] (Alarm const &alarm) {
+			/*
+			 * Merge the alarms nearby the soonest into one wakeup as long as
+			 * no alarm gets delayed beyond its slack. An alarm found within
+			 * the limit may shrink the limit but never below its own time.
+			 */
+			uint64_t limit = uint64_t(-1);
+			alarms.for_each_in_range(soonest, soonest, [&] (Alarm const &alarm) {
+				limit = min(limit, alarm.time.us + alarm.slack_us); });
+
+			alarms.for_each_in_range(soonest, Clock { limit }, [&] (Alarm const &alarm) {
+				if (alarm.time.us <= limit)
+					limit = min(limit, alarm.time.us + alarm.slack_us); });
+
+			Device::Deadline result { { soonest.us }, 0 };
+			alarms.for_each_in_range(soonest, Clock { limit }, [&] (Alarm const &alarm) {
 				result.us = max(result.us, alarm.time.us); });
 
+			/* leave the remaining slack to the kernel for merging the wakeup */
+			result.slack_us = limit - result.us;
+
 			return result;
 		},
 		[&] (Alarms::None) { return Device::infinite_deadline; });
@@ -143,6 +168,8 @@ struct Timer::Session_component : Session_object<Timer::Session, Session_compone
 
 	Signal_context_capability _sigh { };
 
+	uint64_t const _slack_us;
+
 	Clock const _creation_time = _device.now();
 
 	uint64_t _local_now_us() const { return _device.now().us - _creation_time.us; }
@@ -157,10 +184,12 @@ struct Timer::Session_component : Session_object<Timer::Session, Session_compone
 	                  Label     const &label,
 	                  Diag      const &diag,
 	                  Alarms          &alarms,
-	                  Device          &device)
+	                  Device          &device,
+	                  uint64_t         slack_us)
 	:
 		Session_object(env.ep(), resources, label, diag),
-		_alarms(alarms), _device(device)
+		_alarms(alarms), _device(device),
+		_slack_us(min(max(slack_us, Alarm::MIN_SLACK_US), Alarm::MAX_SLACK_US))
 	{ }
 
 	/**
@@ -176,7 +205,7 @@ struct Timer::Session_component : Session_object<Timer::Session, Session_compone
 			                 ? Clock { _alarm->time.us  + _period->us }
 			                 : Clock { _device.now().us + _period->us };
 
-			_alarm.construct(_alarms, *this, next);
+			_alarm.construct(_alarms, *this, next, _slack_us);
 
 		} else /* response of 'trigger_once' */ {
 			_alarm.destruct();
@@ -195,7 +224,7 @@ struct Timer::Session_component : Session_object<Timer::Session, Session_compone
 		Clock const now = _device.now();
 
 		rel_us = max(rel_us, 250u);
-		_alarm.construct(_alarms, *this, Clock { now.us + rel_us });
+		_alarm.construct(_alarms, *this, Clock { now.us + rel_us }, _slack_us);
 
 		_device.update_deadline(next_deadline(_alarms));
 	}
@@ -241,7 +270,8 @@ struct Timer::Root : public Root_component<Session_component>
 				                  session_resources_from_args(args),
 				                  session_label_from_args(args),
 				                  session_diag_from_args(args),
-				                  _alarms, _device);
+				                  _alarms, _device,
+				                  Arg_string::find_arg(args, "slack_us").ulong_value(0));
 		}
 
 		void _upgrade_session(Session_component *s, const char *args) override
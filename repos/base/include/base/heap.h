@@ -89,6 +89,32 @@ class Genode::Heap : public Allocator
 					ram_alloc = ram, region_map = rm; }
 		};
 
+		/*
+		 * Segregated size class for small allocations
+		 *
+		 * A size class manages chunks of 'SIZE_CLASS_CHUNK_SIZE' bytes
+		 * allocated from the AVL allocator. Each chunk is divided into
+		 * equally-sized slots. Allocating and freeing a slot merely
+		 * manipulates the free list of the chunk, which avoids the
+		 * best-fit search and the per-block meta data of the AVL allocator.
+		 * The chunk of a slot is found via the alignment of the chunk.
+		 */
+		struct Size_class
+		{
+			struct Chunk;
+
+			size_t slot_size   = 0;
+			Chunk *chunks      = nullptr;  /* chunks with free slots */
+			size_t num_chunks  = 0;
+			size_t num_empty   = 0;        /* number of completely free chunks */
+			size_t used_slots  = 0;
+			size_t total_slots = 0;
+		};
+
+		static constexpr unsigned NUM_SIZE_CLASSES           = 10;
+		static constexpr unsigned SIZE_CLASS_CHUNK_SIZE_LOG2 = 12;
+		static constexpr size_t   SIZE_CLASS_CHUNK_SIZE      = size_t(1) << SIZE_CLASS_CHUNK_SIZE_LOG2;
+
 		Mutex                  mutable _mutex { };
 		Reconstructible<Allocator_avl> _alloc;        /* local allocator    */
 		Dataspace_pool                 _ds_pool;      /* list of dataspaces */
@@ -96,6 +122,10 @@ class Genode::Heap : public Allocator
 		size_t                         _quota_used  { 0 };
 		size_t                         _chunk_size  { 0 };
 
+		bool       _size_classes_enabled = false;
+		size_t     _num_size_class_chunks = 0;
+		Size_class _size_classes[NUM_SIZE_CLASSES] { };
+
 		using Alloc_ds_result = Attempt<Dataspace *, Alloc_error>;
 
 		/**
@@ -110,13 +140,34 @@ class Genode::Heap : public Allocator
 		/**
 		 * Try to allocate block at our local allocator
 		 */
-		Alloc_result _try_local_alloc(size_t size);
+		Alloc_result _try_local_alloc(size_t size, unsigned align_log2 = 4);
+
+		/**
+		 * Extend local allocator by a dataspace that can hold 'size' bytes
+		 */
+		Alloc_ds_result _grow(size_t size);
 
 		/**
 		 * Unsynchronized implementation of 'try_alloc'
 		 */
 		Alloc_result _unsynchronized_alloc(size_t size);
 
+		/**
+		 * Return size class suitable for 'size', or nullptr
+		 */
+		Size_class *_size_class(size_t size);
+
+		Alloc_result _size_class_alloc(Size_class &);
+
+		/**
+		 * Free slot of size class
+		 *
+		 * \return false if 'addr' does not refer to a size-class slot
+		 */
+		bool _try_size_class_free(void *addr);
+
+		void _release_chunk(Size_class::Chunk &);
+
 	public:
 
 		static constexpr size_t UNLIMITED = ~0;
@@ -139,6 +190,43 @@ class Genode::Heap : public Allocator
 		 */
 		int quota_limit(size_t new_quota_limit);
 
+		/**
+		 * Enable or disable size classes for small allocations
+		 *
+		 * When enabled, allocations of up to 'MAX_SIZE_CLASS' bytes are
+		 * served from segregated size classes instead of the AVL allocator.
+		 * Blocks allocated from size classes are correctly freed even after
+		 * disabling the size classes.
+		 */
+		void size_classes(bool enabled)
+		{
+			Mutex::Guard guard(_mutex);
+			_size_classes_enabled = enabled;
+		}
+
+		static constexpr size_t MAX_SIZE_CLASS = 512;
+
+		struct Size_class_info
+		{
+			size_t slot_size;    /* size of each slot in bytes       */
+			size_t chunks;       /* number of chunks                 */
+			size_t used_slots;   /* number of allocated slots        */
+			size_t total_slots;  /* number of slots of all chunks    */
+		};
+
+		/**
+		 * Call 'fn' with the 'Size_class_info' of each size class
+		 */
+		void for_each_size_class(auto const &fn) const
+		{
+			Mutex::Guard guard(_mutex);
+			for (Size_class const &sc : _size_classes)
+				fn(Size_class_info { .slot_size   = sc.slot_size,
+				                     .chunks      = sc.num_chunks,
+				                     .used_slots  = sc.used_slots,
+				                     .total_slots = sc.total_slots });
+		}
+
 		/**
 		 * Re-assign RAM allocator and region map
 		 */
@@ -38,13 +38,17 @@ class Genode::Object_pool : Interface, Noncopyable
 {
 	public:
 
-		class Entry : Avl_node<Entry>
+		class Entry
 		{
 			private:
 
 				friend class Object_pool;
-				friend class Avl_tree<Entry>;
-				friend class Avl_node<Entry>;
+
+				/*
+				 * Noncopyable
+				 */
+				Entry(Entry const &);
+				Entry &operator = (Entry const &);
 
 				struct Entry_lock : Weak_object<Entry_lock>, Noncopyable
 				{
@@ -58,6 +62,13 @@ class Genode::Object_pool : Interface, Noncopyable
 				Untyped_capability _cap  { };
 				Entry_lock         _lock { *this };
 
+				/*
+				 * Membership in a bucket of the pool, keyed by the
+				 * capability ID at insertion time
+				 */
+				Entry        *_next = nullptr;
+				unsigned long _id   = 0;
+
 				inline unsigned long _obj_id() { return _cap.local_name(); }
 
 			public:
@@ -67,24 +78,6 @@ class Genode::Object_pool : Interface, Noncopyable
 
 				virtual ~Entry() { }
 
-				/**
-				 * Avl_node interface
-				 */
-				bool higher(Entry *e) { return e->_obj_id() > _obj_id(); }
-				void recompute() { }  /* for gcc-3.4 compatibility */
-
-				/**
-				 * Support for object pool
-				 */
-				Entry *find_by_obj_id(unsigned long obj_id)
-				{
-					if (obj_id == _obj_id()) return this;
-
-					Entry *obj = this->child(obj_id > _obj_id());
-
-					return obj ? obj->find_by_obj_id(obj_id) : 0;
-				}
-
 				/**
 				 * Assign capability to object pool entry
 				 */
@@ -95,15 +88,93 @@ class Genode::Object_pool : Interface, Noncopyable
 
 	private:
 
-		Avl_tree<Entry> _tree { };
-		Mutex           _mutex { };
+		Mutex _mutex { };
+
+		/*
+		 * Hash table indexed by the capability ID
+		 *
+		 * Each bucket is a singly-linked list of entries, which keeps the
+		 * pool free of dynamic allocations. Capability IDs are allocated
+		 * densely by most kernels, which spreads the entries evenly over
+		 * the buckets. A looked-up entry is moved to the front of its
+		 * bucket so that the objects called most frequently are found
+		 * first.
+		 */
+		static constexpr unsigned BUCKETS_LOG2 = 8,
+		                          BUCKETS      = 1u << BUCKETS_LOG2;
+
+		Entry *_buckets[BUCKETS] { };
+
+		static unsigned _bucket(unsigned long capid)
+		{
+			/* multiplicative hashing, taking the upper bits of the product */
+			unsigned long const golden = (unsigned long)0x9e3779b97f4a7c15ULL;
+
+			return (unsigned)((capid*golden) >> (8*sizeof(capid) - BUCKETS_LOG2));
+		}
+
+		/**
+		 * Unlink entry from its bucket, the mutex must be held by the caller
+		 *
+		 * \return false if the entry is not a member of the pool
+		 */
+		bool _unlink(Entry &entry)
+		{
+			for (Entry **link = &_buckets[_bucket(entry._id)]; *link;
+			     link = &(*link)->_next) {
+
+				if (*link != &entry)
+					continue;
+
+				*link = entry._next;
+				entry._next = nullptr;
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Look up entry, the mutex must be held by the caller
+		 */
+		Entry *_lookup(unsigned long capid)
+		{
+			Entry *&first = _buckets[_bucket(capid)];
+
+			for (Entry **link = &first; *link; link = &(*link)->_next) {
+
+				Entry &entry = **link;
+				if (entry._id != capid)
+					continue;
+
+				/* move entry to the front of the bucket */
+				if (&entry != first) {
+					*link       = entry._next;
+					entry._next = first;
+					first       = &entry;
+				}
+				return &entry;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Return any entry of the pool, the mutex must be held by the caller
+		 */
+		Entry *_any()
+		{
+			for (Entry *first : _buckets)
+				if (first)
+					return first;
+
+			return nullptr;
+		}
 
 	protected:
 
 		bool empty()
 		{
 			Mutex::Guard lock_guard(_mutex);
-			return _tree.first() == nullptr;
+			return _any() == nullptr;
 		}
 
 	public:
@@ -111,13 +182,19 @@ class Genode::Object_pool : Interface, Noncopyable
 		void insert(OBJ_TYPE *obj)
 		{
 			Mutex::Guard lock_guard(_mutex);
-			_tree.insert(obj);
+
+			Entry &entry = *obj;
+			entry._id   = entry._obj_id();
+
+			Entry *&first = _buckets[_bucket(entry._id)];
+			entry._next = first;
+			first       = &entry;
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
 			Mutex::Guard lock_guard(_mutex);
-			_tree.remove(obj);
+			_unlink(*obj);
 		}
 
 		template <typename FN>
@@ -134,8 +211,7 @@ class Genode::Object_pool : Interface, Noncopyable
 			{
 				Mutex::Guard lock_guard(_mutex);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = _lookup(capid);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -166,14 +242,14 @@ class Genode::Object_pool : Interface, Noncopyable
 				{
 					Mutex::Guard lock_guard(_mutex);
 
-					if (!((obj = (OBJ_TYPE*) _tree.first()))) return;
+					if (!((obj = (OBJ_TYPE*) _any()))) return;
 
 					Weak_ptr ptr = obj->_lock.weak_ptr();
 					{
 						Locked_ptr lock_ptr(ptr);
 						if (!lock_ptr.valid()) return;
 
-						_tree.remove(obj);
+						_unlink(*obj);
 					}
 				}
 
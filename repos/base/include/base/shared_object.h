@@ -149,6 +149,13 @@ class Genode::Dynamic_linker
 
 		static void _for_each_loaded_object(Env &, For_each_fn const &);
 
+		struct Relocation_cache_fn : Interface
+		{
+			virtual bool supply_relocation_cache(Const_byte_range_ptr const &) const = 0;
+		};
+
+		static void _with_relocation_cache(Env &, Relocation_cache_fn const &);
+
 		static void *_respawn(Env &, char const *, char const *);
 
 	public:
@@ -172,6 +179,36 @@ class Genode::Dynamic_linker
 			_for_each_loaded_object(env, wrapped_fn);
 		}
 
+		/**
+		 * Call 'fn' with the content of the relocation cache
+		 *
+		 * The relocation cache is enabled by the 'ld_reloc_cache' attribute
+		 * of the component's configuration. The functor is called with a
+		 * 'Const_byte_range_ptr' argument only if the cache content differs
+		 * from the "ld_reloc_cache" ROM module obtained at startup. The
+		 * content is meant to be stored such that it is provided as this
+		 * ROM module on the next start of the component.
+		 *
+		 * The functor returns true if the content was stored. Otherwise,
+		 * the content is supplied again by the next call.
+		 */
+		template <typename FN>
+		static inline void with_relocation_cache(Env &env, FN const &fn)
+		{
+			struct Relocation_cache_fn_impl : Relocation_cache_fn
+			{
+				FN const &fn;
+
+				bool supply_relocation_cache(Const_byte_range_ptr const &content) const {
+					return fn(content); }
+
+				Relocation_cache_fn_impl(FN const &fn) : fn(fn) { }
+
+			} wrapped_fn { fn };
+
+			_with_relocation_cache(env, wrapped_fn);
+		}
+
 		/**
 		 * Prevent loaded shared object 'name' to be unloaded
 		 */
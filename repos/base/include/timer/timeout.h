@@ -85,8 +85,7 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : private Noncopyable
 {
 	friend class Timeout_scheduler;
 
@@ -102,6 +101,11 @@ class Genode::Timeout : private Noncopyable,
 		bool                   _in_discard_blockade { false };
 		Blockade               _discard_blockade    { };
 
+		/* membership in a slot of the scheduler's timer wheel */
+		Timeout               *_wheel_prev          { nullptr };
+		Timeout               *_wheel_next          { nullptr };
+		unsigned               _wheel_slot          { 0 };
+
 		Timeout(Timeout const &);
 
 		Timeout &operator = (Timeout const &);
@@ -130,6 +134,15 @@ class Genode::Timeout : private Noncopyable,
 
 /**
  * Multiplexes one time source amongst different timeouts
+ *
+ * Scheduled timeouts are kept in a hierarchical timer wheel, which allows
+ * for scheduling and discarding a timeout in constant time. Each level of
+ * the wheel consists of 'WHEEL_SLOTS' slots. A slot of level 0 covers
+ * 2^'WHEEL_SLOT_SHIFT' microseconds whereas a slot of each further level
+ * covers the whole range of the level below. A timeout is kept at the
+ * lowest level that covers its deadline relative to the current time. Once
+ * the start of its slot is reached, the timeout is either triggered or
+ * moved to a lower level.
  */
 class Genode::Timeout_scheduler : private Noncopyable,
                                   public  Timeout_handler
@@ -142,16 +155,47 @@ class Genode::Timeout_scheduler : private Noncopyable,
 
 		static constexpr uint64_t max_sleep_time_us { 60'000'000 };
 
+		static constexpr unsigned WHEEL_SLOT_SHIFT  = 10;
+		static constexpr unsigned WHEEL_LEVEL_SHIFT = 6;
+		static constexpr unsigned WHEEL_SLOTS       = 1u << WHEEL_LEVEL_SHIFT;
+		static constexpr unsigned WHEEL_LEVELS      = 5;
+
+		static_assert(WHEEL_SLOTS == 64, "slot bitmap must match uint64_t");
+
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
+		/* deadline of the timeout installed at the time source */
+		uint64_t            _time_source_deadline_us { ~(uint64_t)0 };
+
+		Timeout            *_wheel[WHEEL_LEVELS*WHEEL_SLOTS] { };
+		uint64_t            _wheel_occupied[WHEEL_LEVELS]    { };
+
+		static unsigned _wheel_shift(unsigned level) {
+			return WHEEL_SLOT_SHIFT + level*WHEEL_LEVEL_SHIFT; }
+
+		void _insert_into_wheel(Timeout &timeout);
+
+		void _remove_from_wheel(Timeout &timeout);
+
+		/**
+		 * Detach all timeouts of the slots reached until 'now_us'
+		 *
+		 * \return  first timeout of a list linked via '_wheel_next'
+		 */
+		Timeout *_detach_due_timeouts(uint64_t now_us);
+
+		/**
+		 * Return lower bound of the nearest deadline, ~0 if there is none
+		 */
+		uint64_t _next_deadline_us() const;
+
+		Timeout *_any_timeout();
 
 		void _set_time_source_timeout();
 
@@ -266,6 +266,25 @@ class Timer::Connection : public  Genode::Connection<Session>,
 		Connection(Genode::Env &env, Label const &label = Label())
 		: Connection(env, env.ep(), label) { }
 
+		/**
+		 * Constructor
+		 *
+		 * \param slack  tolerated delay of the session's timeouts
+		 *
+		 * The timer service may defer each timeout of the session by up to
+		 * 'slack' to trigger it together with nearby timeouts, which saves
+		 * wakeups. Components with relaxed timing demands, e.g., periodic
+		 * reporters or status displays, should declare a generous slack.
+		 */
+		Connection(Genode::Env &env,
+		           Genode::Entrypoint &ep,
+		           Genode::Microseconds slack,
+		           Label const &label = Label());
+
+		Connection(Genode::Env &env, Genode::Microseconds slack,
+		           Label const &label = Label())
+		: Connection(env, env.ep(), slack, label) { }
+
 		~Connection() { _sig_rec.dissolve(_default_sigh_ctx); }
 
 		/*
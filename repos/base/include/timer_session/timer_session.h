@@ -38,6 +38,11 @@ struct Timer::Session : Genode::Session
 
 	enum { CAP_QUOTA = 2 };
 
+	/*
+	 * The optional session argument 'slack_us' declares the delay the
+	 * client tolerates for its timeouts, see 'Timer::Connection'.
+	 */
+
 	virtual ~Session() { }
 
 	/**
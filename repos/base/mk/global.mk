@@ -230,10 +230,11 @@ CXX_LINK_OPT       += $(addprefix $(LD_OPT_PREFIX),$(LD_OPT))
 CXX_LINK_OPT       += $(LD_OPT_NOSTDLIB)
 
 #
-# Genode linker does not support .gnu.hash so there is no point in having it
-# in the ELF files. Tell the linker to only produce SysV hash tables.
+# The Genode linker prefers the .gnu.hash table for symbol lookup. The SysV
+# hash table is still generated to keep the ELF files usable with older
+# versions of the dynamic linker.
 #
-LD_OPT += --hash-style=sysv
+LD_OPT += --hash-style=both
 
 #
 # Linker script for dynamically linked programs
@@ -113,6 +113,29 @@ Affinity::Location Cpu_session_component::_thread_affinity(Affinity::Location lo
 }
 
 
+Affinity::Location
+Cpu_session_component::clipped_thread_affinity(Affinity::Location location) const
+{
+	/* convert session-local corners to physical ones, x2/y2 being exclusive */
+	int const x1 = _location.xpos() + location.xpos(),
+	          y1 = _location.ypos() + location.ypos(),
+	          x2 = x1 + (int)location.width(),
+	          y2 = y1 + (int)location.height();
+
+	int const clipped_x1 = max(_location.xpos(), x1),
+	          clipped_y1 = max(_location.ypos(), y1),
+	          clipped_x2 = min(_location.xpos() + (int)_location.width(),  x2),
+	          clipped_y2 = min(_location.ypos() + (int)_location.height(), y2);
+
+	if (clipped_x2 <= clipped_x1 || clipped_y2 <= clipped_y1)
+		return Affinity::Location(clipped_x1, clipped_y1, 0, 0);
+
+	return Affinity::Location(clipped_x1, clipped_y1,
+	                          unsigned(clipped_x2 - clipped_x1),
+	                          unsigned(clipped_y2 - clipped_y1));
+}
+
+
 void Cpu_session_component::_unsynchronized_kill_thread(Thread_capability thread_cap)
 {
 	Cpu_thread_component *thread = nullptr;
@@ -87,7 +87,15 @@ void Cpu_thread_component::exception_sigh(Signal_context_capability sigh)
 
 void Cpu_thread_component::affinity(Affinity::Location location)
 {
-	_platform_thread.affinity(location);
+	/* the location is relative to the affinity of the CPU session */
+	Affinity::Location const physical = _cpu.clipped_thread_affinity(location);
+
+	if (!physical.width() || !physical.height()) {
+		warning("thread affinity outside of CPU session");
+		return;
+	}
+
+	_platform_thread.affinity(physical);
 }
 
 
@@ -162,6 +162,15 @@ class Core::Cpu_session_component : public  Session_object<Cpu_session>,
 		 */
 		~Cpu_session_component();
 
+		/**
+		 * Convert session-local location of an existing thread to physical
+		 * location, clipped to the CPUs of the session
+		 *
+		 * \return location of zero size if 'location' lies outside of
+		 *         the session's affinity
+		 */
+		Affinity::Location clipped_thread_affinity(Affinity::Location) const;
+
 
 		/***************************
 		 ** CPU session interface **
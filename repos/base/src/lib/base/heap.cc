@@ -165,9 +165,9 @@ Heap::_allocate_dataspace(size_t size, bool enforce_separate_metadata)
 }
 
 
-Allocator::Alloc_result Heap::_try_local_alloc(size_t size)
+Allocator::Alloc_result Heap::_try_local_alloc(size_t size, unsigned align_log2)
 {
-	return _alloc->alloc_aligned(size, log2(16U)).convert<Alloc_result>(
+	return _alloc->alloc_aligned(size, align_log2).convert<Alloc_result>(
 
 		[&] (void *ptr) {
 			_quota_used += size;
@@ -209,6 +209,20 @@ Allocator::Alloc_result Heap::_unsynchronized_alloc(size_t size)
 			return result;
 	}
 
+	Alloc_ds_result const result = _grow(size);
+
+	if (result.failed())
+		return result.convert<Alloc_result>(
+			[&] (Dataspace *)       { return Alloc_error::DENIED; },
+			[&] (Alloc_error error) { return error; });
+
+	/* allocate originally requested block */
+	return _try_local_alloc(size);
+}
+
+
+Heap::Alloc_ds_result Heap::_grow(size_t size)
+{
 	size_t dataspace_size = size
 	                      + Allocator_avl::slab_block_size()
 	                      + sizeof(Heap::Dataspace);
@@ -221,11 +235,9 @@ Allocator::Alloc_result Heap::_unsynchronized_alloc(size_t size)
 	 */
 	size_t const request_size = _chunk_size * sizeof(umword_t);
 
-	Alloc_ds_result result = Alloc_error::DENIED;
-
 	if (dataspace_size < request_size) {
 
-		result = _allocate_dataspace(request_size, false);
+		Alloc_ds_result result = _allocate_dataspace(request_size, false);
 		if (result.ok()) {
 
 			/*
@@ -234,17 +246,265 @@ Allocator::Alloc_result Heap::_unsynchronized_alloc(size_t size)
 			 */
 			_chunk_size = min(2*_chunk_size, (size_t)MAX_CHUNK_SIZE);
 		}
-	} else {
-		result = _allocate_dataspace(dataspace_size, false);
+		return result;
 	}
 
-	if (result.failed())
-		return result.convert<Alloc_result>(
-			[&] (Dataspace *)       { return Alloc_error::DENIED; },
-			[&] (Alloc_error error) { return error; });
+	return _allocate_dataspace(dataspace_size, false);
+}
 
-	/* allocate originally requested block */
-	return _try_local_alloc(size);
+
+/******************
+ ** Size classes **
+ ******************/
+
+/**
+ * Chunk of equally-sized slots, placed at the start of the chunk
+ *
+ * Only chunks with free slots are linked into the list of the size class.
+ */
+struct Heap::Size_class::Chunk
+{
+	/*
+	 * Noncopyable
+	 */
+	Chunk(Chunk const &);
+	Chunk &operator = (Chunk const &);
+
+	struct Slot { Slot *next; };
+
+	Size_class &size_class;
+
+	addr_t cookie = _cookie(this);
+
+	Chunk *prev = nullptr, *next = nullptr;
+
+	Slot  *free_slots = nullptr;
+	size_t used       = 0;
+	size_t num_slots  = 0;
+
+	static addr_t _cookie(Chunk const *chunk) {
+		return addr_t(chunk) ^ addr_t(0x5a1ab5a1ab5a1ab5ULL); }
+
+	static constexpr size_t HEADER_SIZE = 64;
+
+	Chunk(Size_class &size_class) : size_class(size_class)
+	{
+		static_assert(sizeof(Chunk) <= HEADER_SIZE);
+
+		addr_t const slots_start = addr_t(this) + HEADER_SIZE;
+
+		num_slots = (SIZE_CLASS_CHUNK_SIZE - HEADER_SIZE) / size_class.slot_size;
+
+		/* populate free list in ascending address order */
+		for (size_t i = num_slots; i > 0; i--) {
+			Slot &slot = *(Slot *)(slots_start + (i - 1)*size_class.slot_size);
+			slot.next  = free_slots;
+			free_slots = &slot;
+		}
+	}
+
+	/*
+	 * Invalidate the cookie so that the memory of a released chunk is not
+	 * mistaken for a chunk when reused for other blocks. The volatile
+	 * access keeps the compiler from eliding the store at the end of the
+	 * object's lifetime.
+	 */
+	~Chunk() { *(addr_t volatile *)&cookie = 0; }
+
+	bool valid() const { return cookie == _cookie(this); }
+
+	bool full()  const { return free_slots == nullptr; }
+	bool empty() const { return used == 0; }
+
+	void *alloc()
+	{
+		Slot &slot = *free_slots;
+		free_slots = slot.next;
+		used++;
+		return &slot;
+	}
+
+	void free(void *addr)
+	{
+		Slot &slot = *(Slot *)addr;
+		slot.next  = free_slots;
+		free_slots = &slot;
+		used--;
+	}
+
+	bool slot_addr(addr_t const addr) const
+	{
+		addr_t const slots_start = addr_t(this) + HEADER_SIZE;
+
+		return addr >= slots_start
+		    && addr <  slots_start + num_slots*size_class.slot_size
+		    && ((addr - slots_start) % size_class.slot_size) == 0;
+	}
+
+	void remove_from_list()
+	{
+		if (prev) prev->next = next;
+		else      size_class.chunks = next;
+
+		if (next) next->prev = prev;
+
+		prev = next = nullptr;
+	}
+
+	void insert_at_front()
+	{
+		next = size_class.chunks;
+		prev = nullptr;
+
+		if (next) next->prev = this;
+
+		size_class.chunks = this;
+	}
+
+};
+
+
+Heap::Size_class *Heap::_size_class(size_t size)
+{
+	if (size > MAX_SIZE_CLASS)
+		return nullptr;
+
+	for (Size_class &sc : _size_classes)
+		if (size <= sc.slot_size)
+			return &sc;
+
+	return nullptr;
+}
+
+
+Allocator::Alloc_result Heap::_size_class_alloc(Size_class &sc)
+{
+	using Chunk = Size_class::Chunk;
+
+	/* only chunks with free slots are listed */
+	Chunk *chunk_ptr = sc.chunks;
+
+	if (!chunk_ptr) {
+
+		Alloc_result chunk_alloc =
+			_try_local_alloc(SIZE_CLASS_CHUNK_SIZE, SIZE_CLASS_CHUNK_SIZE_LOG2);
+
+		/*
+		 * Request twice the chunk size when growing the local allocator
+		 * to accommodate the alignment of the chunk.
+		 */
+		if (chunk_alloc.failed()) {
+			Alloc_ds_result const result = _grow(2*SIZE_CLASS_CHUNK_SIZE);
+			if (result.failed())
+				return result.convert<Alloc_result>(
+					[&] (Dataspace *)       { return Alloc_error::DENIED; },
+					[&] (Alloc_error error) { return error; });
+
+			chunk_alloc = _try_local_alloc(SIZE_CLASS_CHUNK_SIZE,
+			                               SIZE_CLASS_CHUNK_SIZE_LOG2);
+		}
+
+		if (chunk_alloc.failed())
+			return chunk_alloc;
+
+		chunk_alloc.with_result(
+			[&] (void *ptr) { chunk_ptr = construct_at<Chunk>(ptr, sc); },
+			[&] (Alloc_error) { });
+
+		chunk_ptr->insert_at_front();
+
+		sc.num_chunks++;
+		sc.num_empty++;
+		sc.total_slots += chunk_ptr->num_slots;
+		_num_size_class_chunks++;
+	}
+
+	Chunk &chunk = *chunk_ptr;
+
+	if (chunk.empty())
+		sc.num_empty--;
+
+	void * const ptr = chunk.alloc();
+	sc.used_slots++;
+
+	if (chunk.full())
+		chunk.remove_from_list();
+
+	return ptr;
+}
+
+
+void Heap::_release_chunk(Size_class::Chunk &chunk)
+{
+	Size_class &sc = chunk.size_class;
+
+	chunk.remove_from_list();
+
+	sc.num_chunks--;
+	sc.num_empty--;
+	sc.total_slots -= chunk.num_slots;
+	_num_size_class_chunks--;
+
+	chunk.~Chunk();
+
+	_alloc->free(&chunk, SIZE_CLASS_CHUNK_SIZE);
+	_quota_used -= SIZE_CLASS_CHUNK_SIZE;
+}
+
+
+bool Heap::_try_size_class_free(void *addr)
+{
+	using Chunk = Size_class::Chunk;
+
+	if (!_num_size_class_chunks)
+		return false;
+
+	/*
+	 * Slots never reside at the start of a chunk, which also rules out big
+	 * allocations. Any other block of the heap shares its first page with
+	 * the chunk-aligned address, which is thereby mapped. It refers to a
+	 * chunk only if it bears the cookie of a chunk of one of our size
+	 * classes, which spares the lookup of the block at the AVL allocator.
+	 */
+	addr_t const chunk_addr = addr_t(addr) & ~(SIZE_CLASS_CHUNK_SIZE - 1);
+	if (chunk_addr == addr_t(addr))
+		return false;
+
+	Chunk &chunk = *(Chunk *)chunk_addr;
+
+	if (!chunk.valid())
+		return false;
+
+	Size_class &sc = chunk.size_class;
+
+	addr_t const sc_addr = addr_t(&sc);
+	if (sc_addr <  addr_t(_size_classes)
+	 || sc_addr >= addr_t(_size_classes + NUM_SIZE_CLASSES))
+		return false;
+
+	if (!chunk.slot_addr(addr_t(addr))) {
+		error("heap could not free memory block: given address ", addr,
+		      " is not a slot start address");
+		return true;
+	}
+
+	bool const was_full = chunk.full();
+
+	chunk.free(addr);
+	sc.used_slots--;
+
+	/* list chunk again as it has a free slot now */
+	if (was_full)
+		chunk.insert_at_front();
+
+	/* keep one empty chunk per size class to mitigate thrashing */
+	if (chunk.empty()) {
+		sc.num_empty++;
+		if (sc.num_empty > 1)
+			_release_chunk(chunk);
+	}
+
+	return true;
 }
 
 
@@ -260,6 +520,10 @@ Allocator::Alloc_result Heap::try_alloc(size_t size)
 	if (size + _quota_used > _quota_limit)
 		return Alloc_error::DENIED;
 
+	if (_size_classes_enabled)
+		if (Size_class * const sc = _size_class(size))
+			return _size_class_alloc(*sc);
+
 	return _unsynchronized_alloc(size);
 }
 
@@ -271,6 +535,9 @@ void Heap::free(void *addr, size_t)
 
 	using Size_at_error = Allocator_avl::Size_at_error;
 
+	if (_try_size_class_free(addr))
+		return;
+
 	Allocator_avl::Size_at_result size_at_result = _alloc->size_at(addr);
 
 	if (size_at_result.ok()) {
@@ -327,6 +594,13 @@ Heap::Heap(Ram_allocator *ram_alloc,
 	_quota_limit(quota_limit), _quota_used(0),
 	_chunk_size(MIN_CHUNK_SIZE)
 {
+	/* slot sizes are multiples of 16 to preserve the alignment of blocks */
+	static size_t const slot_sizes[NUM_SIZE_CLASSES] {
+		16, 32, 48, 64, 96, 128, 192, 256, 384, MAX_SIZE_CLASS };
+
+	for (unsigned i = 0; i < NUM_SIZE_CLASSES; i++)
+		_size_classes[i].slot_size = slot_sizes[i];
+
 	if (static_addr)
 		_alloc->add_range((addr_t)static_addr, static_size);
 }
@@ -334,6 +608,19 @@ Heap::Heap(Ram_allocator *ram_alloc,
 
 Heap::~Heap()
 {
+	/*
+	 * Release empty size-class chunks. Chunks with slots still in use are
+	 * reported as dangling allocations by the 'Allocator_avl'.
+	 */
+	for (Size_class &sc : _size_classes) {
+		for (Size_class::Chunk *chunk = sc.chunks; chunk; ) {
+			Size_class::Chunk *next = chunk->next;
+			if (chunk->empty())
+				_release_chunk(*chunk);
+			chunk = next;
+		}
+	}
+
 	/*
 	 * Revert allocations of heap-internal 'Dataspace' objects. Otherwise, the
 	 * subsequent destruction of the 'Allocator_avl' would detect those blocks
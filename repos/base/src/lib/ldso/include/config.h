@@ -31,6 +31,8 @@ class Linker::Config : Noncopyable
 
 		bool const _verbose     = _config.xml().attribute_value("ld_verbose",     false);
 		bool const _check_ctors = _config.xml().attribute_value("ld_check_ctors", true);
+		bool const _reloc_cache = _config.xml().attribute_value("ld_reloc_cache", false);
+		bool const _cow_rw      = _config.xml().attribute_value("ld_cow",         false);
 
 	public:
 
@@ -39,6 +41,8 @@ class Linker::Config : Noncopyable
 		Bind bind()        const { return _bind; }
 		bool verbose()     const { return _verbose; }
 		bool check_ctors() const { return _check_ctors; }
+		bool reloc_cache() const { return _reloc_cache; }
+		bool cow_rw()      const { return _cow_rw; }
 
 		using Rom_name = String<100>;
 
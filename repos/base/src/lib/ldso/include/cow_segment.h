@@ -0,0 +1,290 @@
+/*
+ * \brief  Read-write ELF segment populated on demand
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__COW_SEGMENT_H_
+#define _INCLUDE__COW_SEGMENT_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/signal.h>
+#include <base/mutex.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+#include <util/list.h>
+
+/* local includes */
+#include <linker.h>
+
+namespace Linker {
+
+	class Cow_pager;
+	class Cow_segment;
+
+	/*
+	 * Segments populated on demand rely on managed dataspaces, which are not
+	 * available on base-linux
+	 */
+#ifdef LD_NO_MANAGED_DATASPACES
+	static constexpr bool cow_segments_supported = false;
+#else
+	static constexpr bool cow_segments_supported = true;
+#endif
+}
+
+
+/**
+ * Read-write segment backed by a managed dataspace
+ *
+ * Instead of copying the whole segment from the ROM module at load time,
+ * RAM is allocated and initialized in chunks of 'CHUNK_SIZE' whenever the
+ * program touches a chunk for the first time. Chunks never touched do not
+ * consume any RAM.
+ *
+ * Each populated chunk is a separate RAM dataspace and thereby costs one
+ * capability of the component's cap quota in addition to the RAM. A fully
+ * populated segment of 1 MiB thus occupies 64 capabilities whereas a copied
+ * segment occupies one.
+ */
+class Linker::Cow_segment : List<Cow_segment>::Element
+{
+	public:
+
+		static constexpr size_t CHUNK_SIZE = 16*1024;
+
+	private:
+
+		friend class Cow_pager;
+		friend class List<Cow_segment>;
+
+		/*
+		 * Noncopyable
+		 */
+		Cow_segment(Cow_segment const &);
+		Cow_segment &operator = (Cow_segment const &);
+
+		Env       &_env;
+		Allocator &_alloc;
+		Cow_pager &_pager;
+
+		char   const * const _src;       /* locally mapped segment content */
+		size_t         const _file_size; /* size of content in ROM module */
+		size_t         const _size;      /* page-aligned size of segment */
+
+		Capability<Genode::Region_map> const _rm_cap;
+		Region_map_client                    _rm { _rm_cap };
+
+		unsigned const _num_chunks = unsigned((_size + CHUNK_SIZE - 1)/CHUNK_SIZE);
+
+		Ram_dataspace_capability * const _chunks = (Ram_dataspace_capability *)
+			_alloc.alloc(_num_chunks*sizeof(Ram_dataspace_capability));
+
+		unsigned _populated = 0;
+
+		Signal_context            _fault_context { };
+		Signal_context_capability _fault_sigh    { };
+
+		inline void _handle_fault();
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param src        locally mapped content of the segment, which is
+		 *                   detached on destruction
+		 * \param file_size  size of the content, the remainder is zeroed
+		 * \param size       size of the segment in memory
+		 */
+		inline Cow_segment(Env &, Allocator &, char const *src,
+		                   size_t file_size, size_t size);
+
+		inline ~Cow_segment();
+
+		Dataspace_capability dataspace() { return _rm.dataspace(); }
+
+		size_t populated_bytes() const { return min(_size, _populated*CHUNK_SIZE); }
+		size_t size()            const { return _size; }
+};
+
+
+/**
+ * Handler of faults within all copy-on-write segments
+ *
+ * The pager thread must not depend on the memory of any copy-on-write
+ * segment or on any lock possibly held by a faulting thread. Therefore,
+ * it uses the RAM and region-map sessions of the environment only and
+ * never allocates from the heap of the linker.
+ */
+class Linker::Cow_pager : Thread
+{
+	private:
+
+		Env &_env;
+
+		Rm_connection   _rm_connection { _env };
+		Signal_receiver _receiver      { };
+
+		/* protects '_segments' against concurrent loading and unloading */
+		Mutex             _mutex    { };
+		List<Cow_segment> _segments { };
+
+		void entry() override
+		{
+			for (;;) {
+				Signal signal = _receiver.wait_for_signal();
+
+				Mutex::Guard guard(_mutex);
+
+				/* ignore signals of segments unloaded in the meantime */
+				for (Cow_segment *s = _segments.first(); s; s = s->next())
+					if (signal.context() == &s->_fault_context)
+						s->_handle_fault();
+			}
+		}
+
+		Cow_pager(Env &env)
+		:
+			Thread(env, "ld_cow_pager", 16*1024), _env(env)
+		{
+			start();
+		}
+
+	public:
+
+		static Cow_pager &pager(Env &env)
+		{
+			static Cow_pager pager { env };
+			return pager;
+		}
+
+		Capability<Genode::Region_map> create(Cow_segment &segment, size_t size)
+		{
+			{
+				Mutex::Guard guard(_mutex);
+				_segments.insert(&segment);
+			}
+			return _rm_connection.create(size);
+		}
+
+		Signal_context_capability manage(Signal_context &context) {
+			return _receiver.manage(context); }
+
+		void destroy(Cow_segment &segment, Signal_context &context,
+		             Capability<Genode::Region_map> rm)
+		{
+			{
+				Mutex::Guard guard(_mutex);
+				_segments.remove(&segment);
+			}
+
+			/*
+			 * Dissolving the context blocks until the pager has dropped a
+			 * signal in flight, hence it must not be done with '_mutex' held.
+			 */
+			_receiver.dissolve(context);
+			_rm_connection.destroy(rm);
+		}
+};
+
+
+Linker::Cow_segment::Cow_segment(Env &env, Allocator &alloc, char const *src,
+                                 size_t file_size, size_t size)
+:
+	_env(env), _alloc(alloc), _pager(Cow_pager::pager(env)),
+	_src(src), _file_size(file_size), _size(size),
+	_rm_cap(_pager.create(*this, size))
+{
+	for (unsigned i = 0; i < _num_chunks; i++)
+		construct_at<Ram_dataspace_capability>(&_chunks[i]);
+
+	_fault_sigh = _pager.manage(_fault_context);
+	_rm.fault_handler(_fault_sigh);
+}
+
+
+Linker::Cow_segment::~Cow_segment()
+{
+	_pager.destroy(*this, _fault_context, _rm_cap);
+
+	for (unsigned i = 0; i < _num_chunks; i++)
+		if (_chunks[i].valid())
+			_env.ram().free(_chunks[i]);
+
+	_alloc.free(_chunks, _num_chunks*sizeof(Ram_dataspace_capability));
+
+	_env.rm().detach(addr_t(_src));
+}
+
+
+void Linker::Cow_segment::_handle_fault()
+{
+	Genode::Region_map::Fault const fault = _rm.fault();
+
+	if (fault.type == Genode::Region_map::Fault::Type::NONE)
+		return;
+
+	unsigned const i = unsigned(fault.addr/CHUNK_SIZE);
+
+	if (i >= _num_chunks) {
+		error("LD: unresolvable fault in RW segment at offset ", Hex(fault.addr));
+		return;
+	}
+
+	/* chunk populated on behalf of another faulting thread */
+	if (_chunks[i].valid())
+		return;
+
+	addr_t const offset = i*CHUNK_SIZE;
+	size_t const size   = min(CHUNK_SIZE, _size - offset);
+
+	try { _chunks[i] = _env.ram().alloc(size); }
+	catch (...) {
+		error("LD: failed to allocate RAM for RW segment");
+		return;
+	}
+
+	/* initialize chunk before it becomes visible to the faulting thread */
+	if (offset < _file_size) {
+		_env.rm().attach(_chunks[i], Genode::Region_map::Attr {
+			.size       = { },
+			.offset     = { },
+			.use_at     = { },
+			.at         = { },
+			.executable = { },
+			.writeable  = true
+		}).with_result(
+			[&] (Genode::Region_map::Range range) {
+				memcpy((void *)range.start, _src + offset,
+				       min(size, _file_size - offset));
+				_env.rm().detach(range.start);
+			},
+			[&] (Genode::Region_map::Attach_error) {
+				error("LD: failed to initialize chunk of RW segment"); }
+		);
+	}
+
+	_rm.attach(_chunks[i], Genode::Region_map::Attr {
+		.size       = size,
+		.offset     = { },
+		.use_at     = true,
+		.at         = offset,
+		.executable = { },
+		.writeable  = true
+	}).with_result(
+		[&] (Genode::Region_map::Range) { _populated++; },
+		[&] (Genode::Region_map::Attach_error) {
+			error("LD: failed to attach chunk of RW segment"); }
+	);
+}
+
+#endif /* _INCLUDE__COW_SEGMENT_H_ */
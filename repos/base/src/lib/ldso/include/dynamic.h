@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,93 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU-style hash table as emitted by 'ld --hash-style=gnu'
+ *
+ * The table starts with a header followed by a bloom filter of 'Elf::Addr'
+ * words, the buckets, and the hash values of the symbols starting at index
+ * 'symoffset'. The symbols of each bucket are sorted consecutively in the
+ * symbol table. The lowest bit of a hash value marks the end of a chain.
+ */
+struct Linker::Gnu_hash_table
+{
+	Elf::Hashelt nbuckets;
+	Elf::Hashelt symoffset;
+	Elf::Hashelt bloom_size;
+	Elf::Hashelt bloom_shift;
+
+	enum { BLOOM_BITS = sizeof(Elf::Addr)*8 };
+
+	Elf::Addr const *bloom() const {
+		return (Elf::Addr const *)(this + 1); }
+
+	Elf::Hashelt const *buckets() const {
+		return (Elf::Hashelt const *)(bloom() + bloom_size); }
+
+	Elf::Hashelt const *chain() const {
+		return buckets() + nbuckets - symoffset; }
+
+	/**
+	 * Return false if the bloom filter rules out a symbol with 'hash'
+	 */
+	bool may_contain(Elf::Hashelt hash) const
+	{
+		Elf::Addr const word = bloom()[(hash / BLOOM_BITS) % bloom_size];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BLOOM_BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift) % BLOOM_BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols covered by the table
+	 *
+	 * The table has no explicit symbol count. The highest symbol index is
+	 * found at the end of the chain of the highest bucket.
+	 */
+	unsigned long num_symbols() const
+	{
+		Elf::Hashelt max_index = 0;
+		for (Elf::Hashelt i = 0; i < nbuckets; i++)
+			max_index = max(max_index, buckets()[i]);
+
+		if (max_index < symoffset)
+			return symoffset;
+
+		while (!(chain()[max_index] & 1))
+			max_index++;
+
+		return max_index + 1;
+	}
+
+	/**
+	 * Hash function of the GNU toolchain (Bernstein's djb2)
+	 */
+	static Elf::Hashelt hash(char const *name)
+	{
+		Elf::Hashelt h = 5381;
+
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long const sysv;
+	Elf::Hashelt  const gnu;
+
+	Symbol_hash(char const *name)
+	: sysv(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,6 +183,8 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash_table = nullptr;
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -158,6 +249,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash_table)>(&_gnu_hash_table, d); break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -173,6 +265,86 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+			else if (_gnu_hash_table)
+				_num_symbols = _gnu_hash_table->num_symbols();
+		}
+
+		/**
+		 * Return true if 'sym' is a definition of the symbol 'name'
+		 */
+		bool _defines(Elf::Sym const &sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym.type() > STT_FUNC)
+				return false;
+
+			if (sym.st_value == 0)
+				return false;
+
+			char const *sym_name = symbol_name(sym);
+
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_sysv(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				Elf::Sym const *sym = symbol(sym_index);
+
+				if (_defines(*sym, name))
+					return sym;
+			}
+
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, Elf::Hashelt hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash_table;
+
+			if (!h.nbuckets || !h.bloom_size || !h.may_contain(hash))
+				return nullptr;
+
+			unsigned long sym_index = h.buckets()[hash % h.nbuckets];
+
+			if (sym_index < h.symoffset)
+				return nullptr;
+
+			/* traverse the consecutive symbols of the bucket */
+			for (;; sym_index++) {
+
+				/* bad object */
+				if (sym_index >= _num_symbols)
+					return nullptr;
+
+				Elf::Hashelt const sym_hash = h.chain()[sym_index];
+
+				/* compare the strings only if the hash values match */
+				if ((sym_hash | 1) == (hash | 1)) {
+					Elf::Sym const *sym = _symtab + sym_index;
+					if (_defines(*sym, name))
+						return sym;
+				}
+
+				if (sym_hash & 1)
+					return nullptr;
+			}
 		}
 
 	public:
@@ -216,7 +388,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -227,6 +399,16 @@ class Linker::Dynamic
 			return _strtab + sym.st_name;
 		}
 
+		/**
+		 * Call 'fn' with the symbol table, its number of entries, the string
+		 * table, and its size as arguments
+		 */
+		void with_symbol_tables(auto const &fn) const
+		{
+			fn((Elf::Sym const *)_symtab, _num_symbols,
+			   (char const *)_strtab, _strtab_size);
+		}
+
 		void const *dynamic_ptr() const { return &_dynamic; }
 
 		void dep(Dependency const &dep) { _dep = &dep; }
@@ -234,46 +416,29 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
-		 * the beginning of the file
+		 * Use hash-table address for linker, assuming that it will always be
+		 * at the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash_table);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred if present because its bloom
+		 * filter rejects most lookups of symbols not defined by the object
+		 * without touching the buckets.
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
+			if (_gnu_hash_table)
+				return _lookup_gnu(name, hash.gnu);
 
-			unsigned sym_index = h->buckets()[hash % h->nbuckets()];
-
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
-					return nullptr;
-
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
-			}
+			if (_hash_table)
+				return _lookup_sysv(name, hash.sysv);
 
 			return nullptr;
 		}
@@ -285,7 +450,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
@@ -21,10 +21,13 @@
 #include <util.h>
 #include <debug.h>
 #include <region_map.h>
+#include <cow_segment.h>
 
 
 namespace Linker {
 
+	extern bool cow_rw;
+
 	struct Phdr;
 	struct File;
 	struct Elf_file;
@@ -92,11 +95,16 @@ struct Linker::File
 struct Linker::Elf_file : File
 {
 	Env                          &env;
+	Allocator                    &md_alloc;
 	Constructible<Rom_connection> rom_connection { };
 	Rom_dataspace_capability      rom_cap        { };
 	Ram_dataspace_capability      ram_cap[Phdr::MAX_PHDR];
+	Constructible<Cow_segment>    cow_segment[Phdr::MAX_PHDR] { };
 	bool                    const loaded;
 
+	/* minimum size of RW segments populated on demand if 'cow_rw' is set */
+	static constexpr size_t MIN_COW_SIZE = 64*1024;
+
 	using Name = String<64>;
 
 	Rom_dataspace_capability _rom_dataspace(Name const &name)
@@ -156,7 +164,7 @@ struct Linker::Elf_file : File
 
 	Elf_file(Env &env, Allocator &md_alloc, Name const &name, bool load)
 	:
-		env(env), rom_cap(_rom_dataspace(name)), loaded(load)
+		env(env), md_alloc(md_alloc), rom_cap(_rom_dataspace(name)), loaded(load)
 	{
 		load_phdr();
 
@@ -338,6 +346,11 @@ struct Linker::Elf_file : File
 
 		addr_t const dst = p.p_vaddr + reloc_base;
 
+		if (cow_rw && p.p_memsz >= MIN_COW_SIZE) {
+			load_segment_cow(p, nr, (char const *)src, dst);
+			return;
+		}
+
 		ram_cap[nr] = env.ram().alloc(p.p_memsz);
 
 		Region_map::r()->attach(ram_cap[nr], Region_map::Attr {
@@ -362,6 +375,27 @@ struct Linker::Elf_file : File
 		env.rm().detach(addr_t(src));
 	}
 
+	/**
+	 * Map read-write segment that is copied from 'src' on demand
+	 *
+	 * The segment keeps 'src' attached until it is unloaded.
+	 */
+	void load_segment_cow(Elf::Phdr const &p, int nr, char const *src, addr_t dst)
+	{
+		cow_segment[nr].construct(env, md_alloc, src, p.p_filesz,
+		                          round_page(p.p_memsz));
+
+		if (Region_map::r()->attach(cow_segment[nr]->dataspace(), Region_map::Attr {
+			.size       = round_page(p.p_memsz),
+			.offset     = { },
+			.use_at     = true,
+			.at         = dst,
+			.executable = { },
+			.writeable  = true
+		}).failed())
+			error("dynamic linker failed to attach copy-on-write RW segment");
+	}
+
 	/**
 	 * Unmap segements, RM regions, and free allocated dataspaces
 	 */
@@ -377,6 +411,15 @@ struct Linker::Elf_file : File
 		/* free region from RM area */
 		Region_map::r()->free_region(trunc_page(p.phdr[0].p_vaddr) + reloc_base);
 
+		/* release RW segments populated on demand */
+		for (unsigned i = 0; i < Phdr::MAX_PHDR; i++)
+			if (cow_segment[i].constructed()) {
+				if (verbose)
+					log("LD: populated ", cow_segment[i]->populated_bytes()/1024,
+					    " of ", cow_segment[i]->size()/1024, " KiB of RW segment");
+				cow_segment[i].destruct();
+			}
+
 		/* free ram of RW segments */
 		for (unsigned i = 0; i < Phdr::MAX_PHDR; i++)
 			if (ram_cap[i].valid()) {
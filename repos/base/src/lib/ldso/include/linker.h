@@ -48,6 +48,13 @@ namespace Linker {
 	 */
 	extern bool verbose;
 
+	/**
+	 * Populate large read-write segments on demand
+	 *
+	 * The value corresponds to the config attribute "ld_cow".
+	 */
+	extern bool cow_rw;
+
 	/**
 	 * Stage of execution
 	 *
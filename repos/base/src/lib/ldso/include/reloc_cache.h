@@ -0,0 +1,290 @@
+/*
+ * \brief  Persistent cache of symbol-lookup results
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RELOC_CACHE_H_
+#define _INCLUDE__RELOC_CACHE_H_
+
+#include <base/attached_rom_dataspace.h>
+#include <dynamic.h>
+
+namespace Linker { class Reloc_cache; }
+
+
+/**
+ * Cache of symbol-lookup results of the objects loaded at startup
+ *
+ * For each symbol referenced by a loaded object, the cache stores the
+ * object and symbol index of the definition found by the lookup. At
+ * startup, the cache is initialized from the ROM module "ld_reloc_cache"
+ * if the key stored in the module matches the key computed from the
+ * names and symbol tables of the loaded objects. Hence, any change of the
+ * binary or one of its libraries invalidates the cached results.
+ *
+ * Results missing from the cache are looked up as usual and recorded. The
+ * updated cache can be obtained via 'Dynamic_linker::with_relocation_cache'.
+ */
+class Linker::Reloc_cache
+{
+	public:
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint32_t num_objects;
+			uint32_t num_entries;
+		};
+
+		struct Entry
+		{
+			uint32_t object;  /* index of defining object + 1, 0 if unknown */
+			uint32_t symbol;  /* symbol index within the defining object */
+		};
+
+		static constexpr uint32_t MAGIC   = 0x63726c64;
+		static constexpr uint32_t VERSION = 1;
+
+		static constexpr unsigned MAX_OBJECTS = 128;
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Reloc_cache(Reloc_cache const &);
+		Reloc_cache &operator = (Reloc_cache const &);
+
+		struct Slot
+		{
+			Object   const *obj;
+			Elf::Sym const *symtab;
+			unsigned long   num_symbols;
+			unsigned long   first;  /* index of the object's first entry */
+		};
+
+		Allocator &_alloc;
+
+		Slot     _slots[MAX_OBJECTS] { };
+		unsigned _num_objects = 0;
+		unsigned _last        = 0;  /* slot used by the most recent lookup */
+
+		unsigned long _num_entries = 0;
+
+		uint64_t _key = 0xcbf29ce484222325ULL;
+
+		size_t const _size = _init_slots() ? sizeof(Header) + _num_entries*sizeof(Entry)
+		                                   : 0;
+
+		Header * const _header = _size ? (Header *)_alloc.alloc(_size) : nullptr;
+		Entry  * const _entries = _header ? (Entry *)(_header + 1) : nullptr;
+
+		bool _dirty = false;
+
+		unsigned long _hits = 0, _misses = 0;
+
+		/**
+		 * FNV-1a hash, processing one machine word per step
+		 */
+		static uint64_t _hash(uint64_t h, void const *data, size_t size)
+		{
+			uint8_t const *p = (uint8_t const *)data;
+
+			for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), p += sizeof(uint64_t)) {
+				uint64_t word;
+				__builtin_memcpy(&word, p, sizeof(word));
+				h = (h ^ word) * 0x100000001b3ULL;
+			}
+
+			for (; size; size--, p++)
+				h = (h ^ *p) * 0x100000001b3ULL;
+
+			return h;
+		}
+
+		bool _init_slots()
+		{
+			bool overflow = false;
+
+			Object::with_object_list([&] (Object::Object_list &list) {
+				list.for_each([&] (Object const &obj) {
+
+					if (_num_objects == MAX_OBJECTS) {
+						overflow = true;
+						return;
+					}
+
+					obj.dynamic().with_symbol_tables([&] (Elf::Sym const *symtab,
+					                                      unsigned long num_symbols,
+					                                      char const *strtab,
+					                                      unsigned long strtab_size) {
+
+						_slots[_num_objects++] = { .obj         = &obj,
+						                           .symtab      = symtab,
+						                           .num_symbols = num_symbols,
+						                           .first       = _num_entries };
+						_num_entries += num_symbols;
+
+						_key = _hash(_key, obj.name(), strlen(obj.name()));
+						_key = _hash(_key, &num_symbols, sizeof(num_symbols));
+						_key = _hash(_key, symtab, num_symbols*sizeof(Elf::Sym));
+						_key = _hash(_key, strtab, strtab_size);
+					});
+				});
+			});
+
+			if (overflow) {
+				warning("LD: too many objects for relocation cache");
+				_num_objects = 0;
+			}
+			return _num_objects > 0;
+		}
+
+		void _import(Env &env)
+		{
+			memset(_entries, 0, _num_entries*sizeof(Entry));
+
+			try {
+				Attached_rom_dataspace const rom(env, "ld_reloc_cache");
+
+				Header const &header = *rom.local_addr<Header const>();
+
+				bool const valid = rom.size()          >= _size
+				                && header.magic        == MAGIC
+				                && header.version      == VERSION
+				                && header.key          == _key
+				                && header.num_objects  == _num_objects
+				                && header.num_entries  == _num_entries;
+				if (valid) {
+					memcpy(_entries, &header + 1, _num_entries*sizeof(Entry));
+					return;
+				}
+			}
+			catch (...) { }
+
+			/* the cache content differs from the ROM module, if present */
+			_dirty = true;
+		}
+
+		Entry *_entry(Object const &obj, unsigned sym_index)
+		{
+			if (_slots[_last].obj != &obj) {
+				unsigned i = 0;
+				for (; i < _num_objects && _slots[i].obj != &obj; i++);
+
+				if (i == _num_objects)
+					return nullptr;
+
+				_last = i;
+			}
+
+			Slot const &slot = _slots[_last];
+
+			return sym_index < slot.num_symbols ? &_entries[slot.first + sym_index]
+			                                    : nullptr;
+		}
+
+		void _record(Entry &entry, Elf::Sym const *sym)
+		{
+			for (unsigned i = 0; i < _num_objects; i++) {
+
+				Slot const &slot = _slots[i];
+
+				if (sym < slot.symtab || sym >= slot.symtab + slot.num_symbols)
+					continue;
+
+				entry = { .object = i + 1, .symbol = uint32_t(sym - slot.symtab) };
+				_dirty = true;
+				return;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * Must be called once all objects needed at startup are loaded.
+		 */
+		Reloc_cache(Env &env, Allocator &alloc) : _alloc(alloc)
+		{
+			if (!_header)
+				return;
+
+			*_header = { .magic       = MAGIC,
+			             .version     = VERSION,
+			             .key         = _key,
+			             .num_objects = _num_objects,
+			             .num_entries = uint32_t(_num_entries) };
+			_import(env);
+		}
+
+		~Reloc_cache()
+		{
+			if (_header)
+				_alloc.free(_header, _size);
+		}
+
+		/**
+		 * Look up definition of symbol 'sym_index' referenced by 'obj'
+		 *
+		 * If no result is cached, the lookup is performed by calling
+		 * 'lookup_fn', which returns the symbol and sets 'base'.
+		 */
+		Elf::Sym const *lookup(Object const &obj, unsigned sym_index,
+		                       Elf::Addr *base, auto const &lookup_fn)
+		{
+			Entry * const entry = _header ? _entry(obj, sym_index) : nullptr;
+			if (!entry)
+				return lookup_fn();
+
+			if (entry->object && entry->object <= _num_objects) {
+
+				Slot const &def = _slots[entry->object - 1];
+
+				if (entry->symbol < def.num_symbols) {
+					_hits++;
+					*base = def.obj->reloc_base();
+					return def.symtab + entry->symbol;
+				}
+			}
+
+			_misses++;
+
+			Elf::Sym const * const sym = lookup_fn();
+			if (sym)
+				_record(*entry, sym);
+
+			return sym;
+		}
+
+		unsigned long hits()   const { return _hits; }
+		unsigned long misses() const { return _misses; }
+
+		/**
+		 * Call 'fn' with the cache content if it changed since it was stored
+		 *
+		 * The functor returns true if it stored the content successfully.
+		 * Otherwise, the content is still considered as modified.
+		 */
+		void with_modified_content(auto const &fn)
+		{
+			if (!_header || !_dirty)
+				return;
+
+			if (fn(Const_byte_range_ptr((char const *)_header, _size)))
+				_dirty = false;
+		}
+};
+
+#endif /* _INCLUDE__RELOC_CACHE_H_ */
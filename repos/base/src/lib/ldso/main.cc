@@ -29,6 +29,7 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <reloc_cache.h>
 
 using namespace Linker;
 
@@ -43,8 +44,10 @@ namespace Linker {
 };
 
 static    Binary *binary_ptr = nullptr;
+static    Reloc_cache *reloc_cache_ptr = nullptr;
 static    Parent *parent_ptr = nullptr;
 bool      Linker::verbose  = false;
+bool      Linker::cow_rw   = false;
 Stage     Linker::stage    = STAGE_BINARY;
 Link_map *Link_map::first;
 
@@ -189,7 +192,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -348,6 +351,8 @@ struct Linker::Binary : private Root_object, public Elf_object
 
 	bool static_construction_finished = false;
 
+	Constructible<Reloc_cache> _reloc_cache { };
+
 	Binary(Env &env, Allocator &md_alloc, Config const &config, char const *name)
 	:
 		Root_object(md_alloc),
@@ -372,10 +377,22 @@ struct Linker::Binary : private Root_object, public Elf_object
 		/* load dependencies */
 		binary->load_needed(env, md_alloc, deps(), DONT_KEEP);
 
+		/* use cached symbol lookups for the relocation of all objects */
+		if (config.reloc_cache()) {
+			_reloc_cache.construct(env, md_alloc);
+			reloc_cache_ptr = &*_reloc_cache;
+		}
+
 		/* relocate and call constructors */
 		Init::list()->initialize(config.bind(), STAGE_BINARY);
+
+		if (_reloc_cache.constructed() && verbose)
+			log("LD: relocation cache: ", _reloc_cache->hits(), " hits, ",
+			    _reloc_cache->misses(), " misses");
 	}
 
+	~Binary() { reloc_cache_ptr = nullptr; }
+
 	Elf::Addr lookup_symbol(char const *name)
 	{
 		try {
@@ -481,7 +498,7 @@ void genode_exit(int status)
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
+	Symbol_hash     hash { name };
 	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
 
 	if (sym)
@@ -543,7 +560,14 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 		return symbol;
 	}
 
-	return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
+	auto lookup_by_name = [&] {
+		return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other); };
+
+	/* lookups of undefined and copy-relocated symbols are not cached */
+	if (reloc_cache_ptr && !undef && !other)
+		return reloc_cache_ptr->lookup(elf, sym_index, base, lookup_by_name);
+
+	return lookup_by_name();
 }
 
 
@@ -551,7 +575,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash        { name };
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -737,6 +761,17 @@ void Genode::Dynamic_linker::_for_each_loaded_object(Env &, For_each_fn const &f
 }
 
 
+void Genode::Dynamic_linker::_with_relocation_cache(Env &,
+                                                    Relocation_cache_fn const &fn)
+{
+	Mutex::Guard guard(mutex());
+
+	if (reloc_cache_ptr)
+		reloc_cache_ptr->with_modified_content([&] (Const_byte_range_ptr const &content) {
+			return fn.supply_relocation_cache(content); });
+}
+
+
 void Dynamic_linker::keep(Env &, char const *binary)
 {
 	Object::with_object_list([&] (Object::Object_list &list) {
@@ -777,6 +812,12 @@ void Component::construct(Genode::Env &env)
 	Config const config(env);
 
 	verbose = config.verbose();
+	cow_rw  = config.cow_rw();
+
+	if (cow_rw && !cow_segments_supported) {
+		warning("LD: 'ld_cow' is not supported on this platform, ignoring");
+		cow_rw = false;
+	}
 
 	parent_ptr = &env.parent();
 
@@ -68,36 +68,41 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 		if (_destructor_called) {
 			return;
 		}
-		_current_time = curr_time.trunc_to_plain_us();
+		uint64_t const now_us { curr_time.trunc_to_plain_us().value };
 
 		/* apply rate limit to the handling of timeouts */
-		if (_current_time.value < _rate_limit_deadline.value) {
+		if (now_us < _rate_limit_deadline.value) {
 
+			_time_source_deadline_us = _rate_limit_deadline.value;
 			_time_source.set_timeout(
-				Microseconds { _rate_limit_deadline.value -
-				               _current_time.value },
+				Microseconds { _rate_limit_deadline.value - now_us },
 				*this);
 
 			return;
 		}
-		_rate_limit_deadline.value = _current_time.value +
-		                             _rate_limit_period.value;
+		_rate_limit_deadline.value = now_us + _rate_limit_period.value;
 
 		/*
 		 * Filter out all pending timeouts to a local list first. The
-		 * processing of pending timeouts can have effects on the '_timeouts'
-		 * list and these would interfere with the filtering if we would do
-		 * it all in the same loop.
+		 * processing of pending timeouts can have effects on the timer
+		 * wheel and these would interfere with the filtering if we would do
+		 * it all in the same loop. Timeouts of the reached slots that are
+		 * not pending yet move to a lower level of the wheel.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
-
-			timeout->_mutex.acquire();
-			if (timeout->_deadline.value > _current_time.value) {
-				timeout->_mutex.release();
-				break;
+		Timeout *due { _detach_due_timeouts(now_us) };
+		while (due != nullptr) {
+
+			Timeout &timeout { *due };
+			due = timeout._wheel_next;
+			timeout._wheel_next = nullptr;
+
+			timeout._mutex.acquire();
+			if (timeout._deadline.value > _current_time.value) {
+				_insert_into_wheel(timeout);
+				timeout._mutex.release();
+				continue;
 			}
-			_timeouts.remove(timeout);
-			pending_timeouts.insert(&timeout->_pending_timeouts_le);
+			pending_timeouts.insert(&timeout._pending_timeouts_le);
 		}
 		/*
 		 * Do the framework-internal processing of the pending timeouts and
@@ -153,9 +158,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timer wheel */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_insert_into_wheel(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -223,7 +228,7 @@ Timeout_scheduler::~Timeout_scheduler()
 	_destructor_called = true;
 
 	/* discard all scheduled timeouts */
-	while (Timeout *timeout = _timeouts.first()) {
+	while (Timeout *timeout = _any_timeout()) {
 		Mutex::Guard const timeout_guard { timeout->_mutex };
 		_discard_timeout_unsynchronized(*timeout);
 	}
@@ -242,10 +247,12 @@ void Timeout_scheduler::_enable()
 
 void Timeout_scheduler::_set_time_source_timeout()
 {
+	uint64_t const deadline_us { _next_deadline_us() };
+
+	_time_source_deadline_us = deadline_us;
 	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
-			~(uint64_t)0);
+		deadline_us == ~(uint64_t)0 ? ~(uint64_t)0 :
+		deadline_us > _current_time.value ? deadline_us - _current_time.value : 0);
 }
 
 
@@ -297,7 +304,7 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 
 	/* prevent inserting a timeout twice */
 	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
+		_remove_from_wheel(timeout);
 	}
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
@@ -307,42 +314,163 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/* set up timeout object and insert into timer wheel */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_insert_into_wheel(timeout);
 
 	/*
-	 * If the new timeout is the first to trigger, we have to  update the
-	 * time-source timeout.
+	 * If the new timeout triggers before the timeout installed at the time
+	 * source, we have to update the time-source timeout.
 	 */
-	if (_timeouts.first() == &timeout) {
+	if (deadline_us < _time_source_deadline_us) {
+		_time_source_deadline_us = deadline_us;
 		_set_time_source_timeout(deadline_us - curr_time_us);
 	}
 }
 
 
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
+static inline uint64_t rotated_left(uint64_t value, unsigned bits)
 {
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
-		return;
+	return bits ? (value << bits) | (value >> (64 - bits)) : value;
+}
+
+
+void Timeout_scheduler::_insert_into_wheel(Timeout &timeout)
+{
+	uint64_t const now_us      { _current_time.value };
+	uint64_t const deadline_us { max(timeout._deadline.value, now_us) };
+
+	/* select lowest level that covers the deadline */
+	unsigned level { 0 };
+	for (; level + 1 < WHEEL_LEVELS; level++) {
+		unsigned const shift { _wheel_shift(level) };
+		if ((deadline_us >> shift) - (now_us >> shift) < WHEEL_SLOTS)
+			break;
 	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
-		return;
+
+	/* deadlines beyond the top level are revisited with its last slot */
+	unsigned const shift { _wheel_shift(level) };
+	uint64_t   const tick  { min(deadline_us >> shift,
+	                             (now_us >> shift) + WHEEL_SLOTS - 1) };
+
+	unsigned const index { unsigned(tick % WHEEL_SLOTS) };
+	unsigned const slot  { level*WHEEL_SLOTS + index };
+
+	timeout._wheel_slot = slot;
+	timeout._wheel_prev = nullptr;
+	timeout._wheel_next = _wheel[slot];
+
+	if (_wheel[slot] != nullptr) {
+		_wheel[slot]->_wheel_prev = &timeout;
+	}
+	_wheel[slot] = &timeout;
+	_wheel_occupied[level] |= 1ULL << index;
+}
+
+
+void Timeout_scheduler::_remove_from_wheel(Timeout &timeout)
+{
+	unsigned const slot { timeout._wheel_slot };
+
+	if (timeout._wheel_prev != nullptr) {
+		timeout._wheel_prev->_wheel_next = timeout._wheel_next;
+	} else {
+		_wheel[slot] = timeout._wheel_next;
+	}
+	if (timeout._wheel_next != nullptr) {
+		timeout._wheel_next->_wheel_prev = timeout._wheel_prev;
+	}
+	timeout._wheel_prev = nullptr;
+	timeout._wheel_next = nullptr;
+
+	if (_wheel[slot] == nullptr) {
+		_wheel_occupied[slot / WHEEL_SLOTS] &= ~(1ULL << (slot % WHEEL_SLOTS));
+	}
+}
+
+
+Timeout *Timeout_scheduler::_detach_due_timeouts(uint64_t now_us)
+{
+	Timeout *result { nullptr };
+
+	for (unsigned level { 0 }; level < WHEEL_LEVELS; level++) {
+
+		unsigned const shift      { _wheel_shift(level) };
+		uint64_t const first_tick { _current_time.value >> shift };
+		uint64_t const num_ticks  { (now_us >> shift) - first_tick + 1 };
+
+		/* slots from the current tick up to the tick of 'now_us' */
+		uint64_t const due_slots {
+			num_ticks >= WHEEL_SLOTS ? ~(uint64_t)0 :
+			rotated_left((1ULL << num_ticks) - 1,
+			             unsigned(first_tick % WHEEL_SLOTS)) };
+
+		for (uint64_t slots { _wheel_occupied[level] & due_slots }; slots;
+		     slots &= slots - 1) {
+
+			unsigned const slot { level*WHEEL_SLOTS +
+			                      unsigned(__builtin_ctzll(slots)) };
+
+			while (Timeout *timeout = _wheel[slot]) {
+				_wheel[slot] = timeout->_wheel_next;
+				timeout->_wheel_prev = nullptr;
+				timeout->_wheel_next = result;
+				result = timeout;
+			}
+		}
+		_wheel_occupied[level] &= ~due_slots;
+	}
+	_current_time = Microseconds { now_us };
+	return result;
+}
+
+
+uint64_t Timeout_scheduler::_next_deadline_us() const
+{
+	uint64_t result { ~(uint64_t)0 };
+
+	for (unsigned level { 0 }; level < WHEEL_LEVELS; level++) {
+
+		if (_wheel_occupied[level] == 0) {
+			continue;
+		}
+		unsigned const shift { _wheel_shift(level) };
+		uint64_t const tick  { _current_time.value >> shift };
+		unsigned const index { unsigned(tick % WHEEL_SLOTS) };
+
+		/* distance of the nearest occupied slot from the current tick */
+		unsigned const distance { unsigned(__builtin_ctzll(
+			rotated_left(_wheel_occupied[level], (WHEEL_SLOTS - index) % WHEEL_SLOTS))) };
+
+		/*
+		 * The deadlines of the nearest level-0 slot are inspected
+		 * individually. A slot of a higher level is reached at its start,
+		 * which triggers the move of its timeouts to lower levels.
+		 */
+		if (level == 0) {
+			unsigned const slot { (index + distance) % WHEEL_SLOTS };
+			for (Timeout const *t { _wheel[slot] }; t; t = t->_wheel_next) {
+				result = min(result, t->_deadline.value);
+			}
+		} else {
+			result = min(result, (tick + distance) << shift);
+		}
+	}
+	return result;
+}
+
+
+Timeout *Timeout_scheduler::_any_timeout()
+{
+	for (unsigned level { 0 }; level < WHEEL_LEVELS; level++) {
+		if (_wheel_occupied[level] != 0) {
+			return _wheel[level*WHEEL_SLOTS +
+			              unsigned(__builtin_ctzll(_wheel_occupied[level]))];
+		}
 	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
+	return nullptr;
 }
 
 
@@ -393,7 +521,9 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	if (timeout._handler != nullptr) {
+		_remove_from_wheel(timeout);
+	}
 	timeout._handler = nullptr;
 }
 
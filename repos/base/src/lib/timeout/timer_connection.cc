@@ -131,6 +131,19 @@ Timer::Connection::Connection(Env &env, Entrypoint &ep, Label const &label)
 }
 
 
+Timer::Connection::Connection(Env &env, Entrypoint &ep, Microseconds slack,
+                              Label const &label)
+:
+	Genode::Connection<Session>(env, label, Ram_quota { 10*1024 },
+	                            Args("slack_us=", slack.value)),
+	Session_client(cap()),
+	_signal_handler(ep, *this, &Connection::_handle_timeout)
+{
+	/* register default signal handler */
+	Session_client::sigh(_default_sigh_cap);
+}
+
+
 Timeout_scheduler &Timer::Connection::_switch_to_timeout_framework_mode()
 {
 	if (_mode == TIMEOUT_FRAMEWORK) {
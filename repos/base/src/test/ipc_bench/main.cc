@@ -0,0 +1,341 @@
+/*
+ * \brief  Latency benchmarks of IPC-related primitives
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark measures the latency of RPC round trips with different
+ * payload sizes, capability transfers, signal delivery, and the attachment
+ * of dataspaces. Each primitive is sampled individually using the CPU's
+ * timestamp counter, which is calibrated against the timer service. The
+ * results are reported as percentiles in nanoseconds.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/blockade.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/attached_rom_dataspace.h>
+#include <trace/timestamp.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	template <unsigned> struct Payload;
+
+	using Payload_8  = Payload<8>;
+	using Payload_64 = Payload<64>;
+
+	struct Bench;
+	struct Bench_component;
+	struct Bench_client;
+	struct Samples;
+	struct Main;
+}
+
+
+template <unsigned WORDS>
+struct Test::Payload { unsigned long words[WORDS]; };
+
+
+struct Test::Bench : Interface
+{
+	virtual void nop() = 0;
+	virtual void payload_8(Payload_8 const &) = 0;
+	virtual void payload_64(Payload_64 const &) = 0;
+	virtual Capability<Bench> cap_transfer(Capability<Bench>) = 0;
+
+	GENODE_RPC(Rpc_nop, void, nop);
+	GENODE_RPC(Rpc_payload_8, void, payload_8, Payload_8 const &);
+	GENODE_RPC(Rpc_payload_64, void, payload_64, Payload_64 const &);
+	GENODE_RPC(Rpc_cap_transfer, Capability<Bench>, cap_transfer, Capability<Bench>);
+	GENODE_RPC_INTERFACE(Rpc_nop, Rpc_payload_8, Rpc_payload_64, Rpc_cap_transfer);
+};
+
+
+struct Test::Bench_component : Rpc_object<Bench, Bench_component>
+{
+	void nop() override { }
+	void payload_8(Payload_8 const &) override { }
+	void payload_64(Payload_64 const &) override { }
+
+	Capability<Bench> cap_transfer(Capability<Bench> cap) override { return cap; }
+};
+
+
+struct Test::Bench_client : Rpc_client<Bench>
+{
+	Bench_client(Capability<Bench> cap) : Rpc_client<Bench>(cap) { }
+
+	void nop() override { call<Rpc_nop>(); }
+
+	void payload_8(Payload_8 const &p) override { call<Rpc_payload_8>(p); }
+
+	void payload_64(Payload_64 const &p) override { call<Rpc_payload_64>(p); }
+
+	Capability<Bench> cap_transfer(Capability<Bench> cap) override {
+		return call<Rpc_cap_transfer>(cap); }
+};
+
+
+/**
+ * Array of latency samples in timestamp ticks
+ */
+struct Test::Samples
+{
+	Allocator &_alloc;
+
+	unsigned const capacity;
+
+	Trace::Timestamp * const _values =
+		(Trace::Timestamp *)_alloc.alloc(sizeof(Trace::Timestamp)*capacity);
+
+	unsigned _count = 0;
+
+	Samples(Allocator &alloc, unsigned capacity)
+	: _alloc(alloc), capacity(capacity) { }
+
+	~Samples() { _alloc.free(_values, sizeof(Trace::Timestamp)*capacity); }
+
+	void add(Trace::Timestamp value)
+	{
+		if (_count < capacity)
+			_values[_count++] = value;
+	}
+
+	void reset() { _count = 0; }
+
+	/**
+	 * Sort samples in ascending order using shell sort
+	 */
+	void _sort()
+	{
+		for (unsigned gap = _count/2; gap > 0; gap /= 2)
+			for (unsigned i = gap; i < _count; i++) {
+				Trace::Timestamp const v = _values[i];
+				unsigned j = i;
+				for (; j >= gap && _values[j - gap] > v; j -= gap)
+					_values[j] = _values[j - gap];
+				_values[j] = v;
+			}
+	}
+
+	Trace::Timestamp _percentile(unsigned p) const
+	{
+		return _values[min(_count - 1, (_count*p)/100)];
+	}
+
+	/**
+	 * Print percentiles, converting ticks to nanoseconds
+	 */
+	void report(char const *brief, uint64_t ticks_per_ms)
+	{
+		if (!_count)
+			return;
+
+		_sort();
+
+		auto ns = [&] (Trace::Timestamp ticks) {
+			return (ticks*1000*1000)/max(ticks_per_ms, (uint64_t)1); };
+
+		log(brief, ": samples=", _count,
+		    " min=", ns(_values[0]),
+		    " p50=", ns(_percentile(50)),
+		    " p90=", ns(_percentile(90)),
+		    " p99=", ns(_percentile(99)),
+		    " max=", ns(_values[_count - 1]), " [ns]");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Samples(Samples const &);
+		Samples &operator = (Samples const &);
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_samples =
+		_config.xml().attribute_value("samples", 10000u);
+
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Entrypoint _server_ep { _env, STACK_SIZE, "server_ep", Affinity::Location() };
+
+	Bench_component _bench_component { };
+
+	Capability<Bench> _bench_cap = _server_ep.manage(_bench_component);
+
+	Bench_client _bench { _bench_cap };
+
+	Samples _samples { _heap, _num_samples };
+
+	uint64_t const _ticks_per_ms = _calibrate();
+
+	uint64_t _calibrate()
+	{
+		enum { DURATION_MS = 100 };
+
+		/* align start to a timer period */
+		_timer.msleep(1);
+
+		Trace::Timestamp const start = Trace::timestamp();
+		_timer.msleep(DURATION_MS);
+		Trace::Timestamp const end = Trace::timestamp();
+
+		uint64_t const ticks_per_ms = (end - start)/DURATION_MS;
+
+		log("timestamp calibration: ", ticks_per_ms, " ticks per ms");
+		return ticks_per_ms;
+	}
+
+	void _sample(char const *brief, auto const &fn)
+	{
+		_samples.reset();
+
+		/* warm up caches and lazily-created resources */
+		for (unsigned i = 0; i < 100; i++)
+			fn();
+
+		for (unsigned i = 0; i < _num_samples; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			fn();
+			_samples.add(Trace::timestamp() - start);
+		}
+
+		_samples.report(brief, _ticks_per_ms);
+	}
+
+	void _measure_rpc()
+	{
+		Payload_8  const payload_8  { };
+		Payload_64 const payload_64 { };
+
+		_sample("RPC 0 words",  [&] { _bench.nop(); });
+		_sample("RPC 8 words",  [&] { _bench.payload_8(payload_8); });
+		_sample("RPC 64 words", [&] { _bench.payload_64(payload_64); });
+		_sample("RPC cap transfer", [&] { _bench.cap_transfer(_bench_cap); });
+	}
+
+	/*
+	 * Signal handler executed by the server entrypoint
+	 */
+	struct Signal_receiver_state
+	{
+		Blockade         handled { };
+		Trace::Timestamp handled_at = 0;
+	};
+
+	struct Signal_bench
+	{
+		Signal_receiver_state &_state;
+
+		Signal_handler<Signal_bench> _handler;
+
+		void _handle()
+		{
+			_state.handled_at = Trace::timestamp();
+			_state.handled.wakeup();
+		}
+
+		Signal_bench(Entrypoint &ep, Signal_receiver_state &state)
+		:
+			_state(state), _handler(ep, *this, &Signal_bench::_handle)
+		{ }
+	};
+
+	void _measure_signal()
+	{
+		Signal_receiver_state state { };
+
+		Signal_bench signal_bench { _server_ep, state };
+
+		Signal_transmitter transmitter { signal_bench._handler };
+
+		/* submit to handler invocation */
+		_samples.reset();
+		for (unsigned i = 0; i < _num_samples; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			transmitter.submit();
+			state.handled.block();
+			_samples.add(state.handled_at - start);
+		}
+		_samples.report("signal submit->handler", _ticks_per_ms);
+
+		/*
+		 * Submit to wakeup of the submitting thread, which includes the
+		 * wakeup of the blocked server entrypoint
+		 */
+		_sample("entrypoint wakeup round trip", [&] {
+			transmitter.submit();
+			state.handled.block();
+		});
+	}
+
+	void _measure_attach()
+	{
+		Ram_dataspace_capability const ds = _env.ram().alloc(4096);
+
+		Region_map::Attr attr { };
+		attr.writeable = true;
+
+		auto attach = [&] () -> addr_t {
+			return _env.rm().attach(ds, attr).convert<addr_t>(
+				[&] (Region_map::Range range) { return range.start; },
+				[&] (Region_map::Attach_error) {
+					error("failed to attach dataspace");
+					return 0UL; });
+		};
+
+		_sample("attach+detach", [&] { _env.rm().detach(attach()); });
+
+		/* attach only, measured separately from the detach */
+		_samples.reset();
+		for (unsigned i = 0; i < _num_samples; i++) {
+			Trace::Timestamp const start = Trace::timestamp();
+			addr_t const at = attach();
+			_samples.add(Trace::timestamp() - start);
+			_env.rm().detach(at);
+		}
+		_samples.report("attach", _ticks_per_ms);
+
+		_env.ram().free(ds);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- IPC benchmark ---");
+
+		_measure_rpc();
+		_measure_signal();
+		_measure_attach();
+
+		_server_ep.dissolve(_bench_component);
+
+		log("--- IPC benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
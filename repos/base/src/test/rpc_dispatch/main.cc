@@ -0,0 +1,134 @@
+/*
+ * \brief  Benchmark of the RPC dispatch latency depending on the number of
+ *         RPC objects managed by the server entrypoint
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/rpc_server.h>
+#include <base/rpc_client.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Object;
+	struct Object_component;
+	struct Object_client;
+	struct Main;
+}
+
+
+struct Test::Object : Interface
+{
+	virtual void nop() = 0;
+
+	GENODE_RPC(Rpc_nop, void, nop);
+	GENODE_RPC_INTERFACE(Rpc_nop);
+};
+
+
+struct Test::Object_component : Rpc_object<Object, Object_component>
+{
+	void nop() override { }
+};
+
+
+struct Test::Object_client : Rpc_client<Object>
+{
+	Object_client(Capability<Object> cap) : Rpc_client<Object>(cap) { }
+
+	void nop() override { call<Rpc_nop>(); }
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _calls =
+		_config.xml().attribute_value("calls", 100000u);
+
+	enum { STACK_SIZE = 4*1024*sizeof(long) };
+
+	Entrypoint _server_ep { _env, STACK_SIZE, "server_ep", Affinity::Location() };
+
+	struct Managed_object : Object_component
+	{
+		Entrypoint &_ep;
+
+		Capability<Object> const cap = _ep.manage(*this);
+
+		Managed_object(Entrypoint &ep) : _ep(ep) { }
+
+		~Managed_object() { _ep.dissolve(*this); }
+	};
+
+	/**
+	 * Measure RPC round trips to 'num_objects' objects called round robin
+	 */
+	void _measure(unsigned num_objects, unsigned num_targets)
+	{
+		Managed_object **objects = (Managed_object **)
+			_heap.alloc(sizeof(Managed_object *)*num_objects);
+
+		for (unsigned i = 0; i < num_objects; i++)
+			objects[i] = new (_heap) Managed_object(_server_ep);
+
+		/* call a subset of the objects spread over the pool */
+		unsigned const stride = max(1u, num_objects / num_targets);
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _calls; i++)
+			Object_client((objects[(i*stride) % num_objects])->cap).nop();
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log("objects: ", num_objects, " targets: ", min(num_objects, num_targets),
+		    " calls: ", _calls, " duration: ", duration_us/1000, " ms, ",
+		    (duration_us*1000)/_calls, " ns per RPC");
+
+		for (unsigned i = 0; i < num_objects; i++)
+			destroy(_heap, objects[i]);
+
+		_heap.free(objects, sizeof(Managed_object *)*num_objects);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC dispatch benchmark ---");
+
+		unsigned const max_objects =
+			_config.xml().attribute_value("max_objects", 1024u);
+
+		for (unsigned n = 1; n <= max_objects; n *= 4) {
+			_measure(n, 1);
+			_measure(n, 16);
+			_measure(n, n);
+		}
+
+		log("--- RPC dispatch benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-rpc_dispatch
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,136 @@
+/*
+ * \brief  Benchmark of scheduling and discarding many timeouts
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The timeouts are scheduled at a timeout scheduler driven by a local time
+ * source, which is advanced by the benchmark. So, only the costs of the
+ * timeout bookkeeping are measured, independent from the timer service.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+
+using namespace Genode;
+
+
+struct Manual_time_source : Time_source
+{
+	uint64_t         now_us  { 0 };
+	Timeout_handler *handler { nullptr };
+
+	Duration curr_time() override { return Duration(Microseconds(now_us)); }
+
+	Microseconds max_timeout() const override { return Microseconds(~(uint64_t)0); }
+
+	void set_timeout(Microseconds, Timeout_handler &h) override { handler = &h; }
+
+	void advance_to(uint64_t us)
+	{
+		now_us = us;
+		if (handler)
+			handler->handle_timeout(curr_time());
+	}
+};
+
+
+struct Counting_handler : Timeout_handler
+{
+	unsigned long count { 0 };
+
+	void handle_timeout(Duration) override { count++; }
+};
+
+
+struct Main
+{
+	enum { NUM_TIMEOUTS = 100'000, MAX_DURATION_US = 10'000'000, STEP_US = 1000 };
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Env &_env;
+
+	Timer::Connection  _timer { _env };
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Manual_time_source _time_source { };
+	Counting_handler   _handler { };
+
+	Timeout_scheduler _scheduler { _time_source, Microseconds(1) };
+
+	Constructible<Timeout> * const _timeouts {
+		new (_heap) Constructible<Timeout>[NUM_TIMEOUTS] };
+
+	uint64_t _random { 0x2545f4914f6cdd1dULL };
+
+	uint64_t _random_duration_us()
+	{
+		_random ^= _random << 13;
+		_random ^= _random >> 7;
+		_random ^= _random << 17;
+		return 1 + _random % MAX_DURATION_US;
+	}
+
+	void _measure(char const *what, auto const &fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		fn();
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log(what, " ", unsigned(NUM_TIMEOUTS), " timeouts: ", duration_us, " us (",
+		    duration_us*1000/NUM_TIMEOUTS, " ns per timeout)");
+	}
+
+	void _schedule_all()
+	{
+		for (unsigned i = 0; i < NUM_TIMEOUTS; i++)
+			_timeouts[i]->schedule_one_shot(Microseconds(_random_duration_us()),
+			                                _handler);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		for (unsigned i = 0; i < NUM_TIMEOUTS; i++)
+			_timeouts[i].construct(_scheduler);
+
+		_measure("schedule", [&] { _schedule_all(); });
+
+		/* discard in an order unrelated to the deadlines */
+		_measure("discard", [&] {
+			for (unsigned i = 0; i < NUM_TIMEOUTS; i += 2)
+				_timeouts[i]->discard();
+			for (unsigned i = 1; i < NUM_TIMEOUTS; i += 2)
+				_timeouts[i]->discard(); });
+
+		_schedule_all();
+
+		_measure("trigger", [&] {
+			for (uint64_t t = STEP_US; t <= MAX_DURATION_US + STEP_US; t += STEP_US)
+				_time_source.advance_to(_time_source.now_us + STEP_US); });
+
+		if (_handler.count != NUM_TIMEOUTS) {
+			error("triggered ", _handler.count, " of ", unsigned(NUM_TIMEOUTS), " timeouts");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- timeout benchmark finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
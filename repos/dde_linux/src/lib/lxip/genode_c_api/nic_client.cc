@@ -16,10 +16,13 @@
 #include <base/session_label.h>
 #include <nic_session/connection.h>
 #include <nic/packet_allocator.h>
+#include <net/offload.h>
 #include <genode_c_api/nic_client.h>
 
 using namespace Genode;
 
+static_assert(sizeof(genode_nic_client_offload) == sizeof(Net::Offload_header));
+
 struct Statics
 {
 	Env                                    *env_ptr;
@@ -54,7 +57,12 @@ struct genode_nic_client : private Noncopyable, private Interface
 
 		Nic::Connection _connection { _env, &_packet_alloc,
 		                              BUF_SIZE, BUF_SIZE,
-		                              _session_label.string() };
+		                              _session_label.string(), true };
+
+		bool const _offload = _connection.offload();
+
+		size_t _header_size() const {
+			return _offload ? sizeof(Net::Offload_header) : 0; }
 
 	public:
 
@@ -64,6 +72,8 @@ struct genode_nic_client : private Noncopyable, private Interface
 			_env(env), _alloc(alloc),
 			_session_label(session_label)
 		{
+			_packet_alloc.enable_offload(_offload);
+
 			_connection.rx_channel()->sigh_ready_to_ack   (sigh);
 			_connection.rx_channel()->sigh_packet_avail   (sigh);
 			_connection.tx_channel()->sigh_ack_avail      (sigh);
@@ -77,7 +87,8 @@ struct genode_nic_client : private Noncopyable, private Interface
 		}
 
 		template <typename FN>
-		bool tx_one_packet(FN const &fn)
+		bool tx_one_packet(size_t size, genode_nic_client_offload const *offload,
+		                   FN const &fn)
 		{
 			bool progress = false;
 
@@ -102,17 +113,27 @@ struct genode_nic_client : private Noncopyable, private Interface
 			using Packet_descriptor = Nic::Packet_descriptor;
 
 			Packet_descriptor packet { };
-			size_t const max_bytes = Nic::Packet_allocator::OFFSET_PACKET_SIZE;
+			size_t const max_bytes   = _offload ? size
+			                         : min(size, (size_t)Nic::Packet_allocator::OFFSET_PACKET_SIZE);
+			size_t const header_size = _header_size();
 
-
-			tx_source.alloc_packet_attempt(max_bytes).with_result(
+			tx_source.alloc_packet_attempt(header_size + max_bytes).with_result(
 				[&] (Packet_descriptor packet)
 				{
-					char * const dst_ptr = tx_source.packet_content(packet);
+					char * const pkt_ptr = tx_source.packet_content(packet);
+
+					if (_offload) {
+						Net::Offload_header &header = *(Net::Offload_header *)pkt_ptr;
+						header = { };
+						if (offload)
+							memcpy(&header, offload, sizeof(header));
+					}
+
+					char * const dst_ptr = pkt_ptr + header_size;
 					size_t const payload_bytes = min(max_bytes, fn(dst_ptr, max_bytes));
 
 					/* imprint payload size into packet descriptor */
-					packet = Packet_descriptor(packet.offset(), payload_bytes);
+					packet = Packet_descriptor(packet.offset(), header_size + payload_bytes);
 
 					tx_source.try_submit_packet(packet);
 					progress = true;
@@ -142,14 +163,21 @@ struct genode_nic_client : private Noncopyable, private Interface
 
 				Packet_descriptor const packet = rx_sink.peek_packet();
 
+				size_t const header_size = _header_size();
+
 				bool const packet_valid = rx_sink.packet_valid(packet)
-				                       && (packet.offset() >= 0);
+				                       && (packet.offset() >= 0)
+				                       && (packet.size() > header_size);
 
 				char const *content = rx_sink.packet_content(packet);
 
+				genode_nic_client_offload const *offload = _offload
+					? (genode_nic_client_offload const *)content : nullptr;
+
 				genode_nic_client_rx_result_t const
 					response = packet_valid
-					         ? fn(content, packet.size())
+					         ? fn(offload, content + header_size,
+					              packet.size() - header_size)
 					         : GENODE_NIC_CLIENT_RX_REJECTED;
 
 				bool progress = false;
@@ -179,6 +207,8 @@ struct genode_nic_client : private Noncopyable, private Interface
 		}
 
 		Nic::Mac_address mac_address() { return _connection.mac_address(); }
+
+		bool offload() const { return _offload; }
 };
 
 
@@ -210,11 +240,19 @@ genode_mac_address genode_nic_client_mac_address(genode_nic_client *nic_client_p
 }
 
 
+bool genode_nic_client_offload_enabled(genode_nic_client *nic_client_ptr)
+{
+	return nic_client_ptr->offload();
+}
+
+
 bool genode_nic_client_tx_packet(genode_nic_client *nic_client_ptr,
+                                 unsigned long size,
+                                 genode_nic_client_offload const *offload,
                                  genode_nic_client_tx_packet_content_t tx_packet_content_cb,
                                  genode_nic_client_tx_packet_context *ctx_ptr)
 {
-	return nic_client_ptr->tx_one_packet([&] (char *dst, size_t len) {
+	return nic_client_ptr->tx_one_packet(size, offload, [&] (char *dst, size_t len) {
 		return tx_packet_content_cb(ctx_ptr, dst, len); });
 }
 
@@ -223,8 +261,9 @@ bool genode_nic_client_rx(struct genode_nic_client *nic_client_ptr,
                           genode_nic_client_rx_one_packet_t rx_one_packet_cb,
                           struct genode_nic_client_rx_context *ctx_ptr)
 {
-	return nic_client_ptr->for_each_rx_packet([&] (char const *ptr, size_t len) {
-		return rx_one_packet_cb(ctx_ptr, ptr, len); });
+	return nic_client_ptr->for_each_rx_packet([&] (genode_nic_client_offload const *offload,
+	                                              char const *ptr, size_t len) {
+		return rx_one_packet_cb(ctx_ptr, offload, ptr, len); });
 }
 
 
@@ -58,6 +58,37 @@ void   genode_nic_client_destroy(struct genode_nic_client *);
  */
 struct genode_mac_address genode_nic_client_mac_address(struct genode_nic_client *);
 
+/**
+ * Return true if the server granted checksum and segmentation offloading
+ */
+bool genode_nic_client_offload_enabled(struct genode_nic_client *);
+
+
+/**********************
+ ** Offload metadata **
+ **********************/
+
+enum { GENODE_NIC_CLIENT_OFFLOAD_NEEDS_CSUM = 1 };
+
+enum { GENODE_NIC_CLIENT_OFFLOAD_GSO_NONE  = 0,
+       GENODE_NIC_CLIENT_OFFLOAD_GSO_TCPV4 = 1,
+       GENODE_NIC_CLIENT_OFFLOAD_GSO_ECN   = 0x80 };
+
+/**
+ * Metadata of packets exchanged with offloading
+ *
+ * The layout corresponds to 'Net::Offload_header'.
+ */
+struct genode_nic_client_offload
+{
+	unsigned char  flags;
+	unsigned char  gso_type;
+	unsigned short hdr_len;
+	unsigned short gso_size;
+	unsigned short csum_start;
+	unsigned short csum_offset;
+};
+
 
 /**********************************************
  ** Transmit packets towards the NIC session **
@@ -74,9 +105,15 @@ typedef unsigned long (*genode_nic_client_tx_packet_content_t)
 /**
  * Process packet transmission
  *
+ * \param size     size of the frame provided by the content callback
+ * \param offload  offload metadata of the frame, or NULL for a complete
+ *                 frame, ignored if offloading is not used
+ *
  * \return true if progress was made
  */
 bool genode_nic_client_tx_packet(struct genode_nic_client *,
+                                 unsigned long size,
+                                 struct genode_nic_client_offload const *offload,
                                  genode_nic_client_tx_packet_content_t,
                                  struct genode_nic_client_tx_packet_context *);
 
@@ -91,8 +128,15 @@ typedef enum { GENODE_NIC_CLIENT_RX_REJECTED,
                GENODE_NIC_CLIENT_RX_ACCEPTED,
                GENODE_NIC_CLIENT_RX_RETRY } genode_nic_client_rx_result_t;
 
+/**
+ * Callback called for each received frame
+ *
+ * The 'offload' argument is NULL if offloading is not used.
+ */
 typedef genode_nic_client_rx_result_t (*genode_nic_client_rx_one_packet_t)
-	(struct genode_nic_client_rx_context *, char const *ptr, unsigned long len);
+	(struct genode_nic_client_rx_context *,
+	 struct genode_nic_client_offload const *offload,
+	 char const *ptr, unsigned long len);
 
 /**
  * Process packet reception
@@ -47,7 +47,11 @@ static unsigned long nic_tx_packet_content(struct genode_nic_client_tx_packet_co
 		return 0;
 	}
 
-	skb_copy_from_linear_data(skb, dst, skb->len);
+	/* with scatter-gather enabled, the skb may not be linear */
+	if (skb_copy_bits(skb, 0, dst, skb->len)) {
+		memset(dst, 0, dst_len);
+		return 0;
+	}
 
 	/* clear unused part of the destination buffer */
 	memset(dst + skb->len, 0, dst_len - skb->len);
@@ -56,6 +60,31 @@ static unsigned long nic_tx_packet_content(struct genode_nic_client_tx_packet_co
 }
 
 
+/*
+ * Translate checksum and segmentation state of the skb into offload metadata
+ */
+static void nic_tx_offload(struct sk_buff *skb,
+                           struct genode_nic_client_offload *offload)
+{
+	memset(offload, 0, sizeof(*offload));
+
+	if (skb->ip_summed == CHECKSUM_PARTIAL) {
+		offload->flags       = GENODE_NIC_CLIENT_OFFLOAD_NEEDS_CSUM;
+		offload->csum_start  = skb_checksum_start_offset(skb);
+		offload->csum_offset = skb->csum_offset;
+	}
+
+	if (skb_is_gso(skb)) {
+		offload->hdr_len  = skb_headlen(skb);
+		offload->gso_size = skb_shinfo(skb)->gso_size;
+		offload->gso_type = GENODE_NIC_CLIENT_OFFLOAD_GSO_TCPV4;
+
+		if (skb_shinfo(skb)->gso_type & SKB_GSO_TCP_ECN)
+			offload->gso_type |= GENODE_NIC_CLIENT_OFFLOAD_GSO_ECN;
+	}
+}
+
+
 static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 {
 	bool progress = false;
@@ -63,10 +92,14 @@ static int driver_net_xmit(struct sk_buff *skb, struct net_device *dev)
 
 	struct genode_nic_client *nic_client = dev_nic_client(dev);
 	struct genode_nic_client_tx_packet_context ctx = { .skb = skb };
+	struct genode_nic_client_offload offload;
 
 	if (!nic_client) return NETDEV_TX_BUSY;
 
-	progress = genode_nic_client_tx_packet(nic_client, nic_tx_packet_content, &ctx);
+	nic_tx_offload(skb, &offload);
+
+	progress = genode_nic_client_tx_packet(nic_client, skb->len, &offload,
+	                                       nic_tx_packet_content, &ctx);
 	/* transmit to nic-session */
 	if (!progress) {
 		/* tx queue is  full, could not enqueue packet */
@@ -109,6 +142,7 @@ struct task_struct *lx_nic_client_rx_task(void)
 
 
 static genode_nic_client_rx_result_t nic_rx_one_packet(struct genode_nic_client_rx_context *ctx,
+                                                       struct genode_nic_client_offload const *offload,
                                                        char const *ptr, unsigned long len)
 {
 	enum {
@@ -128,6 +162,29 @@ static genode_nic_client_rx_result_t nic_rx_one_packet(struct genode_nic_client_
 	skb->protocol  = eth_type_trans(skb, ctx->dev);
 	skb->ip_summed = CHECKSUM_NONE;
 
+	/*
+	 * Frames with partial checksums stem from local peers and are thereby
+	 * known to be intact. The TCP layer accepts super-frames as they are.
+	 */
+	if (offload && (offload->flags & GENODE_NIC_CLIENT_OFFLOAD_NEEDS_CSUM)) {
+
+		/* 'csum_start' is relative to the Ethernet header pulled above */
+		if (!skb_partial_csum_set(skb, offload->csum_start - ETH_HLEN,
+		                          offload->csum_offset)) {
+			kfree_skb(skb);
+			stats->rx_dropped++;
+			return GENODE_NIC_CLIENT_RX_REJECTED;
+		}
+
+		if (offload->gso_type != GENODE_NIC_CLIENT_OFFLOAD_GSO_NONE) {
+			skb_shinfo(skb)->gso_size = offload->gso_size;
+			skb_shinfo(skb)->gso_type = SKB_GSO_TCPV4 | SKB_GSO_DODGY;
+			if (offload->gso_type & GENODE_NIC_CLIENT_OFFLOAD_GSO_ECN)
+				skb_shinfo(skb)->gso_type |= SKB_GSO_TCP_ECN;
+			skb_shinfo(skb)->gso_segs = 0;
+		}
+	}
+
 	netif_receive_skb(skb);
 
 	stats->rx_packets++;
@@ -186,6 +243,12 @@ static int __init virtio_net_driver_init(void)
 	mac = genode_nic_client_mac_address(dev_nic_client(dev));
 	dev_addr_set(dev, mac.addr);
 
+	/* let the stack pass partial checksums and TCP super-frames */
+	if (genode_nic_client_offload_enabled(dev_nic_client(dev))) {
+		dev->features    |= NETIF_F_SG | NETIF_F_HW_CSUM | NETIF_F_TSO;
+		dev->hw_features |= dev->features;
+	}
+
 	if ((err = register_netdev(dev))) {
 		printk("Could not register net device driver %d\n", err);
 		goto out_nic;
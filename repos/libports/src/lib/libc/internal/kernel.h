@@ -404,6 +404,8 @@ struct Libc::Kernel final : Vfs::Read_ready_response_handler,
 
 		void _init_file_descriptors();
 
+		void _store_relocation_cache();
+
 		void _clone_state_from_parent();
 
 	public:
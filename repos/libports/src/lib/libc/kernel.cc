@@ -13,6 +13,9 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+/* Genode includes */
+#include <base/shared_object.h>
+
 /* libc-internal includes */
 #include <internal/kernel.h>
 #include <internal/file_operations.h>
@@ -333,6 +336,36 @@ void Libc::Kernel::_handle_terminal_resize()
 }
 
 
+/**
+ * Store symbol-lookup results of the dynamic linker at the configured path
+ *
+ * The stored file is meant to be provided as "ld_reloc_cache" ROM module
+ * on the next start of the component.
+ */
+void Libc::Kernel::_store_relocation_cache()
+{
+	using Path = Directory::Path;
+
+	Path const path = _libc_env.libc_config().attribute_value("reloc_cache", Path());
+	if (!path.length() || _cloned)
+		return;
+
+	Dynamic_linker::with_relocation_cache(_env, [&] (Const_byte_range_ptr const &content) {
+		bool stored = false;
+		_vfs.with_root_dir([&] (Directory &root_dir) {
+			try {
+				stored = (New_file(root_dir, path).append(content) == New_file::Append_result::OK);
+				if (!stored)
+					warning("failed to store relocation cache at ", path);
+			}
+			catch (New_file::Create_failed) {
+				warning("failed to create relocation cache at ", path); }
+		});
+		return stored;
+	});
+}
+
+
 void Libc::Kernel::_handle_user_interrupt()
 {
 	_signal.charge(SIGINT);
@@ -523,6 +556,8 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 
 	_init_file_descriptors();
 
+	_store_relocation_cache();
+
 	_kernel_ptr = this;
 
 	/*
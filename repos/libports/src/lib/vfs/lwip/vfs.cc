@@ -42,7 +42,7 @@ extern "C" {
 	using Read_result  = Vfs::File_io_service::Read_result;
 	using Write_result = Vfs::File_io_service::Write_result;
 	using Sync_result  = Vfs::File_io_service::Sync_result;
-	using Socket_name  = Genode::String<8>;
+	using Socket_name  = Genode::String<9>; /* 32-bit hex number + \0 */
 
 	char const *get_port(char const *s)
 	{
@@ -72,14 +72,12 @@ extern "C" {
 	class Udp_socket_dir;
 	class Tcp_socket_dir;
 
-	#define Udp_socket_dir_list Genode::List<Udp_socket_dir>
-	#define Tcp_socket_dir_list Genode::List<Tcp_socket_dir>
+	template <typename> class Socket_table;
 
 	struct Protocol_dir;
 	template <typename, typename> class Protocol_dir_impl;
 
 	enum {
-		MAX_SOCKETS         = 128,      /* 3 */
 		MAX_SOCKET_NAME_LEN = 3 + 1,    /* + \0 */
 		MAX_FD_STR_LEN      = 3 + 1 +1, /* + \n + \0 */
 		MAX_DATA_LEN        = 32,       /* 255.255.255.255:65536 + something */
@@ -373,6 +371,8 @@ struct Lwip::Socket_dir : Lwip::Directory
 
 		Socket_name const &name() const { return _name; }
 
+		unsigned num() const { return _num; }
+
 		bool operator == (unsigned other) const {
 			return _num == other; }
 
@@ -533,6 +533,114 @@ struct Lwip::Protocol_dir : Lwip::Directory
 };
 
 
+/**
+ * Table of socket directories indexed by socket number
+ *
+ * Socket numbers are random to hide the socket count. The table is indexed
+ * by the lower bits of the number and doubles its size whenever it becomes
+ * half occupied. As the numbers of present sockets differ in the lower bits
+ * already, they remain distinct after growing.
+ */
+template <typename SOCKET_DIR>
+class Lwip::Socket_table
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Socket_table(Socket_table const &);
+		Socket_table &operator = (Socket_table const &);
+
+		static constexpr size_t INITIAL_CAPACITY = 64;
+
+		Genode::Allocator &_alloc;
+
+		size_t       _capacity = 0; /* power of two */
+		size_t       _count    = 0;
+		SOCKET_DIR **_slots    = nullptr;
+
+		size_t _index(unsigned num) const { return num & (_capacity - 1); }
+
+		void _grow()
+		{
+			size_t      const old_capacity = _capacity;
+			SOCKET_DIR ** const old_slots  = _slots;
+
+			_capacity = old_capacity ? 2*old_capacity : INITIAL_CAPACITY;
+			_slots    = (SOCKET_DIR **)_alloc.alloc(_capacity*sizeof(SOCKET_DIR *));
+
+			for (size_t i = 0; i < _capacity; i++)
+				_slots[i] = nullptr;
+
+			for (size_t i = 0; i < old_capacity; i++)
+				if (old_slots[i])
+					_slots[_index(old_slots[i]->num())] = old_slots[i];
+
+			if (old_slots)
+				_alloc.free(old_slots, old_capacity*sizeof(SOCKET_DIR *));
+		}
+
+	public:
+
+		Socket_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+		~Socket_table()
+		{
+			if (_slots)
+				_alloc.free(_slots, _capacity*sizeof(SOCKET_DIR *));
+		}
+
+		SOCKET_DIR *lookup(unsigned num) const
+		{
+			if (!_capacity)
+				return nullptr;
+
+			SOCKET_DIR * const dir = _slots[_index(num)];
+			return (dir && *dir == num) ? dir : nullptr;
+		}
+
+		/**
+		 * Return socket number not colliding with any present socket
+		 *
+		 * \param random_fn  generator of candidate numbers
+		 */
+		template <typename FN>
+		unsigned unused_num(FN const &random_fn)
+		{
+			if (2*(_count + 1) > _capacity)
+				_grow();
+
+			for (;;) {
+				unsigned const num = random_fn();
+				if (!_slots[_index(num)])
+					return num;
+			}
+		}
+
+		void insert(SOCKET_DIR &dir)
+		{
+			if (2*(_count + 1) > _capacity)
+				_grow();
+
+			while (_slots[_index(dir.num())])
+				_grow();
+
+			_slots[_index(dir.num())] = &dir;
+			_count++;
+		}
+
+		void remove(SOCKET_DIR &dir)
+		{
+			if (lookup(dir.num()) != &dir)
+				return;
+
+			_slots[_index(dir.num())] = nullptr;
+			_count--;
+		}
+};
+
+
 template <typename SOCKET_DIR, typename PCB>
 class Lwip::Protocol_dir_impl final : public Protocol_dir
 {
@@ -542,13 +650,10 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		Genode::Entrypoint &_ep;
 		Vfs::Env::User     &_vfs_user;
 
-		Genode::List<SOCKET_DIR> _socket_dirs { };
+		Socket_table<SOCKET_DIR> _socket_dirs { _alloc };
 
 	public:
 
-		friend class Genode::List<SOCKET_DIR>;
-		friend class Genode::List<SOCKET_DIR>::Element;
-
 		friend class Tcp_socket_dir;
 		friend class Udp_socket_dir;
 
@@ -559,16 +664,18 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 		{
 			if (*name == '/') ++name;
 
+			/* the name is the hexadecimal socket number, see 'Socket_dir' */
+			unsigned long num = 0;
+			size_t const len = Genode::ascii_to_unsigned(name, num, 16);
+
 			/* make sure it is only a name */
-			for (char const *p = name; *p; ++p)
-				if (*p == '/')
-					return nullptr;
+			if (!len || name[len] || num > ~0U)
+				return nullptr;
 
-			for (SOCKET_DIR *sd = _socket_dirs.first(); sd; sd = sd->next())
-				if (*sd == name)
-					return sd;
+			SOCKET_DIR * const sd = _socket_dirs.lookup((unsigned)num);
 
-			return nullptr;
+			/* reject non-canonical names, e.g., with leading zeros */
+			return (sd && *sd == name) ? sd : nullptr;
 		}
 
 		bool leaf_path(char const *path) override
@@ -661,29 +768,20 @@ class Lwip::Protocol_dir_impl final : public Protocol_dir
 			 * use the equidistribution RNG to hide the socket count,
 			 * see src/lib/lwip/platform/rand.cc
 			 */
-			unsigned id = LWIP_RAND();
-
-			/* check for collisions */
-			for (SOCKET_DIR *dir = _socket_dirs.first(); dir;) {
-				if (*dir == id) {
-					id = LWIP_RAND();
-					dir = _socket_dirs.first();
-				} else {
-					dir = dir->next();
-				}
-			}
+			unsigned const id = _socket_dirs.unused_num([] () {
+				return (unsigned)LWIP_RAND(); });
 
 			SOCKET_DIR *new_socket = new (alloc)
 				SOCKET_DIR(id, *this, alloc, _ep, _vfs_user, pcb);
-			_socket_dirs.insert(new_socket);
+			_socket_dirs.insert(*new_socket);
 			return *new_socket;
 		}
 
 		void adopt_socket(Socket_dir &socket) override {
-			_socket_dirs.insert(static_cast<SOCKET_DIR*>(&socket)); }
+			_socket_dirs.insert(static_cast<SOCKET_DIR&>(socket)); }
 
 		void release(SOCKET_DIR *socket) {
-			_socket_dirs.remove(socket); }
+			_socket_dirs.remove(*socket); }
 
 		Open_result open(Vfs::File_system &fs,
 		                 char const  *path,
@@ -744,9 +842,7 @@ namespace Lwip {
  ** UDP **
  *********/
 
-class Lwip::Udp_socket_dir final :
-	public Socket_dir,
-	private Udp_socket_dir_list::Element
+class Lwip::Udp_socket_dir final : public Socket_dir
 {
 	private:
 
@@ -823,10 +919,6 @@ class Lwip::Udp_socket_dir final :
 
 	public:
 
-		friend class Udp_socket_dir_list;
-		friend class Udp_socket_dir_list::Element;
-		using Udp_socket_dir_list::Element::next;
-
 		Udp_socket_dir(unsigned num, Udp_proto_dir &proto_dir,
 		               Genode::Allocator &alloc,
 		               Genode::Entrypoint &,
@@ -1079,9 +1171,7 @@ class Lwip::Udp_socket_dir final :
  ** TCP **
  *********/
 
-class Lwip::Tcp_socket_dir final :
-	public  Socket_dir,
-	private Tcp_socket_dir_list::Element
+class Lwip::Tcp_socket_dir final : public Socket_dir
 {
 	public:
 
@@ -1125,10 +1215,6 @@ class Lwip::Tcp_socket_dir final :
 
 	public:
 
-		friend class Tcp_socket_dir_list;
-		friend class Tcp_socket_dir_list::Element;
-		using Tcp_socket_dir_list::Element::next;
-
 		State state;
 
 		Tcp_socket_dir(unsigned num, Tcp_proto_dir &proto_dir,
@@ -0,0 +1,92 @@
+/*
+ * \brief  Benchmark of the symbol resolution of the dynamic linker
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * Each configured shared object is repeatedly loaded with 'BIND_NOW' and
+ * unloaded. Thereby, the dynamic linker resolves all relocations of the
+ * object, which involves symbol lookups in all objects loaded before. In
+ * addition, the RAM consumed by a loaded object is reported, which depends
+ * on the 'ld_cow' configuration of the dynamic linker.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/attached_rom_dataspace.h>
+#include <base/heap.h>
+#include <base/shared_object.h>
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+	using namespace Genode;
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Libc::Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _iterations =
+		max(_config.xml().attribute_value("iterations", 20U), 1U);
+
+	void _bench(char const *name)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _iterations; i++)
+			Shared_object object(_env, _heap, name, Shared_object::BIND_NOW,
+			                     Shared_object::DONT_KEEP);
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+
+		log(name, ": ", _iterations, " loads in ", duration_us, " us, ",
+		    duration_us/_iterations, " us per load");
+
+		/* RAM consumed while the object is loaded */
+		size_t const used_ram = _env.pd().used_ram().value;
+		{
+			Shared_object object(_env, _heap, name, Shared_object::BIND_NOW,
+			                     Shared_object::DONT_KEEP);
+
+			log(name, ": ", (_env.pd().used_ram().value - used_ram)/1024,
+			    " KiB RAM used while loaded");
+		}
+	}
+
+	Main(Libc::Env &env) : _env(env)
+	{
+		log("--- dynamic-linker benchmark ---");
+
+		Libc::with_libc([&] () {
+			_config.xml().for_each_sub_node("library", [&] (Xml_node const &node) {
+
+				using Name = String<64>;
+				Name const name = node.attribute_value("name", Name());
+
+				try { _bench(name.string()); }
+				catch (Shared_object::Invalid_rom_module) {
+					error("could not load ", name); }
+			});
+		});
+
+		log("--- finished dynamic-linker benchmark ---");
+
+		_env.parent().exit(0);
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Test::Main main(env); }
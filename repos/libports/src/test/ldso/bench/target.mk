@@ -0,0 +1,3 @@
+TARGET = test-ldso_bench
+SRC_CC = main.cc
+LIBS   = base libc
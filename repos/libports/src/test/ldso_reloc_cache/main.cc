@@ -0,0 +1,25 @@
+/*
+ * \brief  Program started repeatedly by the relocation-cache test
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The symbol lookups of interest are performed by the dynamic linker before
+ * 'main' is called. The libc stores the relocation cache at startup.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <stdio.h>
+
+
+int main(int, char **)
+{
+	printf("--- relocation-cache test program finished ---\n");
+	return 0;
+}
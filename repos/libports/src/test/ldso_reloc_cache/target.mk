@@ -0,0 +1,3 @@
+TARGET = test-ldso_reloc_cache
+SRC_CC = main.cc
+LIBS   = posix
@@ -23,17 +23,19 @@
 
 
 static char buf[16384];
+static char cmp[16384];
 static char str[] = "deadbeef";
 
-int main(int argc, char *argv[])
+
+static int test(char const *path)
 {
 	int fd;
 	ssize_t n;
 	off_t offset;
 
-	printf("--- start test ---\n");
+	printf("--- test %s ---\n", path);
 
-	fd = open("/dev/blkdev", O_RDWR);
+	fd = open(path, O_RDWR);
 	if (fd == -1) {
 		perror("open");
 		return 1;
@@ -52,6 +54,11 @@ int main(int argc, char *argv[])
 		printf("%c ", buf[i]);
 	printf("\n");
 
+	if (memcmp(buf, str, sizeof (str))) {
+		printf("error read-back mismatch\n");
+		return 1;
+	}
+
 	offset = lseek(fd, 16384, SEEK_SET);
 	n = write(fd, buf, sizeof (buf));
 	if (n != sizeof (buf))
@@ -67,8 +74,40 @@ int main(int argc, char *argv[])
 	if (n != sizeof (buf))
 		printf("error read mismatch: %zd != %zu\n", n, sizeof (buf));
 
+	/* unaligned pattern spanning several blocks, read back after sync */
+	for (size_t i = 0; i < sizeof (cmp); i++)
+		cmp[i] = (char)(i*7 + 1);
+
+	offset = lseek(fd, 65536 + 100, SEEK_SET);
+	n = write(fd, cmp, sizeof (cmp) - 200);
+	if (n != sizeof (cmp) - 200)
+		printf("error write mismatch: %zd != %zu\n", n, sizeof (cmp) - 200);
+
+	if (fsync(fd)) {
+		perror("fsync");
+		return 1;
+	}
+
+	offset = lseek(fd, 65536 + 100, SEEK_SET);
+	n = read(fd, buf, sizeof (cmp) - 200);
+	if (n != sizeof (cmp) - 200 || memcmp(buf, cmp, sizeof (cmp) - 200)) {
+		printf("error read-back mismatch after sync\n");
+		return 1;
+	}
+
 	close(fd);
 
+	return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+	printf("--- start test ---\n");
+
+	if (test("/dev/blkdev") || test("/dev/blkdev_wb"))
+		return 1;
+
 	printf("--- test finished ---\n");
 
 	return 0;
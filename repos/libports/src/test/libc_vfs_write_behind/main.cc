@@ -0,0 +1,140 @@
+/*
+ * \brief  Test of the write-behind coalescing of the VFS fs plugin
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The file system is mounted twice, at '/rw' with write-behind enabled and
+ * at '/direct' without. The latter reveals which data the file-system
+ * server has already received.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* libc includes */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum { CHUNK = 16, NUM_A = 64, NUM_B = 10, SIZE_A = CHUNK*NUM_A, SIZE_B = CHUNK*NUM_B };
+
+
+static void fail(char const *msg)
+{
+	printf("Error: %s\n", msg);
+	exit(-1);
+}
+
+
+static off_t file_size(char const *path)
+{
+	struct stat st { };
+	if (stat(path, &st) != 0)
+		fail("stat failed");
+
+	return st.st_size;
+}
+
+
+static void write_chunks(int fd, char c, unsigned count)
+{
+	char buf[CHUNK];
+	memset(buf, c, sizeof(buf));
+
+	for (unsigned i = 0; i < count; i++)
+		if (write(fd, buf, sizeof(buf)) != (ssize_t)sizeof(buf))
+			fail("write failed");
+}
+
+
+static void check_content(char const *buf, off_t from, off_t to, char c)
+{
+	for (off_t i = from; i < to; i++)
+		if (buf[i] != c) {
+			printf("Error: unexpected content '%c' at %ld, expected '%c'\n",
+			       buf[i], (long)i, c);
+			exit(-1);
+		}
+}
+
+
+int main(int, char **)
+{
+	static char buf[SIZE_A + SIZE_B + 1];
+
+	/* small adjacent writes are coalesced */
+	int const fd = open("/rw/file", O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if (fd < 0)
+		fail("open of /rw/file failed");
+
+	write_chunks(fd, 'a', NUM_A);
+
+	if (file_size("/direct/file") != 0)
+		fail("small writes were not buffered");
+	printf("%d writes of %d bytes buffered\n", NUM_A, CHUNK);
+
+	/* stat accounts for the buffered data */
+	if (file_size("/rw/file") != SIZE_A)
+		fail("stat after write misses buffered data");
+	printf("stat after write reports %d bytes\n", SIZE_A);
+
+	/* reading submits the buffered data */
+	if (pread(fd, buf, SIZE_A, 0) != SIZE_A)
+		fail("read after write failed");
+	check_content(buf, 0, SIZE_A, 'a');
+
+	if (file_size("/direct/file") != SIZE_A)
+		fail("buffered data not submitted before read");
+	printf("read after write observes buffered data\n");
+
+	/* appends are positioned after the buffered data */
+	int const append_fd = open("/rw/file", O_WRONLY | O_APPEND);
+	if (append_fd < 0)
+		fail("open of /rw/file for appending failed");
+
+	write_chunks(append_fd, 'b', NUM_B);
+
+	if (file_size("/rw/file") != SIZE_A + SIZE_B)
+		fail("stat after append misses buffered data");
+	printf("%d appends of %d bytes buffered\n", NUM_B, CHUNK);
+
+	/* closing without sync must not lose buffered data */
+	close(append_fd);
+	close(fd);
+
+	int const direct_fd = open("/direct/file", O_RDONLY);
+	if (direct_fd < 0)
+		fail("open of /direct/file failed");
+
+	if (read(direct_fd, buf, sizeof(buf)) != SIZE_A + SIZE_B)
+		fail("buffered data lost on close");
+
+	check_content(buf, 0, SIZE_A, 'a');
+	check_content(buf, SIZE_A, SIZE_A + SIZE_B, 'b');
+	close(direct_fd);
+	printf("close without sync retains buffered data\n");
+
+	/* buffered data is submitted after 'write_behind_ms' */
+	int const timeout_fd = open("/rw/timeout", O_CREAT | O_WRONLY | O_TRUNC, 0644);
+	if (timeout_fd < 0)
+		fail("open of /rw/timeout failed");
+
+	write_chunks(timeout_fd, 'c', 1);
+	sleep(3);
+
+	if (file_size("/direct/timeout") != CHUNK)
+		fail("buffered data not submitted after timeout");
+	printf("buffered data submitted after timeout\n");
+
+	close(timeout_fd);
+
+	printf("--- write-behind test finished ---\n");
+	return 0;
+}
@@ -0,0 +1,3 @@
+TARGET = test-libc_vfs_write_behind
+SRC_CC = main.cc
+LIBS   = posix
@@ -0,0 +1,230 @@
+/*
+ * \brief  Libc TCP connection-scaling benchmark
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The client opens an increasing number of connections to the echo server
+ * and measures the connection setup time and the rate of small echo round
+ * trips with all connections being open. With a socket table of linear
+ * lookup cost, the round-trip rate drops with the number of connections.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Libc includes */
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+enum {
+	PORT            = 7,
+	MAX_CONNECTIONS = 768,
+	MESSAGE_SIZE    = 64,
+	ROUNDS          = 16,
+};
+
+static unsigned const levels[] = { 16, 64, 256, 768 };
+
+
+static unsigned long long now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec*1000000 + ts.tv_nsec/1000;
+}
+
+
+static int write_all(int sock, char const *buf, size_t size)
+{
+	size_t offset = 0;
+	while (offset < size) {
+		ssize_t res = write(sock, buf + offset, size - offset);
+		if (res < 1)
+			return -1;
+		offset += res;
+	}
+	return 0;
+}
+
+
+static int read_all(int sock, char *buf, size_t size)
+{
+	size_t offset = 0;
+	while (offset < size) {
+		ssize_t res = read(sock, buf + offset, size - offset);
+		if (res < 1)
+			return -1;
+		offset += res;
+	}
+	return 0;
+}
+
+
+static int echo_server(void)
+{
+	static struct pollfd fds[MAX_CONNECTIONS + 1];
+
+	int listen_sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (listen_sock < 0) {
+		perror("`socket` failed");
+		return ~0;
+	}
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = INADDR_ANY;
+	addr.sin_port        = htons(PORT);
+
+	if (bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr))) {
+		perror("`bind` failed");
+		return ~0;
+	}
+
+	if (listen(listen_sock, 64)) {
+		perror("`listen` failed");
+		return ~0;
+	}
+
+	fds[0].fd     = listen_sock;
+	fds[0].events = POLLIN;
+
+	nfds_t nfds = 1;
+
+	for (;;) {
+		if (poll(fds, nfds, -1) < 0) {
+			perror("`poll` failed");
+			return ~0;
+		}
+
+		for (nfds_t i = 1; i < nfds; i++) {
+
+			if (!fds[i].revents)
+				continue;
+
+			char buf[MESSAGE_SIZE*ROUNDS];
+			ssize_t res = read(fds[i].fd, buf, sizeof(buf));
+
+			if (res < 1 || write_all(fds[i].fd, buf, res)) {
+				close(fds[i].fd);
+				fds[i--] = fds[--nfds];
+			}
+		}
+
+		if (fds[0].revents & POLLIN) {
+			int client = accept(listen_sock, NULL, NULL);
+			if (client < 0) {
+				perror("`accept` failed");
+				continue;
+			}
+			if (nfds == MAX_CONNECTIONS + 1) {
+				fprintf(stderr, "too many connections\n");
+				close(client);
+				continue;
+			}
+			fds[nfds].fd      = client;
+			fds[nfds].events  = POLLIN;
+			fds[nfds].revents = 0;
+			nfds++;
+		}
+	}
+}
+
+
+static int echo_client(char const *host)
+{
+	static int socks[MAX_CONNECTIONS];
+
+	/* give the server some time to start listening */
+	sleep(1);
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = inet_addr(host);
+	addr.sin_port        = htons(PORT);
+
+	for (unsigned l = 0; l < sizeof(levels)/sizeof(levels[0]); l++) {
+
+		unsigned const num = levels[l];
+
+		unsigned long long const connect_start = now_us();
+
+		for (unsigned i = 0; i < num; i++) {
+			socks[i] = socket(AF_INET, SOCK_STREAM, 0);
+			if (socks[i] < 0) {
+				perror("`socket` failed");
+				return ~0;
+			}
+			if (connect(socks[i], (struct sockaddr *)&addr, sizeof(addr))) {
+				perror("`connect` failed");
+				return ~0;
+			}
+		}
+
+		unsigned long long const echo_start = now_us();
+
+		for (unsigned r = 0; r < ROUNDS; r++) {
+
+			char msg[MESSAGE_SIZE];
+
+			for (unsigned i = 0; i < num; i++) {
+				memset(msg, (char)(i + r), sizeof(msg));
+				if (write_all(socks[i], msg, sizeof(msg))) {
+					perror("`write` failed");
+					return ~0;
+				}
+			}
+
+			for (unsigned i = 0; i < num; i++) {
+				if (read_all(socks[i], msg, sizeof(msg))) {
+					perror("`read` failed");
+					return ~0;
+				}
+				if (msg[0] != (char)(i + r) || msg[sizeof(msg) - 1] != (char)(i + r)) {
+					fprintf(stderr, "bad echo on connection %u\n", i);
+					return ~0;
+				}
+			}
+		}
+
+		unsigned long long const end = now_us();
+
+		for (unsigned i = 0; i < num; i++)
+			close(socks[i]);
+
+		unsigned long long const connect_us = echo_start - connect_start;
+		unsigned long long const echo_us    = end - echo_start;
+
+		printf("connections: %4u  connect: %6llu us/conn  echo: %8llu round trips/s\n",
+		       num, connect_us/num,
+		       echo_us ? (unsigned long long)num*ROUNDS*1000000/echo_us : 0);
+	}
+
+	printf("benchmark finished\n");
+	return 0;
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc == 1 && strcmp(argv[0], "server") == 0)
+		return echo_server();
+
+	if (argc == 2 && strcmp(argv[0], "client") == 0)
+		return echo_client(argv[1]);
+
+	fprintf(stderr, "usage: server | client <server address>\n");
+	return ~0;
+}
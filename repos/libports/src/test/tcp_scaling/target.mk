@@ -0,0 +1,3 @@
+TARGET  = test-tcp_scaling
+LIBS   += posix libc
+SRC_C  += main.c
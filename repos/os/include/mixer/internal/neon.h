@@ -0,0 +1,87 @@
+/*
+ * \brief  Mixing of float samples using ARM NEON
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__MIXER__INTERNAL__NEON_H_
+#define _INCLUDE__MIXER__INTERNAL__NEON_H_
+
+#include <mixer/internal/slow.h>
+
+/* compiler intrinsics */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wnarrowing"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wfloat-conversion"
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <arm_neon.h>
+#pragma GCC diagnostic pop
+
+
+namespace Mixer::Dsp { struct Neon; }
+
+
+/*
+ * NEON is mandatory on AArch64. The remainder of a sequence not filling a
+ * whole vector is handled by the fallback implementation.
+ */
+struct Mixer::Dsp::Neon
+{
+	static constexpr unsigned N = 4;  /* floats per vector */
+
+	static inline float32x4_t _clipped(float32x4_t v)
+	{
+		return vmaxq_f32(vminq_f32(v, vdupq_n_f32(1.0f)), vdupq_n_f32(-1.0f));
+	}
+
+	static inline void scale(float *dst, unsigned n, float factor)
+	{
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(dst + i), factor));
+
+		Slow::scale(dst + i, n - i, factor);
+	}
+
+	static inline void add_scaled(float *dst, float const *src, unsigned n,
+	                              float factor)
+	{
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			vst1q_f32(dst + i, vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), factor));
+
+		Slow::add_scaled(dst + i, src + i, n - i, factor);
+	}
+
+	static inline void scale_clipped(float *dst, float const *src, unsigned n,
+	                                 float vol, float out_vol)
+	{
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			vst1q_f32(dst + i, vmulq_n_f32(_clipped(vmulq_n_f32(vld1q_f32(src + i), vol)), out_vol));
+
+		Slow::scale_clipped(dst + i, src + i, n - i, vol, out_vol);
+	}
+
+	static inline void mix_clipped(float *dst, float const *src, unsigned n,
+	                               float vol, float out_vol)
+	{
+		unsigned i = 0;
+		for (; i + N <= n; i += N) {
+			float32x4_t const sum = vmlaq_n_f32(vld1q_f32(dst + i), vld1q_f32(src + i), vol);
+			vst1q_f32(dst + i, vmulq_n_f32(_clipped(sum), out_vol));
+		}
+
+		Slow::mix_clipped(dst + i, src + i, n - i, vol, out_vol);
+	}
+};
+
+#endif /* _INCLUDE__MIXER__INTERNAL__NEON_H_ */
@@ -0,0 +1,57 @@
+/*
+ * \brief  Fallback mixing of float samples
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__MIXER__INTERNAL__SLOW_H_
+#define _INCLUDE__MIXER__INTERNAL__SLOW_H_
+
+namespace Mixer::Dsp { struct Slow; }
+
+
+struct Mixer::Dsp::Slow
+{
+	static inline float _clipped(float v)
+	{
+		if (v >  1.0f) return  1.0f;
+		if (v < -1.0f) return -1.0f;
+		return v;
+	}
+
+	static inline void scale(float *dst, unsigned n, float factor)
+	{
+		for (unsigned i = 0; i < n; i++)
+			dst[i] *= factor;
+	}
+
+	static inline void add_scaled(float *dst, float const *src, unsigned n,
+	                              float factor)
+	{
+		for (unsigned i = 0; i < n; i++)
+			dst[i] += src[i]*factor;
+	}
+
+	static inline void scale_clipped(float *dst, float const *src, unsigned n,
+	                                 float vol, float out_vol)
+	{
+		for (unsigned i = 0; i < n; i++)
+			dst[i] = _clipped(src[i]*vol)*out_vol;
+	}
+
+	static inline void mix_clipped(float *dst, float const *src, unsigned n,
+	                               float vol, float out_vol)
+	{
+		for (unsigned i = 0; i < n; i++)
+			dst[i] = _clipped(dst[i] + src[i]*vol)*out_vol;
+	}
+};
+
+#endif /* _INCLUDE__MIXER__INTERNAL__SLOW_H_ */
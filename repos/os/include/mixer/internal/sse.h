@@ -0,0 +1,103 @@
+/*
+ * \brief  Mixing of float samples using SSE
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__MIXER__INTERNAL__SSE_H_
+#define _INCLUDE__MIXER__INTERNAL__SSE_H_
+
+#include <mixer/internal/slow.h>
+
+/* compiler intrinsics */
+#ifndef _MM_MALLOC_H_INCLUDED   /* discharge dependency from stdlib.h */
+#define _MM_MALLOC_H_INCLUDED
+#define _MM_MALLOC_H_INCLUDED_PREVENTED
+#endif
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#ifdef  _MM_MALLOC_H_INCLUDED_PREVENTED
+#undef  _MM_MALLOC_H_INCLUDED
+#undef  _MM_MALLOC_H_INCLUDED_PREVENTED
+#endif
+
+
+namespace Mixer::Dsp { struct Sse; }
+
+
+/*
+ * SSE is part of the x86_64 baseline, hence no CPU-feature detection is
+ * needed. The remainder of a sequence not filling a whole vector is
+ * handled by the fallback implementation.
+ */
+struct Mixer::Dsp::Sse
+{
+	static constexpr unsigned N = 4;  /* floats per vector */
+
+	static inline __m128 _clipped(__m128 v)
+	{
+		return _mm_max_ps(_mm_min_ps(v, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+	}
+
+	static inline void scale(float *dst, unsigned n, float factor)
+	{
+		__m128 const f = _mm_set1_ps(factor);
+
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), f));
+
+		Slow::scale(dst + i, n - i, factor);
+	}
+
+	static inline void add_scaled(float *dst, float const *src, unsigned n,
+	                              float factor)
+	{
+		__m128 const f = _mm_set1_ps(factor);
+
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i),
+			                                  _mm_mul_ps(_mm_loadu_ps(src + i), f)));
+
+		Slow::add_scaled(dst + i, src + i, n - i, factor);
+	}
+
+	static inline void scale_clipped(float *dst, float const *src, unsigned n,
+	                                 float vol, float out_vol)
+	{
+		__m128 const v = _mm_set1_ps(vol), o = _mm_set1_ps(out_vol);
+
+		unsigned i = 0;
+		for (; i + N <= n; i += N)
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_clipped(_mm_mul_ps(_mm_loadu_ps(src + i), v)), o));
+
+		Slow::scale_clipped(dst + i, src + i, n - i, vol, out_vol);
+	}
+
+	static inline void mix_clipped(float *dst, float const *src, unsigned n,
+	                               float vol, float out_vol)
+	{
+		__m128 const v = _mm_set1_ps(vol), o = _mm_set1_ps(out_vol);
+
+		unsigned i = 0;
+		for (; i + N <= n; i += N) {
+			__m128 const sum = _mm_add_ps(_mm_loadu_ps(dst + i),
+			                              _mm_mul_ps(_mm_loadu_ps(src + i), v));
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_clipped(sum), o));
+		}
+
+		Slow::mix_clipped(dst + i, src + i, n - i, vol, out_vol);
+	}
+};
+
+#endif /* _INCLUDE__MIXER__INTERNAL__SSE_H_ */
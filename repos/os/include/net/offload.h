@@ -0,0 +1,241 @@
+/*
+ * \brief  Checksum and segmentation offload metadata of network packets
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NET__OFFLOAD_H_
+#define _NET__OFFLOAD_H_
+
+/* Genode includes */
+#include <net/ethernet.h>
+#include <net/internet_checksum.h>
+#include <net/ipv4.h>
+#include <net/size_guard.h>
+#include <net/tcp.h>
+#include <util/string.h>
+
+namespace Net {
+
+	struct Offload_header;
+
+	inline bool complete_checksum(Offload_header const &, void *frame,
+	                              Genode::size_t size);
+
+	inline bool update_pseudo_header_checksum(Offload_header const &,
+	                                          void *frame, Genode::size_t size);
+
+	template <typename FN>
+	inline bool for_each_tcp_segment(Offload_header const &, void const *frame,
+	                                 Genode::size_t size, FN const &fn);
+}
+
+
+/**
+ * Offload metadata preceding each Ethernet frame of a Nic or Uplink packet
+ *
+ * The header is present only if both session parties agreed on offloading
+ * at session-creation time. Its layout corresponds to 'struct virtio_net_hdr'
+ * in the native byte order, which allows drivers to pass it on unmodified.
+ *
+ * If 'NEEDS_CSUM' is set, the checksum field at 'csum_start' + 'csum_offset'
+ * holds the uncomplemented sum of the IPv4 pseudo header only. If 'gso_type'
+ * is not 'GSO_NONE', the frame is a super-frame that must be split into
+ * segments carrying at most 'gso_size' bytes of payload each.
+ */
+struct Net::Offload_header
+{
+	enum Flags : Genode::uint8_t { NEEDS_CSUM = 1 };
+
+	enum Gso_type : Genode::uint8_t { GSO_NONE  = 0, GSO_TCPV4 = 1, GSO_UDP = 3,
+	                                  GSO_TCPV6 = 4, GSO_ECN   = 0x80 };
+
+	Genode::uint8_t  flags;
+	Genode::uint8_t  gso_type;
+	Genode::uint16_t hdr_len;
+	Genode::uint16_t gso_size;
+	Genode::uint16_t csum_start;
+	Genode::uint16_t csum_offset;
+
+	bool csum_partial() const { return flags & NEEDS_CSUM; }
+
+	Genode::uint8_t gso() const { return (Genode::uint8_t)(gso_type & ~GSO_ECN); }
+
+	bool complete() const { return !csum_partial() && gso() == GSO_NONE; }
+
+} __attribute__((packed));
+
+
+/**
+ * Complete partial checksum of a frame flagged with NEEDS_CSUM
+ *
+ * The checksum is completed by summing up the frame from 'csum_start' to its
+ * end, which includes the pseudo-header sum stored in the checksum field.
+ *
+ * \return false if the header does not fit the frame
+ */
+bool Net::complete_checksum(Offload_header const &header, void *frame,
+                            Genode::size_t size)
+{
+	Genode::size_t const start  = header.csum_start;
+	Genode::size_t const offset = header.csum_offset;
+
+	if (start + offset + sizeof(Genode::uint16_t) > size)
+		return false;
+
+	Genode::uint8_t * const data = (Genode::uint8_t *)frame + start;
+
+	((Packed_uint16 *)(data + offset))->value =
+		internet_checksum((Packed_uint16 const *)data, size - start);
+
+	return true;
+}
+
+
+/**
+ * Recompute pseudo-header sum of a frame flagged with NEEDS_CSUM
+ *
+ * Must be called after modifying the IPv4 addresses of the frame, e.g., for
+ * network address translation.
+ *
+ * \return false if the frame is no IPv4 frame or the header does not fit
+ */
+bool Net::update_pseudo_header_checksum(Offload_header const &header,
+                                        void *frame, Genode::size_t size)
+{
+	Genode::size_t const field = header.csum_start + header.csum_offset;
+
+	if (field + sizeof(Genode::uint16_t) > size)
+		return false;
+
+	try {
+		Size_guard size_guard(size);
+
+		Ethernet_frame &eth = Ethernet_frame::cast_from(frame, size_guard);
+		if (eth.type() != Ethernet_frame::Type::IPV4)
+			return false;
+
+		Ipv4_packet &ip = eth.data<Ipv4_packet>(size_guard);
+
+		Genode::size_t const ip_hdr_size = ip.header_length()*4;
+		if (ip.total_length() < ip_hdr_size)
+			return false;
+
+		Ipv4_address src = ip.src();
+		Ipv4_address dst = ip.dst();
+
+		Genode::uint16_t const l4_size_be = ::host_to_big_endian(
+			(Genode::uint16_t)(ip.total_length() - ip_hdr_size));
+
+		Genode::uint16_t const sum = (Genode::uint16_t)~internet_checksum_pseudo_ip(
+			nullptr, 0, l4_size_be, ip.protocol(), src, dst);
+
+		((Packed_uint16 *)((Genode::uint8_t *)frame + field))->value = sum;
+	}
+	catch (Size_guard::Exceeded) { return false; }
+
+	return true;
+}
+
+
+/**
+ * Split TCPv4 super-frame into segments according to the GSO size
+ *
+ * For each segment, 'fn' is called with the segment size and a functor
+ * that writes the segment to a given destination buffer of that size.
+ * Each segment carries a copy of the original headers with the IPv4
+ * identification, lengths, sequence number, flags, and checksums adjusted.
+ *
+ * \return false if the super-frame is malformed
+ */
+template <typename FN>
+bool Net::for_each_tcp_segment(Offload_header const &header, void const *frame,
+                               Genode::size_t size, FN const &fn)
+{
+	using namespace Genode;
+
+	size_t   eth_size = 0, ip_size = 0, tcp_size = 0;
+	uint16_t ip_id    = 0;
+	uint32_t seq_nr   = 0;
+	bool     fin = false, psh = false, cwr = false;
+
+	try {
+		Size_guard size_guard(size);
+
+		Ethernet_frame const &eth =
+			Ethernet_frame::cast_from(const_cast<void *>(frame), size_guard);
+
+		if (eth.type() != Ethernet_frame::Type::IPV4)
+			return false;
+
+		Ipv4_packet const &ip = eth.data<Ipv4_packet const>(size_guard);
+		if (ip.protocol() != Ipv4_packet::Protocol::TCP)
+			return false;
+
+		/* account for IPv4 options */
+		size_guard.consume_head(ip.header_length()*4 - sizeof(Ipv4_packet));
+
+		eth_size = (addr_t)&ip - (addr_t)&eth;
+		ip_size  = ip.header_length()*4;
+
+		Tcp_packet const &tcp =
+			*(Tcp_packet const *)((addr_t)&ip + ip_size);
+
+		size_guard.consume_head(sizeof(Tcp_packet));
+		tcp_size = tcp.data_offset()*4;
+
+		ip_id  = ip.identification();
+		seq_nr = tcp.seq_nr();
+		fin    = tcp.fin();
+		psh    = tcp.psh();
+		cwr    = tcp.cwr();
+	}
+	catch (Size_guard::Exceeded) { return false; }
+
+	size_t const hdr_size = eth_size + ip_size + tcp_size;
+	size_t const mss      = header.gso_size;
+
+	if (!mss || tcp_size < sizeof(Tcp_packet) || hdr_size >= size)
+		return false;
+
+	size_t const payload_size = size - hdr_size;
+
+	for (size_t offset = 0, i = 0; offset < payload_size; offset += mss, i++) {
+
+		size_t const seg_payload = min(mss, payload_size - offset);
+		bool   const first       = (offset == 0);
+		bool   const last        = (offset + seg_payload == payload_size);
+
+		fn(hdr_size + seg_payload, [&] (void *dst)
+		{
+			uint8_t * const seg = (uint8_t *)dst;
+
+			memcpy(seg, frame, hdr_size);
+			memcpy(seg + hdr_size, (uint8_t const *)frame + hdr_size + offset,
+			       seg_payload);
+
+			Ipv4_packet &ip  = *(Ipv4_packet *)(seg + eth_size);
+			Tcp_packet  &tcp = *(Tcp_packet  *)(seg + eth_size + ip_size);
+
+			ip.total_length(ip_size + tcp_size + seg_payload);
+			ip.identification((uint16_t)(ip_id + i));
+			ip.update_checksum();
+
+			tcp.seq_nr(seq_nr + (uint32_t)offset);
+			tcp.fin(last  && fin);
+			tcp.psh(last  && psh);
+			tcp.cwr(first && cwr);
+			tcp.update_checksum(ip.src(), ip.dst(), tcp_size + seg_payload);
+		});
+	}
+	return true;
+}
+
+#endif /* _NET__OFFLOAD_H_ */
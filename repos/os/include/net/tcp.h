@@ -66,6 +66,14 @@ class Net::Tcp_packet
 			struct Data_offset : Bitfield<12, 4> { };
 		};
 
+		template <typename FLAG>
+		void _set_flag(bool v)
+		{
+			uint16_t value = flags();
+			FLAG::set(value, v);
+			_flags = host_to_big_endian(value);
+		}
+
 	public:
 
 		void update_checksum(Ipv4_address ip_src,
@@ -100,6 +108,11 @@ class Net::Tcp_packet
 
 		void src_port(Port p) { _src_port = host_to_big_endian(p.value); }
 		void dst_port(Port p) { _dst_port = host_to_big_endian(p.value); }
+		void seq_nr(uint32_t v) { _seq_nr = host_to_big_endian(v); }
+
+		void fin(bool v) { _set_flag<Flags::Fin>(v); }
+		void psh(bool v) { _set_flag<Flags::Psh>(v); }
+		void cwr(bool v) { _set_flag<Flags::Cwr>(v); }
 
 		void src_port(Port p, Internet_checksum_diff &icd);
 		void dst_port(Port p, Internet_checksum_diff &icd);
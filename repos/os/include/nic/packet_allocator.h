@@ -38,6 +38,11 @@ namespace Nic { struct Packet_allocator; }
  * Genode::Packet_allocator. As DEFAULT_PACKET_SIZE is used for the
  * transmission-buffer calculation we could not change it without breaking the
  * API. OFFSET_PACKET_SIZE reflects the actual (usable) packet-buffer size.
+ *
+ * Packets of sessions with offloading may hold super-frames of up to 64 KiB,
+ * see 'Nic::Session::offload'. Such packets span multiple blocks and are
+ * limited to MAX_PACKET_SIZE. They are accepted only once offloading is
+ * enabled for the allocator of the respective session.
  */
 struct Nic::Packet_allocator : Genode::Packet_allocator
 {
@@ -45,10 +50,13 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 		DEFAULT_PACKET_SIZE = 1600,
 		OFFSET = 2,
 		OFFSET_PACKET_SIZE = DEFAULT_PACKET_SIZE - OFFSET,
+		MAX_PACKET_SIZE    = 66*1024,
 	};
 
 	using size_t = Genode::size_t;
 
+	size_t _max_packet_size = OFFSET_PACKET_SIZE;
+
 	/**
 	 * Constructor
 	 *
@@ -57,9 +65,20 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 	Packet_allocator(Genode::Allocator *md_alloc)
 	: Genode::Packet_allocator(md_alloc, DEFAULT_PACKET_SIZE) {}
 
+	/**
+	 * Enable or disable packets of up to MAX_PACKET_SIZE
+	 *
+	 * Must be enabled only if offloading was negotiated for the session.
+	 */
+	void enable_offload(bool const enabled)
+	{
+		_max_packet_size = enabled ? size_t(MAX_PACKET_SIZE)
+		                           : size_t(OFFSET_PACKET_SIZE);
+	}
+
 	Alloc_result try_alloc(size_t size) override
 	{
-		if (!size || size > OFFSET_PACKET_SIZE) {
+		if (!size || size > _max_packet_size) {
 			Genode::error("unsupported NIC packet size ", size);
 			return Alloc_result { Alloc_error::DENIED };
 		}
@@ -85,7 +104,7 @@ struct Nic::Packet_allocator : Genode::Packet_allocator
 
 	void free(void *addr, size_t size) override
 	{
-		if (!size || size > OFFSET_PACKET_SIZE) {
+		if (!size || size > _max_packet_size) {
 			Genode::error("unsupported NIC packet size ", size);
 			return;
 		}
@@ -64,6 +64,8 @@ class Nic::Session_client : public Genode::Rpc_client<Session>
 		}
 
 		bool link_state() override { return call<Rpc_link_state>(); }
+
+		bool offload() override { return call<Rpc_offload>(); }
 };
 
 #endif /* _INCLUDE__NIC_SESSION__CLIENT_H_ */
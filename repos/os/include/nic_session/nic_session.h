@@ -116,6 +116,16 @@ struct Nic::Session : Genode::Session
 	 */
 	virtual void link_state_sigh(Genode::Signal_context_capability sigh) = 0;
 
+	/**
+	 * Request whether packets carry offload metadata
+	 *
+	 * A client requests offloading via the 'offload' session argument. If
+	 * the server grants the request, each packet of both directions starts
+	 * with a 'Net::Offload_header'. Servers unaware of offloading never
+	 * grant it.
+	 */
+	virtual bool offload() { return false; }
+
 	/*******************
 	 ** RPC interface **
 	 *******************/
@@ -126,9 +136,11 @@ struct Nic::Session : Genode::Session
 	GENODE_RPC(Rpc_link_state, bool, link_state);
 	GENODE_RPC(Rpc_link_state_sigh, void, link_state_sigh,
 	           Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_offload, bool, offload);
 
 	GENODE_RPC_INTERFACE(Rpc_mac_address, Rpc_link_state,
-	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap);
+	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap,
+	                     Rpc_offload);
 };
 
 #endif /* _INCLUDE__NIC_SESSION__NIC_SESSION_H_ */
@@ -0,0 +1,63 @@
+/*
+ * \brief  Mixing and volume kernels for float samples
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SPEC__ARM_64__MIXER__DSP_H_
+#define _INCLUDE__SPEC__ARM_64__MIXER__DSP_H_
+
+#include <mixer/internal/neon.h>
+
+namespace Mixer::Dsp {
+
+	/**
+	 * Multiply 'n' samples at 'dst' by 'factor'
+	 */
+	static inline void scale(float *dst, unsigned n, float factor)
+	{
+		Neon::scale(dst, n, factor);
+	}
+
+	/**
+	 * Add 'n' samples of 'src' multiplied by 'factor' to 'dst'
+	 */
+	static inline void add_scaled(float *dst, float const *src, unsigned n,
+	                              float factor)
+	{
+		Neon::add_scaled(dst, src, n, factor);
+	}
+
+	/**
+	 * Write samples of 'src' multiplied by 'vol' to 'dst'
+	 *
+	 * Each value is clipped at [-1.0, 1.0] before being multiplied by
+	 * 'out_vol'.
+	 */
+	static inline void scale_clipped(float *dst, float const *src, unsigned n,
+	                                 float vol, float out_vol)
+	{
+		Neon::scale_clipped(dst, src, n, vol, out_vol);
+	}
+
+	/**
+	 * Add samples of 'src' multiplied by 'vol' to 'dst'
+	 *
+	 * Each sum is clipped at [-1.0, 1.0] before being multiplied by
+	 * 'out_vol'.
+	 */
+	static inline void mix_clipped(float *dst, float const *src, unsigned n,
+	                               float vol, float out_vol)
+	{
+		Neon::mix_clipped(dst, src, n, vol, out_vol);
+	}
+}
+
+#endif /* _INCLUDE__SPEC__ARM_64__MIXER__DSP_H_ */
@@ -56,6 +56,8 @@ class Uplink::Session_client : public Genode::Rpc_client<Session>
 		Rx *rx_channel() override { return &_rx; }
 		Tx::Source *tx() override { return _tx.source(); }
 		Rx::Sink   *rx() override { return _rx.sink(); }
+
+		bool offload() override { return call<Rpc_offload>(); }
 };
 
 #endif /* _UPLINK_SESSION__CLIENT_H_ */
@@ -32,20 +32,24 @@ struct Uplink::Connection : Genode::Connection<Session>, Session_client
 	 *                         transmission buffer
 	 * \param tx_buf_size      size of transmission buffer in bytes
 	 * \param rx_buf_size      size of reception buffer in bytes
+	 * \param offload          request packets with offload metadata, see
+	 *                         'Session::offload'
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator *tx_block_alloc,
 	           Genode::size_t           tx_buf_size,
 	           Genode::size_t           rx_buf_size,
 	           Net::Mac_address  const &mac_address,
-	           Label             const &label = Label())
+	           Label             const &label = Label(),
+	           bool                     offload = false)
 	:
 		Genode::Connection<Session>(
 			env, label,
 			Ram_quota { 32*1024*sizeof(long) + tx_buf_size + rx_buf_size },
 			Args("mac_address=\"", mac_address, "\", "
 			     "tx_buf_size=",   tx_buf_size, ", "
-			     "rx_buf_size=",   rx_buf_size)),
+			     "rx_buf_size=",   rx_buf_size, ", "
+			     "offload=",       offload)),
 		Session_client(cap(), *tx_block_alloc, env.rm())
 	{ }
 };
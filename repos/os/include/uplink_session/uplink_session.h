@@ -96,6 +96,15 @@ struct Uplink::Session : Genode::Session
 	 */
 	virtual Rx::Sink *rx() { return 0; }
 
+	/**
+	 * Request whether packets carry offload metadata
+	 *
+	 * A client requests offloading via the 'offload' session argument. If
+	 * the server grants the request, each packet of both directions starts
+	 * with a 'Net::Offload_header'. Servers unaware of offloading never
+	 * grant it.
+	 */
+	virtual bool offload() { return false; }
 
 	/*******************
 	 ** RPC interface **
@@ -103,8 +112,9 @@ struct Uplink::Session : Genode::Session
 
 	GENODE_RPC(Rpc_tx_cap, Genode::Capability<Tx>, _tx_cap);
 	GENODE_RPC(Rpc_rx_cap, Genode::Capability<Rx>, _rx_cap);
+	GENODE_RPC(Rpc_offload, bool, offload);
 
-	GENODE_RPC_INTERFACE(Rpc_tx_cap, Rpc_rx_cap);
+	GENODE_RPC_INTERFACE(Rpc_tx_cap, Rpc_rx_cap, Rpc_offload);
 };
 
 #endif /* _UPLINK_SESSION__UPLINK_SESSION_H_ */
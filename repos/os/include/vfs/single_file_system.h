@@ -37,6 +37,13 @@ class Vfs::Single_file_system : public File_system
 		{
 			using Vfs_handle::Vfs_handle;
 
+			/**
+			 * Prepare read of 'count' bytes at the current seek position
+			 *
+			 * \return false if the request cannot be queued now
+			 */
+			virtual bool queue_read(size_t /* count */) { return true; }
+
 			virtual Read_result read(Byte_range_ptr const &, size_t &out_count) = 0;
 
 			virtual Write_result write(Const_byte_range_ptr const &, size_t &out_count) = 0;
@@ -252,6 +259,17 @@ class Vfs::Single_file_system : public File_system
 		 ** File I/O service interface **
 		 ********************************/
 
+		bool queue_read(Vfs_handle *vfs_handle, size_t count) override
+		{
+			Single_vfs_handle *handle =
+				static_cast<Single_vfs_handle*>(vfs_handle);
+
+			if (handle)
+				return handle->queue_read(count);
+
+			return true;
+		}
+
 		Read_result complete_read(Vfs_handle *vfs_handle, Byte_range_ptr const &dst,
 		                          size_t &out_count) override
 		{
@@ -1,2 +1,3 @@
-SRC_DIR = include/mixer src/server/mixer
+SRC_DIR = include/mixer include/spec/x86_64/mixer include/spec/arm_64/mixer \
+          src/server/mixer
 include $(GENODE_DIR)/repos/base/recipes/src/content.inc
@@ -1,2 +1,3 @@
-SRC_DIR = src/server/record_play_mixer
+SRC_DIR = include/mixer include/spec/x86_64/mixer include/spec/arm_64/mixer \
+          src/server/record_play_mixer
 include $(GENODE_DIR)/repos/base/recipes/src/content.inc
@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <net/mac_address.h>
+#include <net/offload.h>
 #include <nic/packet_allocator.h>
 #include <uplink_session/connection.h>
 
@@ -41,10 +42,11 @@ class Genode::Uplink_client_base : Noncopyable
 		bool                                _drv_mac_addr_used               { false };
 		bool                                _drv_link_state                  { false };
 		Constructible<Uplink::Connection>   _conn                            { };
+		bool                                _conn_offload                    { false };
 		Nic::Packet_allocator               _conn_pkt_alloc                  { &_alloc };
 		Signal_handler<Uplink_client_base>  _conn_rx_ready_to_ack_handler    { _env.ep(), *this, &Uplink_client_base::_conn_rx_handle_ready_to_ack };
 		Signal_handler<Uplink_client_base>  _conn_rx_packet_avail_handler    { _env.ep(), *this, &Uplink_client_base::_conn_rx_handle_packet_avail };
-		Signal_handler<Uplink_client_base>  _conn_tx_ack_avail_handler       { _env.ep(), *this, &Uplink_client_base::_conn_tx_handle_ack_avail };
+		Signal_handler<Uplink_client_base>  _conn_tx_ack_avail_handler       { _env.ep(), *this, &Uplink_client_base::_conn_tx_handle_ack_avail_signal };
 		Signal_handler<Uplink_client_base>  _conn_tx_ready_to_submit_handler { _env.ep(), *this, &Uplink_client_base::_conn_tx_handle_ready_to_submit };
 		Packet_descriptor                   _save                            { };
 
@@ -53,7 +55,7 @@ class Genode::Uplink_client_base : Noncopyable
 		 ** Interface towards Uplink connection **
 		 *****************************************/
 
-		void _conn_tx_handle_ready_to_submit() { }
+		void _conn_tx_handle_ready_to_submit() { _drv_handle_conn_tx_ready(); }
 
 		void _conn_rx_handle_ready_to_ack() { }
 
@@ -74,6 +76,14 @@ class Genode::Uplink_client_base : Noncopyable
 			}
 		}
 
+		void _conn_tx_handle_ack_avail_signal()
+		{
+			_conn_tx_handle_ack_avail();
+
+			/* released packets make room in the TX buffer */
+			_drv_handle_conn_tx_ready();
+		}
+
 		void _conn_rx_handle_packet_avail()
 		{
 			if (!_conn.constructed()) {
@@ -95,14 +105,25 @@ class Genode::Uplink_client_base : Noncopyable
 				Packet_descriptor const conn_rx_pkt {
 					_conn->rx()->get_packet() };
 
-				if (conn_rx_pkt.size() > 0 &&
+				size_t const hdr_size {
+					_conn_offload ? sizeof(Net::Offload_header) : 0 };
+
+				if (conn_rx_pkt.size() > hdr_size &&
 				    _conn->rx()->packet_valid(conn_rx_pkt)) {
 
 					const char *const conn_rx_pkt_base {
 						_conn->rx()->packet_content(conn_rx_pkt) };
 
-					switch (_drv_transmit_pkt(conn_rx_pkt_base,
-					                          conn_rx_pkt.size())) {
+					Transmit_result const transmit_result {
+						_conn_offload
+						? _drv_transmit_offload_pkt(
+							*(Net::Offload_header const *)conn_rx_pkt_base,
+							conn_rx_pkt_base + hdr_size,
+							conn_rx_pkt.size() - hdr_size)
+						: _drv_transmit_pkt(conn_rx_pkt_base,
+						                    conn_rx_pkt.size()) };
+
+					switch (transmit_result) {
 
 					case Transmit_result::ACCEPTED:
 
@@ -149,18 +170,31 @@ class Genode::Uplink_client_base : Noncopyable
 		void _drv_rx_handle_pkt_try(size_t  conn_tx_pkt_size,
 		                            auto && fn_tx_write)
 		{
-			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, fn_tx_write, true);
+			_drv_rx_handle_pkt_gen(Net::Offload_header { }, conn_tx_pkt_size,
+			                       fn_tx_write, true);
 		}
 
 		void _drv_rx_handle_pkt(size_t  conn_tx_pkt_size,
 		                        auto && fn_tx_write)
 		{
-			_drv_rx_handle_pkt_gen(conn_tx_pkt_size, fn_tx_write, false);
+			_drv_rx_handle_pkt_gen(Net::Offload_header { }, conn_tx_pkt_size,
+			                       fn_tx_write, false);
 		}
 
-		void _drv_rx_handle_pkt_gen(size_t  conn_tx_pkt_size,
-		                            auto && write_to_conn_tx_pkt,
-		                            bool try_pattern)
+		/**
+		 * Forward packet with offload metadata, requires '_conn_offload'
+		 */
+		void _drv_rx_handle_offload_pkt(Net::Offload_header const &offload,
+		                                size_t                     conn_tx_pkt_size,
+		                                auto                    && fn_tx_write)
+		{
+			_drv_rx_handle_pkt_gen(offload, conn_tx_pkt_size, fn_tx_write, false);
+		}
+
+		void _drv_rx_handle_pkt_gen(Net::Offload_header const &offload,
+		                            size_t                     conn_tx_pkt_size,
+		                            auto                    && write_to_conn_tx_pkt,
+		                            bool                       try_pattern)
 		{
 			if (!_conn.constructed()) {
 				return;
@@ -171,12 +205,21 @@ class Genode::Uplink_client_base : Noncopyable
 				return;
 			}
 			try {
+				/* with offloading, each packet starts with the offload header */
+				size_t const hdr_size {
+					_conn_offload ? sizeof(Net::Offload_header) : 0 };
+
 				Packet_descriptor conn_tx_pkt {
-					_conn->tx()->alloc_packet(conn_tx_pkt_size) };
+					_conn->tx()->alloc_packet(hdr_size + conn_tx_pkt_size) };
 
-				void *conn_tx_pkt_base {
+				char *const pkt_base {
 					_conn->tx()->packet_content(conn_tx_pkt) };
 
+				if (_conn_offload)
+					*(Net::Offload_header *)pkt_base = offload;
+
+				void *conn_tx_pkt_base { pkt_base + hdr_size };
+
 				size_t adjusted_conn_tx_pkt_size {
 					conn_tx_pkt_size };
 
@@ -198,7 +241,8 @@ class Genode::Uplink_client_base : Noncopyable
 					} else if (adjusted_conn_tx_pkt_size < conn_tx_pkt_size) {
 
 						Packet_descriptor adjusted_conn_tx_pkt {
-							conn_tx_pkt.offset(), adjusted_conn_tx_pkt_size };
+							conn_tx_pkt.offset(),
+							hdr_size + adjusted_conn_tx_pkt_size };
 
 						if (try_pattern)
 							_conn->tx()->try_submit_packet(adjusted_conn_tx_pkt);
@@ -246,7 +290,11 @@ class Genode::Uplink_client_base : Noncopyable
 				_drv_mac_addr_used = true;
 				_conn.construct(
 					_env, &_conn_pkt_alloc, BUF_SIZE, BUF_SIZE,
-					_drv_mac_addr);
+					_drv_mac_addr, Uplink::Connection::Label(),
+					_drv_offload());
+
+				_conn_offload = _conn->offload();
+				_conn_pkt_alloc.enable_offload(_conn_offload);
 
 				/* install signal handlers at connection */
 				_conn->rx_channel()->sigh_ready_to_ack(
@@ -263,11 +311,38 @@ class Genode::Uplink_client_base : Noncopyable
 			} else {
 
 				_conn.destruct();
+				_conn_offload = false;
+				_conn_pkt_alloc.enable_offload(false);
 			}
 		}
 
 		virtual void _drv_finish_transmitted_pkts() { }
 
+		/**
+		 * Called whenever the Uplink connection may accept packets again
+		 *
+		 * Allows the driver to resume the reception of frames deferred
+		 * while the connection was congested.
+		 */
+		virtual void _drv_handle_conn_tx_ready() { }
+
+		/**
+		 * Return whether the driver handles packets with offload metadata
+		 *
+		 * If true, offloading is requested at the Uplink connection. If
+		 * granted, packets are transmitted via '_drv_transmit_offload_pkt'
+		 * and must be received via '_drv_rx_handle_offload_pkt'.
+		 */
+		virtual bool _drv_offload() { return false; }
+
+		virtual Transmit_result
+		_drv_transmit_offload_pkt(Net::Offload_header const &,
+		                          const char *, size_t)
+		{
+			class Unexpected_call { };
+			throw Unexpected_call { };
+		}
+
 		virtual Transmit_result
 		_drv_transmit_pkt(const char *conn_rx_pkt_base,
 		                  size_t      conn_rx_pkt_size) = 0;
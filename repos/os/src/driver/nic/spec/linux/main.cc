@@ -33,6 +33,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <linux/if_tun.h>
 #pragma GCC diagnostic pop  /* restore -Wconversion warnings */
@@ -48,6 +49,12 @@ class Uplink_client : public Uplink_client_base
 {
 	private:
 
+		/*
+		 * Noncopyable
+		 */
+		Uplink_client(Uplink_client const &);
+		Uplink_client &operator = (Uplink_client const &);
+
 		struct Rx_signal_thread : Thread
 		{
 			int                       fd;
@@ -76,11 +83,30 @@ class Uplink_client : public Uplink_client_base
 			}
 		};
 
+		/*
+		 * With offloading enabled, each frame is preceded by a virtio-net
+		 * header and the host may pass TCP super-frames of up to 64 KiB
+		 * with incomplete checksums. The metadata is passed on if the
+		 * Uplink server supports offloading and resolved by the driver
+		 * otherwise.
+		 */
+		enum { RX_BUF_SIZE = sizeof(Net::Offload_header) + 64*1024 };
+
+		bool const                    _offload;
 		int                           _tap_fd;
 		Signal_handler<Uplink_client> _rx_handler { _env.ep(), *this, &Uplink_client::_handle_rx };
 		Rx_signal_thread              _rx_thread  { _env, _tap_fd, *this };
+		char                         *_rx_buf     { _offload ? (char *)_alloc.alloc(RX_BUF_SIZE) : nullptr };
+
+		/*
+		 * Frame kept in '_rx_buf' until the uplink accepts it, and the
+		 * number of its segments forwarded already if it is a super-frame
+		 */
+		size_t   _rx_pending       { 0 };
+		unsigned _rx_segments_done { 0 };
+		bool     _rx_congested     { false };
 
-		static int _init_tap_fd(Tap_name const &tap_name)
+		static int _init_tap_fd(Tap_name const &tap_name, bool offload)
 		{
 			/* open TAP device */
 			int ret;
@@ -100,6 +126,8 @@ class Uplink_client : public Uplink_client_base
 
 			::memset(&ifr, 0, sizeof(ifr));
 			ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+			if (offload)
+				ifr.ifr_flags |= IFF_VNET_HDR;
 
 			copy_cstring(ifr.ifr_name, tap_name.string(), sizeof(ifr.ifr_name));
 			log("using tap device \"", tap_name, "\"");
@@ -112,11 +140,141 @@ class Uplink_client : public Uplink_client_base
 				throw Exception();
 			}
 
+			/* a failure leaves the host to handle checksums and segmentation */
+			if (offload && ioctl(fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4) != 0)
+				warning("could not enable checksum and segmentation offload");
+
 			return fd;
 		}
 
+		/**
+		 * Forward frame kept in '_rx_buf' to the uplink
+		 *
+		 * Segments of a super-frame are forwarded as long as the uplink
+		 * accepts them. The remaining segments are forwarded by the next
+		 * call.
+		 *
+		 * \return false if the uplink is congested
+		 */
+		bool _forward_pending_rx_frame()
+		{
+			Net::Offload_header const &header = *(Net::Offload_header *)_rx_buf;
+			void   const * const frame = _rx_buf + sizeof(Net::Offload_header);
+			size_t const         size  = _rx_pending;
+
+			bool forwarded = false;
+
+			auto write_frame = [&] (void *conn_tx_pkt_base, size_t &) {
+				memcpy(conn_tx_pkt_base, frame, size);
+				forwarded = true;
+				return Write_result::WRITE_SUCCEEDED;
+			};
+
+			if (_conn_offload)
+				_drv_rx_handle_offload_pkt(header, size, write_frame);
+
+			else if (header.gso() == Net::Offload_header::GSO_NONE)
+				_drv_rx_handle_pkt(size, write_frame);
+
+			else {
+				unsigned segment = 0;
+				bool     stalled = false;
+
+				bool const valid = Net::for_each_tcp_segment(header, frame, size,
+					[&] (size_t seg_size, auto const &write_segment) {
+
+						/* skip segments forwarded by a previous call */
+						if (stalled || segment++ < _rx_segments_done)
+							return;
+
+						_drv_rx_handle_pkt(seg_size,
+							[&] (void *conn_tx_pkt_base, size_t &) {
+								write_segment(conn_tx_pkt_base);
+								_rx_segments_done++;
+								return Write_result::WRITE_SUCCEEDED;
+							});
+
+						stalled = (_rx_segments_done < segment);
+					});
+
+				/* malformed super-frames are dropped */
+				forwarded = !valid || !stalled;
+			}
+
+			if (forwarded)
+				_rx_pending = 0;
+
+			return forwarded;
+		}
+
+		/**
+		 * Receive frames with offload metadata
+		 */
+		void _handle_rx_offload()
+		{
+			_rx_congested = false;
+
+			for (;;) {
+
+				if (!_conn.constructed()) {
+					_rx_pending = 0;
+					return;
+				}
+
+				/* leave frames in the TAP device while the uplink is congested */
+				if ((_rx_pending && !_forward_pending_rx_frame())
+				 || !_conn->tx()->ready_to_submit()) {
+					_rx_congested = true;
+					return;
+				}
+
+				ssize_t const read_result { ::read(_tap_fd, _rx_buf, RX_BUF_SIZE) };
+				if (read_result <= 0) {
+					_rx_thread.blockade.wakeup();
+					return;
+				}
+
+				if ((size_t)read_result <= sizeof(Net::Offload_header))
+					continue;
+
+				Net::Offload_header &header = *(Net::Offload_header *)_rx_buf;
+				void * const  frame  = _rx_buf + sizeof(Net::Offload_header);
+				size_t const  size   = read_result - sizeof(Net::Offload_header);
+
+				if (!_conn_offload) {
+
+					switch (header.gso()) {
+
+					case Net::Offload_header::GSO_NONE:
+
+						if (header.csum_partial())
+							if (!Net::complete_checksum(header, frame, size))
+								continue;
+						break;
+
+					case Net::Offload_header::GSO_TCPV4:
+						break;
+
+					default:
+
+						warning("dropping frame with unsupported GSO type ",
+						        header.gso_type);
+						continue;
+					}
+				}
+
+				_rx_pending       = size;
+				_rx_segments_done = 0;
+			}
+		}
+
 		void _handle_rx()
 		{
+			if (_offload) {
+				_handle_rx_offload();
+				return;
+			}
+
 			bool progress { true };
 			while (progress) {
 
@@ -144,20 +302,21 @@ class Uplink_client : public Uplink_client_base
 			}
 		}
 
-
-		/************************
-		 ** Uplink_client_base **
-		 ************************/
-
-		Transmit_result
-		_drv_transmit_pkt(const char *conn_rx_pkt_base,
-		                  size_t      conn_rx_pkt_size) override
+		Transmit_result _write_to_tap(Net::Offload_header const &header,
+		                              const char                *conn_rx_pkt_base,
+		                              size_t                     conn_rx_pkt_size)
 		{
 			ssize_t ret;
 
+			struct iovec iov[2] {
+				{ .iov_base = (void *)&header,           .iov_len = sizeof(header) },
+				{ .iov_base = (void *)conn_rx_pkt_base,  .iov_len = conn_rx_pkt_size } };
+
 			/* non-blocking-write packet to TAP */
 			do {
-				ret = ::write(_tap_fd, conn_rx_pkt_base, conn_rx_pkt_size);
+				ret = _offload
+				    ? ::writev(_tap_fd, iov, 2)
+				    : ::write(_tap_fd, conn_rx_pkt_base, conn_rx_pkt_size);
 				/* drop packet if write would block */
 				if (ret < 0 && errno == EAGAIN)
 					continue;
@@ -168,19 +327,58 @@ class Uplink_client : public Uplink_client_base
 			return Transmit_result::ACCEPTED;
 		}
 
+
+		/************************
+		 ** Uplink_client_base **
+		 ************************/
+
+		Transmit_result
+		_drv_transmit_pkt(const char *conn_rx_pkt_base,
+		                  size_t      conn_rx_pkt_size) override
+		{
+			/* frames without metadata are complete, hence the header is empty */
+			return _write_to_tap(Net::Offload_header { }, conn_rx_pkt_base,
+			                     conn_rx_pkt_size);
+		}
+
+		bool _drv_offload() override { return _offload; }
+
+		void _drv_handle_conn_tx_ready() override
+		{
+			if (_rx_congested)
+				_handle_rx_offload();
+		}
+
+		Transmit_result
+		_drv_transmit_offload_pkt(Net::Offload_header const &header,
+		                          const char                *conn_rx_pkt_base,
+		                          size_t                     conn_rx_pkt_size) override
+		{
+			/* the host resolves partial checksums and super-frames */
+			return _write_to_tap(header, conn_rx_pkt_base, conn_rx_pkt_size);
+		}
+
 	public:
 
 		Uplink_client(Env               &env,
 		              Allocator         &alloc,
 		              Tap_name    const &tap_name,
-		              Mac_address const &mac_address)
+		              Mac_address const &mac_address,
+		              bool               offload)
 		:
 			Uplink_client_base { env, alloc, mac_address },
-			_tap_fd { _init_tap_fd(tap_name) }
+			_offload { offload },
+			_tap_fd { _init_tap_fd(tap_name, offload) }
 		{
 			_drv_handle_link_state(true);
 			_rx_thread.start();
 		}
+
+		~Uplink_client()
+		{
+			if (_rx_buf)
+				_alloc.free(_rx_buf, RX_BUF_SIZE);
+		}
 };
 
 
@@ -206,7 +404,10 @@ struct Main
 	Mac_address _mac_address {
 		_config_rom.xml().attribute_value("mac", _default_mac_address()) };
 
-	Uplink_client _uplink { _env, _heap, _tap_name, _mac_address };
+	bool const _offload {
+		_config_rom.xml().attribute_value("offload", false) };
+
+	Uplink_client _uplink { _env, _heap, _tap_name, _mac_address, _offload };
 
 	Constructible<Reporter> _reporter { };
 
@@ -1,4 +1,4 @@
 TARGET   = linux_nic
 REQUIRES = linux
-LIBS     = lx_hybrid nic_driver
+LIBS     = lx_hybrid nic_driver net
 SRC_CC   = main.cc
@@ -77,6 +77,7 @@ class Virtio_nic::Device : Noncopyable
 		{
 			Nic::Mac_address mac = { };
 			bool link_status_available = false;
+			bool offload = false;
 		};
 
 		/**
@@ -150,6 +151,8 @@ class Virtio_nic::Device : Noncopyable
 		Virtio::Device           &_device;
 		Hardware_features   const _hw_features;
 		Rx_queue_type             _rx_vq;
+		uint16_t            const _tx_vq_size;
+		uint16_t            const _tx_vq_buf_size;
 		Tx_queue_type             _tx_vq;
 
 		void _init_virtio_device()
@@ -227,6 +230,25 @@ class Virtio_nic::Device : Noncopyable
 				hw_features.link_status_available = true;
 			}
 
+			/*
+			 * Offloading requires the device to accept TCPv4 super-frames
+			 * with partial checksums. Received super-frames (GUEST_TSO4)
+			 * are not negotiated because they would not fit into the RX
+			 * buffers, whose size is limited to 16 bit.
+			 */
+			if (xml.attribute_value("offload", false)) {
+				if (Features::CSUM::get(device_features)       &&
+				    Features::GUEST_CSUM::get(device_features) &&
+				    Features::HOST_TSO4::get(device_features)) {
+
+					Features::CSUM::set(driver_features);
+					Features::GUEST_CSUM::set(driver_features);
+					Features::HOST_TSO4::set(driver_features);
+					hw_features.offload = true;
+				} else
+					warning("device does not support checksum and segmentation offload");
+			}
+
 			_device.set_features(0, (uint32_t)driver_features);
 			_device.set_features(1, (uint32_t)(driver_features >> 32));
 
@@ -291,15 +313,15 @@ class Virtio_nic::Device : Noncopyable
 		       Platform::Connection    &plat,
 		       Genode::Xml_node  const &xml)
 		try :
-			_verbose     { xml.attribute_value("verbose", false) },
-			_device      { device },
-			_hw_features { _init_hw_features(xml) },
-			_rx_vq       { plat,
-			               _vq_size(RX_VQ, xml, "rx_queue_size"),
-			               _buf_size(RX_VQ, xml, "rx_buffer_size") },
-			_tx_vq       { plat,
-			               _vq_size(TX_VQ, xml, "tx_queue_size"),
-			               _buf_size(TX_VQ, xml, "tx_buffer_size") }
+			_verbose        { xml.attribute_value("verbose", false) },
+			_device         { device },
+			_hw_features    { _init_hw_features(xml) },
+			_rx_vq          { plat,
+			                  _vq_size(RX_VQ, xml, "rx_queue_size"),
+			                  _buf_size(RX_VQ, xml, "rx_buffer_size") },
+			_tx_vq_size     { _vq_size(TX_VQ, xml, "tx_queue_size") },
+			_tx_vq_buf_size { _buf_size(TX_VQ, xml, "tx_buffer_size") },
+			_tx_vq          { plat, _tx_vq_size, _tx_vq_buf_size }
 		{ }
 		catch (Tx_queue_type::Invalid_buffer_size)
 		{
@@ -341,10 +363,30 @@ class Virtio_nic::Device : Noncopyable
 			_device.irq_ack();
 		}
 
-		bool tx_vq_write_pkt(char     const *pkt_base,
-		                     Genode::size_t  pkt_size)
+		/**
+		 * Return whether the TX queue can take super-frames with offload
+		 * metadata, each occupying a chain of descriptors
+		 */
+		bool offload() const
+		{
+			size_t const max_frame_size = sizeof(Virtio_net_header)
+			                            + sizeof(Net::Ethernet_frame) + 0xffff;
+
+			return _hw_features.offload
+			    && (size_t)(_tx_vq_size - 1)*_tx_vq_buf_size >= max_frame_size;
+		}
+
+		bool tx_vq_write_pkt(Net::Offload_header const &offload,
+		                     char                const *pkt_base,
+		                     Genode::size_t             pkt_size)
 		{
 			Virtio_net_header hdr;
+			hdr.flags       = offload.flags;
+			hdr.gso_type    = offload.gso_type;
+			hdr.hdr_len     = offload.hdr_len;
+			hdr.gso_size    = offload.gso_size;
+			hdr.csum_start  = offload.csum_start;
+			hdr.csum_offset = offload.csum_offset;
 			return _tx_vq.write_data(hdr, pkt_base, pkt_size);
 		}
 
@@ -428,18 +470,35 @@ class Virtio_nic::Uplink_client : public Virtio_nic::Device,
 		void _receive()
 		{
 			rx_vq_read_pkt(
-				[&] (Virtio_net_header const &,
+				[&] (Virtio_net_header const &hdr,
 				     char              const *data,
 				     size_t                   size)
 			{
-				_drv_rx_handle_pkt(
-					size,
-					[&] (void   *conn_tx_pkt_base,
-						 size_t &conn_tx_pkt_size)
+				/* with GUEST_CSUM, the device may pass partial checksums */
+				Net::Offload_header offload { };
+				if (hdr.flags & Virtio_net_header::NEEDS_CSUM) {
+					offload.flags       = Net::Offload_header::NEEDS_CSUM;
+					offload.csum_start  = hdr.csum_start;
+					offload.csum_offset = hdr.csum_offset;
+				}
+
+				auto write_to_conn_tx_pkt = [&] (void   *conn_tx_pkt_base,
+				                                 size_t &conn_tx_pkt_size)
 				{
 					memcpy(conn_tx_pkt_base, data, conn_tx_pkt_size);
+
+					if (!_conn_offload && offload.csum_partial())
+						Net::complete_checksum(offload, conn_tx_pkt_base,
+						                       conn_tx_pkt_size);
+
 					return Write_result::WRITE_SUCCEEDED;
-				});
+				};
+
+				if (_conn_offload)
+					_drv_rx_handle_offload_pkt(offload, size, write_to_conn_tx_pkt);
+				else
+					_drv_rx_handle_pkt(size, write_to_conn_tx_pkt);
+
 				return true;
 			});
 		}
@@ -461,18 +520,19 @@ class Virtio_nic::Uplink_client : public Virtio_nic::Device,
 		 ** Uplink_client_base **
 		 ************************/
 
-		Transmit_result
-		_drv_transmit_pkt(const char *conn_rx_pkt_base,
-		                  size_t      conn_rx_pkt_size) override
+		Transmit_result _transmit(Net::Offload_header const &offload,
+		                          const char                *conn_rx_pkt_base,
+		                          size_t                     conn_rx_pkt_size)
 		{
 			rx_vq_ack_pkts();
-			if (!tx_vq_write_pkt(conn_rx_pkt_base, conn_rx_pkt_size)) {
+			if (!tx_vq_write_pkt(offload, conn_rx_pkt_base, conn_rx_pkt_size)) {
 				/*
 				 * VirtIO transmit queue is full, flush it and retry sending the pkt.
 				 */
 				tx_vq_flush();
+				rx_vq_ack_pkts();
 
-				if (!tx_vq_write_pkt(conn_rx_pkt_base, conn_rx_pkt_size)) {
+				if (!tx_vq_write_pkt(offload, conn_rx_pkt_base, conn_rx_pkt_size)) {
 					warning("Failed to send packet after flushing VirtIO queue!");
 					return Transmit_result::REJECTED;
 				}
@@ -481,6 +541,31 @@ class Virtio_nic::Uplink_client : public Virtio_nic::Device,
 			return Transmit_result::ACCEPTED;
 		}
 
+		Transmit_result
+		_drv_transmit_pkt(const char *conn_rx_pkt_base,
+		                  size_t      conn_rx_pkt_size) override
+		{
+			return _transmit(Net::Offload_header { }, conn_rx_pkt_base,
+			                 conn_rx_pkt_size);
+		}
+
+		bool _drv_offload() override { return offload(); }
+
+		Transmit_result
+		_drv_transmit_offload_pkt(Net::Offload_header const &offload,
+		                          const char                *conn_rx_pkt_base,
+		                          size_t                     conn_rx_pkt_size) override
+		{
+			/* super-frames are chained over multiple descriptors */
+			switch (offload.gso()) {
+			case Net::Offload_header::GSO_NONE:
+			case Net::Offload_header::GSO_TCPV4:
+				return _transmit(offload, conn_rx_pkt_base, conn_rx_pkt_size);
+			default:
+				return Transmit_result::REJECTED;
+			}
+		}
+
 		void _drv_finish_transmitted_pkts() override
 		{
 			_finish_sent_packets();
@@ -383,6 +383,16 @@ void Sandbox::Child::report_state(Xml_generator &xml, Report_detail const &detai
 		if (_heartbeat_enabled && _child.skipped_heartbeats())
 			xml.attribute("skipped_heartbeats", _child.skipped_heartbeats());
 
+		if (detail.placement() && _placed) {
+			xml.node("affinity", [&] () {
+				Affinity::Location const location = _resources.affinity.location();
+				xml.attribute("xpos",   location.xpos());
+				xml.attribute("ypos",   location.ypos());
+				xml.attribute("width",  location.width());
+				xml.attribute("height", location.height());
+			});
+		}
+
 		if (detail.child_ram() && _child.pd_session_cap().valid()) {
 			xml.node("ram", [&] () {
 
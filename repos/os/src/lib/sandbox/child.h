@@ -30,6 +30,7 @@
 #include <service.h>
 #include <utils.h>
 #include <route_model.h>
+#include <service_changes.h>
 
 namespace Sandbox { class Child; }
 
@@ -304,6 +305,9 @@ class Sandbox::Child : Child_policy, Routed_service::Wakeup
 
 		Resources _resources;
 
+		/* true if the affinity location was assigned by 'Placement' */
+		bool _placed = false;
+
 		Ram_quota _configured_ram_quota() const;
 		Cap_quota _configured_cap_quota() const;
 
@@ -609,6 +613,22 @@ class Sandbox::Child : Child_policy, Routed_service::Wakeup
 		Cap_quota cap_quota() const { return _resources.assigned_cap_quota; }
 		Cpu_quota cpu_quota() const { return _effective_cpu_quota; }
 
+		Affinity affinity() const { return _resources.affinity; }
+
+		/**
+		 * Assign affinity location to a child without '<affinity>' node
+		 *
+		 * The location must be assigned before the child is started.
+		 */
+		void place(Affinity::Location const &location)
+		{
+			if (_state != State::INITIAL)
+				return;
+
+			_resources.affinity = Affinity(_resources.affinity.space(), location);
+			_placed = true;
+		}
+
 		void try_start()
 		{
 			if (_state == State::INITIAL) {
@@ -669,6 +689,18 @@ class Sandbox::Child : Child_policy, Routed_service::Wakeup
 
 		bool uncertain_dependencies() const { return _uncertain_dependencies; }
 
+		/**
+		 * Return true if any session of the child refers to a changed service
+		 */
+		bool uses_any(Service_changes const &changes) const
+		{
+			bool result = false;
+			_child.for_each_session([&] (Session_state const &session) {
+				result |= changes.contains(session.service().name()); });
+
+			return result;
+		}
+
 		/**
 		 * Validate that the routes of all existing sessions remain intact
 		 *
@@ -111,10 +111,17 @@ struct Config_model::Affinity_space_node : Node
 
 	Constructible<Affinity::Space> &_affinity_space;
 
-	Affinity_space_node(Constructible<Affinity::Space> &affinity_space)
-	: _affinity_space(affinity_space) { }
+	Placement &_placement;
 
-	~Affinity_space_node() { _affinity_space.destruct(); }
+	Affinity_space_node(Constructible<Affinity::Space> &affinity_space,
+	                    Placement &placement)
+	: _affinity_space(affinity_space), _placement(placement) { }
+
+	~Affinity_space_node()
+	{
+		_affinity_space.destruct();
+		_placement.disable();
+	}
 
 	bool matches(Xml_node const &xml) const override { return type_matches(xml); }
 
@@ -122,6 +129,8 @@ struct Config_model::Affinity_space_node : Node
 	{
 		_affinity_space.construct(xml.attribute_value("width",  1u),
 		                          xml.attribute_value("height", 1u));
+
+		_placement.apply_config(xml);
 	}
 };
 
@@ -172,13 +181,19 @@ struct Config_model::Report_node : Node
 
 	Version  const &_version;
 	State_reporter &_state_reporter;
+	Placement      &_placement;
 
-	Report_node(Version const &version, State_reporter &state_reporter)
-	: _version(version), _state_reporter(state_reporter) { }
+	Report_node(Version const &version, State_reporter &state_reporter,
+	            Placement &placement)
+	:
+		_version(version), _state_reporter(state_reporter),
+		_placement(placement)
+	{ }
 
 	~Report_node()
 	{
 		_state_reporter.apply_config(_version, Xml_node("<empty/>"));
+		_placement.reported(false);
 	}
 
 	bool matches(Xml_node const &xml) const override { return type_matches(xml); }
@@ -186,6 +201,7 @@ struct Config_model::Report_node : Node
 	void update(Xml_node const &xml) override
 	{
 		_state_reporter.apply_config(_version, xml);
+		_placement.reported(Report_detail(xml).placement());
 	}
 };
 
@@ -331,6 +347,7 @@ void Config_model::update_from_xml(Xml_node                 const &xml,
                                    Ram_quota                      &default_ram,
                                    Prio_levels                    &prio_levels,
                                    Constructible<Affinity::Space> &affinity_space,
+                                   Placement                      &placement,
                                    Start_model::Factory           &child_factory,
                                    Parent_provides_model::Factory &parent_service_factory,
                                    Service_model::Factory         &service_factory,
@@ -368,10 +385,10 @@ void Config_model::update_from_xml(Xml_node                 const &xml,
 			return *new (alloc) Start_node(child_factory, xml);
 
 		if (Affinity_space_node::type_matches(xml))
-			return *new (alloc) Affinity_space_node(affinity_space);
+			return *new (alloc) Affinity_space_node(affinity_space, placement);
 
 		if (Report_node::type_matches(xml))
-			return *new (alloc) Report_node(version, state_reporter);
+			return *new (alloc) Report_node(version, state_reporter, placement);
 
 		if (Resource_node::type_matches(xml))
 			return *new (alloc) Resource_node(preservation, xml);
@@ -19,6 +19,7 @@
 
 /* local includes */
 #include <heartbeat.h>
+#include <placement.h>
 
 namespace Sandbox {
 
@@ -276,6 +277,7 @@ class Sandbox::Config_model : Noncopyable
 		                     Ram_quota                      &,
 		                     Prio_levels                    &,
 		                     Constructible<Affinity::Space> &,
+		                     Placement                      &,
 		                     Start_model::Factory           &,
 		                     Parent_provides_model::Factory &,
 		                     Service_model::Factory         &,
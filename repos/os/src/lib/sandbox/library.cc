@@ -40,6 +40,7 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 	using Verbose        = ::Sandbox::Verbose;
 	using State_reporter = ::Sandbox::State_reporter;
 	using Heartbeat      = ::Sandbox::Heartbeat;
+	using Placement      = ::Sandbox::Placement;
 	using Server         = ::Sandbox::Server;
 	using Alias          = ::Sandbox::Alias;
 	using Child          = ::Sandbox::Child;
@@ -83,6 +84,8 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 
 	Heartbeat _heartbeat { _env, _children, _state_reporter };
 
+	Placement _placement { _env, _children, _state_reporter };
+
 	/*
 	 * Internal representation of the XML configuration
 	 */
@@ -91,8 +94,29 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 	/*
 	 * Variables for tracking the side effects of updating the config model
 	 */
-	bool _server_appeared_or_disappeared = false;
-	bool _state_report_outdated          = false;
+	::Sandbox::Service_changes _service_changes { _heap };
+
+	bool _state_report_outdated = false;
+
+	/*
+	 * Statistics about the most recent config update
+	 */
+	struct Reconfiguration
+	{
+		unsigned iterations;    /* rounds of dependency evaluation */
+		unsigned evaluated;     /* number of dependency evaluations */
+		unsigned children;      /* number of children */
+		uint64_t duration_us;   /* 0 if no timer is available */
+
+		void generate(Xml_generator &xml) const
+		{
+			xml.attribute("iterations", iterations);
+			xml.attribute("evaluated",  evaluated);
+			xml.attribute("children",   children);
+			if (duration_us)
+				xml.attribute("duration_us", duration_us);
+		}
+	} _reconfiguration { };
 
 	unsigned _child_cnt = 0;
 
@@ -175,6 +199,12 @@ struct Genode::Sandbox::Library : ::Sandbox::State_reporter::Producer,
 		if (detail.init_caps())
 			xml.node("caps", [&] () { Cap_info::from_pd(_env.pd()).generate(xml); });
 
+		if (detail.reconfig())
+			xml.node("reconfiguration", [&] () { _reconfiguration.generate(xml); });
+
+		if (detail.placement())
+			_placement.generate(xml);
+
 		if (detail.children())
 			_children.report_state(xml, detail);
 	}
@@ -382,13 +412,15 @@ bool Genode::Sandbox::Library::ready_to_create_child(Start_model::Name    const
 			      _prio_levels, _effective_affinity_space(),
 			      _parent_services, _child_services, _local_services,
 			      _pd_intrinsics);
+
+		/* place child before it is accounted at its location */
+		if (_placement.enabled() && !start_node.has_sub_node("affinity"))
+			child.place(_placement.location());
+
 		_children.insert(&child);
 
 		_avail_cpu.percent -= min(_avail_cpu.percent, child.cpu_quota().percent);
 
-		if (start_node.has_sub_node("provides"))
-			_server_appeared_or_disappeared = true;
-
 		_state_report_outdated = true;
 
 		return child;
@@ -425,7 +457,6 @@ void Genode::Sandbox::Library::update_child(Child &child, Xml_node const &start)
 	case Child::NO_SIDE_EFFECTS: break;
 
 	case Child::PROVIDED_SERVICES_CHANGED:
-		_server_appeared_or_disappeared = true;
 		_state_report_outdated = true;
 		break;
 	};
@@ -434,8 +465,21 @@ void Genode::Sandbox::Library::update_child(Child &child, Xml_node const &start)
 
 void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 {
-	_server_appeared_or_disappeared = false;
-	_state_report_outdated          = false;
+	_state_report_outdated = false;
+
+	/* the start time is unknown if the timer is constructed by this update */
+	bool     start_known = false;
+	uint64_t start_us    = 0;
+	_state_reporter.with_curr_time_us([&] (uint64_t us) {
+		start_us = us; start_known = true; });
+
+	/*
+	 * Services may have appeared or disappeared independent of config
+	 * updates, e.g., when a child exited. Those changes are not considered
+	 * as side effects of the config update.
+	 */
+	_service_changes.import(_child_services);
+	_service_changes.clear();
 
 	_config_model.update_from_xml(config,
 	                              _heap,
@@ -447,6 +491,7 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 	                              _default_ram,
 	                              _prio_levels,
 	                              _affinity_space,
+	                              _placement,
 	                              *this, *this, _server,
 	                              _state_reporter,
 	                              _heartbeat);
@@ -465,11 +510,19 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 	 * routed or result in a different route. As each child may be a service,
 	 * an avalanche effect may occur. It stops if no child gets scheduled to be
 	 * restarted in one iteration over all children.
+	 *
+	 * In each iteration, only the children that use a service of the same
+	 * name as an appeared or disappeared service are re-evaluated, along
+	 * with stuck children and children with uncertain dependencies.
 	 */
+	Reconfiguration reconfiguration { };
+
 	while (true) {
 
 		bool any_restart_scheduled = false;
 
+		_service_changes.import(_child_services);
+
 		_children.for_each_child([&] (Child &child) {
 
 			if (child.abandoned())
@@ -480,13 +533,23 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 				return;
 			}
 
-			if (_server_appeared_or_disappeared || child.uncertain_dependencies())
+			bool const affected_by_service_changes =
+				_service_changes.any() && (child.stuck() || child.uses_any(_service_changes));
+
+			if (affected_by_service_changes || child.uncertain_dependencies()) {
 				child.evaluate_dependencies();
+				reconfiguration.evaluated++;
+			}
 
 			if (child.restart_scheduled())
 				any_restart_scheduled = true;
 		});
 
+		reconfiguration.iterations++;
+
+		/* changes are re-imported after restarting children */
+		_service_changes.clear();
+
 		/*
 		 * Release resources captured by abandoned children before starting
 		 * new children. The children must be started in the order of their
@@ -515,6 +578,14 @@ void Genode::Sandbox::Library::apply_config(Xml_node const &config)
 	_children.for_each_child([&] (Child &child) { child.apply_downgrade(); });
 	_children.for_each_child([&] (Child &child) { child.apply_upgrade(); });
 
+	_children.for_each_child([&] (Child const &) { reconfiguration.children++; });
+
+	if (start_known)
+		_state_reporter.with_curr_time_us([&] (uint64_t us) {
+			reconfiguration.duration_us = max(us - start_us, (uint64_t)1); });
+
+	_reconfiguration = reconfiguration;
+
 	if (_state_report_outdated)
 		_state_reporter.trigger_immediate_report_update();
 }
@@ -0,0 +1,353 @@
+/*
+ * \brief  Automatic placement of children within the affinity space
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__SANDBOX__PLACEMENT_H_
+#define _LIB__SANDBOX__PLACEMENT_H_
+
+/* Genode includes */
+#include <timer_session/connection.h>
+#include <trace_session/connection.h>
+#include <util/noncopyable.h>
+
+/* local includes */
+#include <report.h>
+#include <child_registry.h>
+
+namespace Sandbox { class Placement; }
+
+
+/**
+ * Assignment of affinity locations to children without '<affinity>' node
+ *
+ * With 'placement="auto"' specified at the '<affinity-space>' node, each
+ * child without an explicit affinity is assigned to one column of the
+ * affinity space, i.e., to one CPU core. The rows of the column are left to
+ * the child. Since the affinity space does not convey any topology beyond
+ * that, the rows are expected to correspond to the hardware threads of the
+ * core, which share the caches of the core.
+ *
+ * The column with the lowest load is chosen. The load of a column is the
+ * sum of the CPU quota of the children located at the column. If the
+ * 'measure' attribute is set to "yes", the load observed via a TRACE
+ * session is taken into account, which is determined from the execution
+ * time of the kernel's idle threads in the same way as done by the CPU
+ * balancer. The load is sampled every 'period_ms' (default 1000) and
+ * supersedes the declared load whenever it is higher. The measurement
+ * requires a TRACE session to be routed to init's parent. Ties are resolved
+ * by the number of children located at the column.
+ *
+ * Children that are already running retain their location. The placement is
+ * revised whenever a child is started or restarted.
+ */
+class Sandbox::Placement : Noncopyable
+{
+	public:
+
+		static constexpr unsigned MAX_CORES = 64;
+
+		/**
+		 * Load of one column of the affinity space
+		 */
+		struct Column
+		{
+			unsigned weight;    /* sum of declared CPU quota in percent */
+			unsigned children;  /* number of children located at the column */
+			unsigned load;      /* measured load in per-mille */
+
+			unsigned score() const { return max(weight, load/10); }
+
+			bool lower_than(Column const &other) const
+			{
+				return (score() != other.score()) ? score()  < other.score()
+				                                  : children < other.children;
+			}
+		};
+
+	private:
+
+		Env &_env;
+
+		Child_registry &_children;
+
+		Report_update_trigger &_report_update_trigger;
+
+		bool _enabled = false;
+
+		/* state report features the placement */
+		bool _reported = false;
+
+		Affinity::Space _space { 1, 1 };
+
+		/*
+		 * Measurement of the CPU load
+		 */
+		Constructible<Timer::Connection> _timer { };
+		Constructible<Trace::Connection> _trace { };
+
+		size_t _arg_quota = 12*4096;
+
+		uint64_t _period_ms = 0;
+
+		uint64_t _idle     [MAX_CORES] { };  /* idle time at last sample */
+		uint64_t _idle_max [MAX_CORES] { };  /* max idle time per period */
+		unsigned _load     [MAX_CORES] { };  /* load in per-mille */
+
+		Signal_handler<Placement> _timer_handler;
+
+		static uint64_t _time_value(Trace::Execution_time const &time)
+		{
+			return time.thread_context ? time.thread_context
+			                           : time.scheduling_context;
+		}
+
+		unsigned _width() const { return min(_space.width(), MAX_CORES); }
+
+		bool _construct_trace()
+		{
+			_trace.destruct();
+
+			try {
+				_trace.construct(_env, _arg_quota + 4*4096, _arg_quota);
+				return true;
+			}
+			catch (Service_denied) { }
+			catch (Out_of_ram)     { }
+			catch (Out_of_caps)    { }
+
+			warning("load measurement for placement of children unavailable");
+			return false;
+		}
+
+		/**
+		 * Update the load of each column from the idle times
+		 *
+		 * \return true if the load of any column changed
+		 */
+		bool _sample()
+		{
+			if (!_trace.constructed())
+				return false;
+
+			uint64_t idle[MAX_CORES] { };
+
+			auto const count = _trace->for_each_subject_info(
+				[&] (Trace::Subject_id const &, Trace::Subject_info const &info) {
+
+					if (info.session_label() != "kernel" || info.thread_name() != "idle")
+						return;
+
+					unsigned const x = info.affinity().xpos();
+					if (x < MAX_CORES)
+						idle[x] += _time_value(info.execution_time());
+				});
+
+			/* let the buffer grow with the number of trace subjects */
+			if (count.count == count.limit) {
+				_arg_quota += 4*4096;
+				_construct_trace();
+			}
+
+			/*
+			 * The maximum idle time observed per period approximates the
+			 * capacity of the core. Execution times are kernel-specific and
+			 * the periods are equally spaced, which makes a conversion to
+			 * absolute time unnecessary.
+			 */
+			bool changed = false;
+
+			for (unsigned x = 0; x < _width(); x++) {
+
+				uint64_t const diff = (idle[x] >= _idle[x]) ? idle[x] - _idle[x] : 0;
+
+				if (_idle[x])
+					_idle_max[x] = max(_idle_max[x], diff);
+
+				_idle[x] = idle[x];
+
+				uint64_t const capacity = _idle_max[x];
+
+				unsigned const load = capacity
+				                    ? unsigned((capacity - min(diff, capacity))*1000/capacity)
+				                    : 0;
+
+				if (load != _load[x])
+					changed = true;
+
+				_load[x] = load;
+			}
+			return changed;
+		}
+
+		void _handle_timer()
+		{
+			bool const load_changed = _sample();
+
+			if (_reported && load_changed)
+				_report_update_trigger.trigger_report_update();
+		}
+
+		void _disable_measurement()
+		{
+			_trace.destruct();
+			_timer.destruct();
+			_period_ms = 0;
+
+			for (unsigned x = 0; x < MAX_CORES; x++)
+				_idle[x] = _idle_max[x] = _load[x] = 0;
+		}
+
+		void _enable_measurement(uint64_t const period_ms)
+		{
+			if (!_trace.constructed() && !_construct_trace())
+				return;
+
+			if (!_timer.constructed()) {
+				_timer.construct(_env);
+				_timer->sigh(_timer_handler);
+			}
+
+			if (period_ms != _period_ms) {
+				_period_ms = period_ms;
+				_timer->trigger_periodic(_period_ms*1000);
+			}
+		}
+
+		/**
+		 * Call 'fn' with the 'Column' of each column of the affinity space
+		 */
+		void _for_each_column(auto const &fn) const
+		{
+			Column columns[MAX_CORES] { };
+
+			_children.for_each_child([&] (Child const &child) {
+
+				if (child.abandoned())
+					return;
+
+				Affinity const affinity = child.affinity();
+
+				if (affinity.space().width()  != _space.width()
+				 || affinity.space().height() != _space.height())
+					return;
+
+				/* children spanning the whole space do not unbalance the load */
+				Affinity::Location const location = affinity.location();
+				if (location.width() >= _space.width())
+					return;
+
+				for (unsigned x = unsigned(location.xpos());
+				     x < unsigned(location.xpos()) + location.width() && x < _width(); x++) {
+					columns[x].weight += child.cpu_quota().percent;
+					columns[x].children++;
+				}
+			});
+
+			for (unsigned x = 0; x < _width(); x++) {
+				columns[x].load = _load[x];
+				fn(x, columns[x]);
+			}
+		}
+
+	public:
+
+		Placement(Env &env, Child_registry &children,
+		          Report_update_trigger &report_update_trigger)
+		:
+			_env(env), _children(children),
+			_report_update_trigger(report_update_trigger),
+			_timer_handler(_env.ep(), *this, &Placement::_handle_timer)
+		{ }
+
+		void disable()
+		{
+			_enabled = false;
+			_disable_measurement();
+		}
+
+		/**
+		 * Apply the attributes of the '<affinity-space>' node
+		 */
+		void apply_config(Xml_node const &affinity_space)
+		{
+			Affinity::Space const space(affinity_space.attribute_value("width",  1u),
+			                            affinity_space.attribute_value("height", 1u));
+
+			/* measurements of a differently shaped space are meaningless */
+			if (space.width() != _space.width() || space.height() != _space.height())
+				_disable_measurement();
+
+			_space = space;
+
+			using Mode = String<8>;
+			_enabled = (affinity_space.attribute_value("placement", Mode()) == "auto")
+			        && (_space.width() > 1);
+
+			if (_enabled && affinity_space.attribute_value("measure", false))
+				_enable_measurement(affinity_space.attribute_value("period_ms", 1000UL));
+			else
+				_disable_measurement();
+		}
+
+		bool enabled() const { return _enabled; }
+
+		/**
+		 * Enable or disable report updates on load changes
+		 *
+		 * \param enabled  true if the state report features the placement
+		 */
+		void reported(bool enabled) { _reported = enabled; }
+
+		/**
+		 * Return location for a child that is about to be started
+		 *
+		 * The child is assigned all rows of the least loaded column.
+		 */
+		Affinity::Location location() const
+		{
+			unsigned best_x = 0;
+			Column   best   { };
+			bool     found  = false;
+
+			_for_each_column([&] (unsigned x, Column const &column) {
+				if (!found || column.lower_than(best)) {
+					best_x = x;
+					best   = column;
+					found  = true;
+				}
+			});
+
+			return Affinity::Location(best_x, 0, 1, _space.height());
+		}
+
+		void generate(Xml_generator &xml) const
+		{
+			if (!_enabled)
+				return;
+
+			xml.node("placement", [&] () {
+				xml.attribute("measured", _trace.constructed());
+
+				_for_each_column([&] (unsigned x, Column const &column) {
+					xml.node("cpu", [&] () {
+						xml.attribute("xpos",     x);
+						xml.attribute("weight",   column.weight);
+						xml.attribute("children", column.children);
+						if (_trace.constructed())
+							xml.attribute("load", column.load);
+					});
+				});
+			});
+		}
+};
+
+#endif /* _LIB__SANDBOX__PLACEMENT_H_ */
@@ -40,6 +40,8 @@ class Sandbox::Report_detail : Genode::Noncopyable
 		bool _child_caps   = false;
 		bool _init_ram     = false;
 		bool _init_caps    = false;
+		bool _reconfig     = false;
+		bool _placement    = false;
 
 	public:
 
@@ -56,6 +58,8 @@ class Sandbox::Report_detail : Genode::Noncopyable
 			_child_caps   = report.attribute_value("child_caps",   false);
 			_init_ram     = report.attribute_value("init_ram",     false);
 			_init_caps    = report.attribute_value("init_caps",    false);
+			_reconfig     = report.attribute_value("reconfiguration", false);
+			_placement    = report.attribute_value("placement",    false);
 		}
 
 		bool children()     const { return _children;     }
@@ -67,6 +71,8 @@ class Sandbox::Report_detail : Genode::Noncopyable
 		bool child_caps()   const { return _child_caps;   }
 		bool init_ram()     const { return _init_ram;     }
 		bool init_caps()    const { return _init_caps;    }
+		bool reconfig()     const { return _reconfig;     }
+		bool placement()    const { return _placement;    }
 };
 
 
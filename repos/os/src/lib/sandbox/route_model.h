@@ -69,9 +69,20 @@ class Sandbox::Route_model : Noncopyable
 			Service::Name      const &service;
 			Session_label      const &label;
 
+			/* part of the label following the child's name */
+			struct Scoped_label
+			{
+				char const *string;
+				size_t      len;
+
+				static Scoped_label from(char const *s) {
+					return { s, s ? strlen(s) : 0 }; }
+
+			} const scoped_label = Scoped_label::from(
+				skip_label_prefix(child.string(), label.string()));
+
 			Checksum const service_checksum { service };
-			Checksum const label_checksum   { skip_label_prefix(child.string(),
-			                                                    label.string()) };
+			Checksum const label_checksum   { scoped_label.string };
 
 			Query(Child_policy::Name const &child,
 			      Service::Name      const &service,
@@ -93,6 +104,8 @@ class Sandbox::Route_model : Noncopyable
 
 				Xml_node const _node; /* points to 'Route_model::_route_node' */
 
+				unsigned const _index; /* position within the route node */
+
 				struct Selector
 				{
 					using Label = String<Session_label::capacity()>;
@@ -102,8 +115,13 @@ class Sandbox::Route_model : Noncopyable
 						NO_LABEL, SPECIFIC_LABEL,
 
 						/*
-						 * Presence of 'label_last', 'label_prefix',
-						 * 'label_suffix', 'unscoped_label', or even
+						 * Presence of 'label_prefix' and/or 'label_suffix'
+						 * without any other label attribute
+						 */
+						LABEL_PREFIX_SUFFIX,
+
+						/*
+						 * Presence of 'label_last', 'unscoped_label', or
 						 * a combination of attributes.
 						 */
 						COMPLICATED
@@ -112,12 +130,36 @@ class Sandbox::Route_model : Noncopyable
 
 					Checksum label_checksum { "" };
 
+					/*
+					 * Raw attribute values of 'label_prefix' and
+					 * 'label_suffix', pointing into the XML node
+					 */
+					struct Raw_value
+					{
+						char const *start = nullptr;
+						size_t      len   = 0;
+
+						bool valid() const { return start != nullptr; }
+
+						bool prefix_of(char const *s, size_t s_len) const
+						{
+							return !valid()
+							    || (len <= s_len && strcmp(start, s, len) == 0);
+						}
+
+						bool suffix_of(char const *s, size_t s_len) const
+						{
+							return !valid()
+							    || (len <= s_len && strcmp(start, s + s_len - len, len) == 0);
+						}
+					};
+
+					Raw_value prefix { }, suffix { };
+
 					Selector(Xml_node const &node)
 					{
 						bool const complicated =
-							node.has_attribute("label_prefix") ||
-							node.has_attribute("label_suffix") ||
-							node.has_attribute("label_last")   ||
+							node.has_attribute("label_last") ||
 							node.has_attribute("unscoped_label");
 
 						if (complicated) {
@@ -125,12 +167,48 @@ class Sandbox::Route_model : Noncopyable
 							return;
 						}
 
+						bool const has_prefix = node.has_attribute("label_prefix"),
+						           has_suffix = node.has_attribute("label_suffix");
+
+						if (has_prefix || has_suffix) {
+
+							if (node.has_attribute("label")) {
+								type = Type::COMPLICATED;
+								return;
+							}
+
+							type = Type::LABEL_PREFIX_SUFFIX;
+
+							node.for_each_attribute([&] (Xml_attribute const &attr) {
+								attr.with_raw_value([&] (char const *start, size_t len) {
+									if (attr.has_type("label_prefix")) prefix = { start, len };
+									if (attr.has_type("label_suffix")) suffix = { start, len };
+								});
+							});
+							return;
+						}
+
 						Label const label = node.attribute_value("label", Label());
 						if (label.valid()) {
 							type           = Type::SPECIFIC_LABEL;
 							label_checksum = Checksum(label);
 						}
 					}
+
+					/**
+					 * Return true if the prefix/suffix selector definitely
+					 * mismatches the scoped label of the query
+					 */
+					bool prefix_suffix_mismatches(Query const &query) const
+					{
+						auto const &scoped = query.scoped_label;
+
+						if (!scoped.string)
+							return true;
+
+						return !prefix.prefix_of(scoped.string, scoped.len)
+						    || !suffix.suffix_of(scoped.string, scoped.len);
+					}
 				};
 
 				Selector const _selector;
@@ -152,9 +230,9 @@ class Sandbox::Route_model : Noncopyable
 				/**
 				 * Constructor is private to 'Route_model'
 				 */
-				Rule(Allocator &alloc, Xml_node const &node)
+				Rule(Allocator &alloc, Xml_node const &node, unsigned index)
 				:
-					_alloc(alloc), _node(node), _selector(node),
+					_alloc(alloc), _node(node), _index(index), _selector(node),
 					_service_checksum(node.attribute_value("name", Service::Name()))
 				{
 					Target const *at_ptr = nullptr;
@@ -189,6 +267,10 @@ class Sandbox::Route_model : Noncopyable
 					 && query.label_checksum != _selector.label_checksum)
 						return true;
 
+					if (_selector.type == Selector::Type::LABEL_PREFIX_SUFFIX
+					 && _selector.prefix_suffix_mismatches(query))
+						return true;
+
 					return false;
 				}
 
@@ -225,7 +307,64 @@ class Sandbox::Route_model : Noncopyable
 
 		Buffered_xml const _route_node;
 
-		List<Rule> _rules { };
+		/*
+		 * Index of the routing rules
+		 *
+		 * Rules that refer to a specific service are hashed by the checksum
+		 * of the service name. All other rules (e.g., 'any-service') are
+		 * kept in the '_wildcard_rules' list. Within each list, the rules
+		 * are ordered by their position within the route node. A query
+		 * merges the rules of the service's bucket with the wildcard rules,
+		 * which preserves the first-match semantics of the route node while
+		 * skipping the rules for unrelated services altogether.
+		 */
+		static constexpr unsigned NUM_BUCKETS = 32;
+
+		List<Rule> _service_rules[NUM_BUCKETS] { };
+		List<Rule> _wildcard_rules { };
+
+		static unsigned _bucket(Checksum const &checksum)
+		{
+			return (unsigned)(checksum.value % NUM_BUCKETS);
+		}
+
+		static void _destroy_rules(Allocator &alloc, List<Rule> &rules)
+		{
+			while (Rule *rule_ptr = rules.first()) {
+				rules.remove(rule_ptr);
+				destroy(alloc, rule_ptr);
+			}
+		}
+
+		/**
+		 * Cursor for traversing the rules that may apply to a query
+		 *
+		 * The cursor merges the rules of the query's service bucket with the
+		 * wildcard rules in the order of their appearance in the route node.
+		 */
+		struct Candidates
+		{
+			Rule const *s, *w;
+
+			Candidates(Route_model const &model, Query const &query)
+			:
+				s(query.service_checksum.valid
+				  ? model._service_rules[_bucket(query.service_checksum)].first()
+				  : nullptr),
+				w(model._wildcard_rules.first())
+			{ }
+
+			Rule const *next()
+			{
+				Rule const *r = nullptr;
+				if (s && (!w || s->_index < w->_index)) {
+					r = s; s = s->next();
+				} else if (w) {
+					r = w; w = w->next();
+				}
+				return r;
+			}
+		};
 
 	public:
 
@@ -233,26 +372,39 @@ class Sandbox::Route_model : Noncopyable
 		:
 			_alloc(alloc), _route_node(_alloc, route)
 		{
-			Rule const *at_ptr = nullptr;
+			Rule const *service_at_ptr[NUM_BUCKETS] { };
+			Rule const *wildcard_at_ptr = nullptr;
+
+			unsigned index = 0;
 			_route_node.xml().for_each_sub_node([&] (Xml_node const &node) {
-				Rule &rule = *new (_alloc) Rule(_alloc, node);
-				_rules.insert(&rule, at_ptr); /* append */
-				at_ptr = &rule;
+				Rule &rule = *new (_alloc) Rule(_alloc, node, index++);
+
+				/* append rule to the corresponding list */
+				if (rule._specific_service) {
+					unsigned const bucket = _bucket(rule._service_checksum);
+					_service_rules[bucket].insert(&rule, service_at_ptr[bucket]);
+					service_at_ptr[bucket] = &rule;
+				} else {
+					_wildcard_rules.insert(&rule, wildcard_at_ptr);
+					wildcard_at_ptr = &rule;
+				}
 			});
 		}
 
 		~Route_model()
 		{
-			while (Rule *rule_ptr = _rules.first()) {
-				_rules.remove(rule_ptr);
-				destroy(_alloc, rule_ptr);
-			}
+			for (List<Rule> &rules : _service_rules)
+				_destroy_rules(_alloc, rules);
+
+			_destroy_rules(_alloc, _wildcard_rules);
 		}
 
 		template <typename FN>
 		Child_policy::Route resolve(Query const &query, FN const &fn) const
 		{
-			for (Rule const *r = _rules.first(); r; r = r->next())
+			Candidates candidates(*this, query);
+
+			while (Rule const *r = candidates.next())
 				if (r->matches(query)) {
 					try {
 						return r->resolve(fn);
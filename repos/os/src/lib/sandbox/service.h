@@ -87,6 +87,9 @@ class Sandbox::Routed_service : public Async_service, public Abandonable
 
 		Registry<Routed_service>::Element _registry_element;
 
+		/* availability as last observed by 'Service_changes::import' */
+		bool _observed_available = false;
+
 	public:
 
 		/**
@@ -115,6 +118,10 @@ class Sandbox::Routed_service : public Async_service, public Abandonable
 
 		Session_state::Factory &factory() { return _factory; }
 
+		bool observed_available() const { return _observed_available; }
+
+		void observed_available(bool available) { _observed_available = available; }
+
 		/**
 		 * Ram_transfer::Account interface
 		 */
@@ -0,0 +1,98 @@
+/*
+ * \brief  Tracking of appearing and disappearing child services
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__SANDBOX__SERVICE_CHANGES_H_
+#define _LIB__SANDBOX__SERVICE_CHANGES_H_
+
+/* Genode includes */
+#include <util/dictionary.h>
+
+/* local includes */
+#include <types.h>
+#include <service.h>
+
+namespace Sandbox { class Service_changes; }
+
+
+/**
+ * Set of names of child services that appeared or disappeared
+ *
+ * A session depends on all services of the same name because a newly
+ * appearing service may change the route of the session. Hence, the
+ * dependencies of a child are affected only if the service name of any of
+ * its sessions is contained in the set.
+ */
+class Sandbox::Service_changes : Noncopyable
+{
+	private:
+
+		Allocator &_alloc;
+
+		struct Entry : Dictionary<Entry, Service::Name>::Element
+		{
+			using Element::Element;
+		};
+
+		Dictionary<Entry, Service::Name> _entries { };
+
+		bool _any = false;
+
+		void _record(Service::Name const &name)
+		{
+			_any = true;
+
+			if (!_entries.exists(name))
+				new (_alloc) Entry(_entries, name);
+		}
+
+	public:
+
+		Service_changes(Allocator &alloc) : _alloc(alloc) { }
+
+		~Service_changes() { clear(); }
+
+		void clear()
+		{
+			while (_entries.with_any_element([&] (Entry &e) {
+				destroy(_alloc, &e); }));
+
+			_any = false;
+		}
+
+		/**
+		 * Record the services of the registry that changed their
+		 * availability since the previous call
+		 */
+		void import(Registry<Routed_service> &services)
+		{
+			services.for_each([&] (Routed_service &service) {
+
+				bool const available = !service.abandoned();
+
+				if (service.observed_available() == available)
+					return;
+
+				service.observed_available(available);
+				_record(service.name());
+			});
+		}
+
+		bool any() const { return _any; }
+
+		bool contains(Service::Name const &name) const
+		{
+			return _entries.exists(name);
+		}
+};
+
+#endif /* _LIB__SANDBOX__SERVICE_CHANGES_H_ */
@@ -173,6 +173,18 @@ class Sandbox::State_reporter : public Report_update_trigger
 			}
 		}
 
+		/**
+		 * Return current time in microseconds
+		 *
+		 * The time is available only if the report is rate-limited via
+		 * 'delay_ms'. Otherwise, the sandbox does not use a timer.
+		 */
+		void with_curr_time_us(auto const &fn)
+		{
+			if (_timer.constructed())
+				fn(_timer->elapsed_us());
+		}
+
 		void trigger_report_update() override
 		{
 			if (!_scheduled && _timer.constructed() && _report_delay_ms) {
@@ -17,6 +17,8 @@
 
 /* Genode includes */
 #include <base/allocator_avl.h>
+#include <base/registry.h>
+#include <util/construct_at.h>
 #include <block_session/connection.h>
 #include <util/xml_generator.h>
 #include <vfs/dir_file_system.h>
@@ -31,12 +33,238 @@ struct Vfs::Block_file_system
 {
 	using Name = String<64>;
 
+	struct Job;
+
+	using Block_connection = Block::Connection<Job>;
+
+	struct Cache_block;
+	class  Cache;
 	struct Local_factory;
 	struct Data_file_system;
 	struct Compound_file_system;
 };
 
 
+/**
+ * Block kept in memory for read-modify-write and write-back
+ */
+struct Vfs::Block_file_system::Cache_block
+{
+	/* FAILED marks a block whose original content could not be read */
+	enum class State { UNUSED, FILLING, CLEAN, DIRTY, FLUSHING, FAILED };
+
+	State                 state     = State::UNUSED;
+	Block::block_number_t number    = 0;
+	Genode::uint64_t      last_used = 0;
+	char                 *data      = nullptr;
+
+	/* set if the block got modified while being written back */
+	bool redirty = false;
+
+	bool valid() const
+	{
+		return state == State::CLEAN || state == State::DIRTY
+		    || state == State::FLUSHING;
+	}
+};
+
+
+/**
+ * Block operation issued by the data file system
+ */
+struct Vfs::Block_file_system::Job : Block_connection::Job
+{
+	enum class Purpose {
+		READ,   /* read into job buffer on behalf of a handle */
+		WRITE,  /* write-through of the job buffer */
+		FILL,   /* read of a cache block */
+		FLUSH,  /* write-back of a cache block */
+		SYNC };
+
+	Genode::Registry<Job>::Element _element;
+
+	Genode::Allocator &_alloc;
+
+	Purpose const purpose;
+
+	Cache_block * const block;
+
+	size_t const bytes;
+
+	char * const _buffer = bytes ? (char *)_alloc.alloc(bytes) : nullptr;
+
+	bool success = false;
+
+	/* set once the handle that issued a READ or SYNC job is closed */
+	bool orphaned = false;
+
+	Job(Block_connection      &connection,
+	    Genode::Registry<Job> &registry,
+	    Genode::Allocator     &alloc,
+	    Purpose                purpose,
+	    Block::Operation       operation,
+	    Cache_block           *block,
+	    size_t                 bytes)
+	:
+		Block_connection::Job(connection, operation),
+		_element(registry, *this), _alloc(alloc),
+		purpose(purpose), block(block), bytes(bytes)
+	{ }
+
+	~Job() { if (_buffer) _alloc.free(_buffer, bytes); }
+
+	char *data() { return block ? block->data : _buffer; }
+
+	bool writes() const {
+		return purpose == Purpose::WRITE || purpose == Purpose::FLUSH; }
+
+	bool overlaps(Block::block_number_t first, Block::block_count_t count) const
+	{
+		Block::Operation const op = operation();
+
+		return Block::Operation::has_payload(op.type)
+		    && op.block_number < first + count
+		    && first < op.block_number + op.count;
+	}
+
+	/**
+	 * Return true if the file system may destroy the completed job
+	 */
+	bool disposable() const
+	{
+		return completed() && (orphaned || purpose == Purpose::WRITE
+		                                || purpose == Purpose::FILL
+		                                || purpose == Purpose::FLUSH);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Job(Job const &);
+		Job &operator = (Job const &);
+};
+
+
+/**
+ * Bounded set of in-memory blocks
+ */
+class Vfs::Block_file_system::Cache
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Cache(Cache const &);
+		Cache &operator = (Cache const &);
+
+		Genode::Allocator &_alloc;
+
+		size_t   const _block_size;
+		unsigned const _capacity;
+
+		char * const _data = (char *)_alloc.alloc(_capacity*_block_size);
+
+		Cache_block * const _blocks =
+			(Cache_block *)_alloc.alloc(_capacity*sizeof(Cache_block));
+
+		Genode::uint64_t _now = 0;
+
+		using State = Cache_block::State;
+
+	public:
+
+		Cache(Genode::Allocator &alloc, size_t block_size, unsigned capacity)
+		:
+			_alloc(alloc), _block_size(block_size),
+			_capacity(Genode::max(capacity, 1U))
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				Genode::construct_at<Cache_block>(&_blocks[i])->data =
+					_data + i*_block_size;
+		}
+
+		~Cache()
+		{
+			_alloc.free(_blocks, _capacity*sizeof(Cache_block));
+			_alloc.free(_data,   _capacity*_block_size);
+		}
+
+		unsigned capacity() const { return _capacity; }
+
+		void for_each(auto const &fn)
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_blocks[i].state != State::UNUSED)
+					fn(_blocks[i]);
+		}
+
+		Cache_block *lookup(Block::block_number_t number)
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_blocks[i].state != State::UNUSED && _blocks[i].number == number)
+					return &_blocks[i];
+
+			return nullptr;
+		}
+
+		/**
+		 * Assign unused, failed, or least-recently used clean block to 'number'
+		 *
+		 * \return nullptr if all blocks are dirty or busy
+		 */
+		Cache_block *alloc(Block::block_number_t number)
+		{
+			Cache_block *victim = nullptr;
+
+			for (unsigned i = 0; i < _capacity; i++) {
+				Cache_block &block = _blocks[i];
+
+				if (block.state == State::UNUSED) {
+					victim = &block;
+					break;
+				}
+
+				if (block.state == State::CLEAN || block.state == State::FAILED)
+					if (!victim || block.last_used < victim->last_used)
+						victim = &block;
+			}
+
+			if (victim) {
+				victim->state   = State::UNUSED;
+				victim->number  = number;
+				victim->redirty = false;
+				touch(*victim);
+			}
+			return victim;
+		}
+
+		void touch(Cache_block &block) { block.last_used = ++_now; }
+
+		unsigned count(State state) const
+		{
+			unsigned result = 0;
+			for (unsigned i = 0; i < _capacity; i++)
+				if (_blocks[i].state == state)
+					result++;
+			return result;
+		}
+};
+
+
+/**
+ * Data file of the block device
+ *
+ * Block I/O is performed asynchronously. Reads are issued by 'queue_read' and
+ * picked up by 'complete_read'. Writes of whole blocks are submitted as
+ * write-through jobs. Partial blocks are staged in a bounded cache of
+ * 'block_buffer_count' blocks, which are written back right away. With
+ * 'write_back="yes"', all writes are absorbed by the cache, which is flushed
+ * when it becomes half full and by 'sync'. Errors of asynchronous writes are
+ * reported by the next 'sync'.
+ */
 class Vfs::Block_file_system::Data_file_system : public Single_file_system
 {
 	private:
@@ -47,291 +275,569 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 		Data_file_system(Data_file_system const &);
 		Data_file_system &operator = (Data_file_system const &);
 
-		Vfs::Env &_env;
+		using block_number_t = Block::block_number_t;
+		using block_count_t  = Block::block_count_t;
+		using Purpose        = Job::Purpose;
+		using State          = Cache_block::State;
 
-		char     *_block_buffer;
-		unsigned  _block_buffer_count;
+		/*
+		 * Upper bound of bytes read or written per job, which keeps the
+		 * job-local buffers within the size of the packet-stream buffer
+		 */
+		enum { MAX_JOB_BYTES = 64*1024 };
+
+		Vfs::Env &_env;
 
-		Block::Connection<>        &_block;
+		Block_connection           &_block;
 		Block::Session::Info const &_info;
-		Block::Session::Tx::Source *_tx_source;
 
-		bool const _writeable;
+		size_t const _block_size = _info.block_size;
 
-		class Block_vfs_handle : public Single_vfs_handle
+		bool     const _writeable;
+		bool     const _write_back;
+		unsigned const _max_jobs;
+
+		Genode::Registry<Job> _jobs { };
+
+		unsigned _num_jobs = 0;
+
+		Cache _cache;
+
+		/* asynchronous write failed since the last sync */
+		bool _write_error = false;
+
+		file_size _device_size() const
 		{
-			private:
+			return _info.block_count * _block_size;
+		}
+
+		bool _conflicting_job(block_number_t first, block_count_t count,
+		                      bool writes_only)
+		{
+			bool result = false;
+			_jobs.for_each([&] (Job const &job) {
+				if (!job.completed() && job.overlaps(first, count)
+				 && (!writes_only || job.writes()))
+					result = true; });
+			return result;
+		}
+
+		/**
+		 * Create job if the number of outstanding jobs permits
+		 */
+		Job *_try_create_job(Purpose purpose, Block::Operation::Type type,
+		                     block_number_t first, block_count_t count,
+		                     Cache_block *block)
+		{
+			if (_num_jobs >= _max_jobs)
+				return nullptr;
+
+			/*
+			 * Writes must not overtake other operations on the same blocks
+			 * and reads must not overtake writes.
+			 */
+			bool const writes = (type == Block::Operation::Type::WRITE);
+			if (type != Block::Operation::Type::SYNC
+			 && _conflicting_job(first, count, !writes))
+				return nullptr;
+
+			size_t const bytes = block ? 0 : size_t(count*_block_size);
+
+			Block::Operation const operation { .type         = type,
+			                                   .block_number = first,
+			                                   .count        = count };
+			_num_jobs++;
+			return new (_env.alloc())
+				Job(_block, _jobs, _env.alloc(), purpose, operation, block, bytes);
+		}
+
+		void _destroy(Job &job)
+		{
+			_num_jobs--;
+			destroy(_env.alloc(), &job);
+		}
+
+		/**
+		 * Release job owned by a handle
+		 */
+		void _release(Job *job)
+		{
+			if (!job)
+				return;
+
+			if (job->completed())
+				_destroy(*job);
+			else
+				job->orphaned = true;
+		}
+
+		void _completed(Job &job, bool success)
+		{
+			job.success = success;
+
+			switch (job.purpose) {
+
+			case Purpose::FILL:
+
+				if (!success)
+					Genode::error("vfs_block: could not read block ", job.block->number);
+
+				job.block->state = success ? State::CLEAN : State::FAILED;
+				break;
 
-				Genode::Entrypoint                &_ep;
-				Genode::Allocator                 &_alloc;
-				char                              *_block_buffer;
-				unsigned                          &_block_buffer_count;
-				Block::Connection<>               &_block;
-				size_t                       const _block_size;
-				Block::sector_t              const _block_count;
-				Block::Session::Tx::Source        *_tx_source;
-				bool                         const _writeable;
-
-				void _block_for_ack()
+			case Purpose::FLUSH:
+
+				job.block->state   = job.block->redirty ? State::DIRTY : State::CLEAN;
+				job.block->redirty = false;
+				[[fallthrough]];
+
+			case Purpose::WRITE:
+
+				if (!success) {
+					Genode::error("vfs_block: could not write block(s) at ",
+					              job.operation().block_number);
+					_write_error = true;
+				}
+				break;
+
+			case Purpose::READ:
+			case Purpose::SYNC:
+				break;
+			}
+		}
+
+		/**
+		 * Issue write-back of dirty cache blocks
+		 *
+		 * \return true if new jobs were created
+		 */
+		bool _flush(bool all)
+		{
+			if (_write_back && !all && _cache.count(State::DIRTY) <= _cache.capacity()/2)
+				return false;
+
+			bool progress = false;
+			_cache.for_each([&] (Cache_block &block) {
+				if (block.state != State::DIRTY)
+					return;
+
+				if (_try_create_job(Purpose::FLUSH, Block::Operation::Type::WRITE,
+				                    block.number, 1, &block)) {
+					block.state = State::FLUSHING;
+					progress = true;
+				}
+			});
+			return progress;
+		}
+
+		void _update_jobs(bool flush_all = false)
+		{
+			struct Update_jobs_policy
+			{
+				Data_file_system &_fs;
+
+				void produce_write_content(Job &job, Genode::off_t offset,
+				                           char *dst, size_t length)
 				{
-					while (!_tx_source->ack_avail())
-						_ep.wait_and_dispatch_one_io_signal();
+					Genode::memcpy(dst, job.data() + offset, length);
 				}
 
-				/*
-				 * Noncopyable
-				 */
-				Block_vfs_handle(Block_vfs_handle const &);
-				Block_vfs_handle &operator = (Block_vfs_handle const &);
+				void consume_read_result(Job &job, Genode::off_t offset,
+				                         char const *src, size_t length)
+				{
+					Genode::memcpy(job.data() + offset, src, length);
+				}
 
-				size_t _block_io(file_size nr, void *buf, file_size sz,
-				                 bool write, bool bulk = false)
+				void completed(Job &job, bool success)
 				{
-					Block::Packet_descriptor::Opcode op;
-					op = write ? Block::Packet_descriptor::WRITE : Block::Packet_descriptor::READ;
+					_fs._completed(job, success);
+				}
 
-					size_t packet_count = bulk ? (size_t)(sz / _block_size) : 1;
+			} policy { *this };
 
-					Block::Packet_descriptor packet;
+			for (;;) {
+				_block.update_jobs(policy);
 
-					/* sanity check */
-					if (packet_count > _block_buffer_count) {
-						packet_count = _block_buffer_count;
-					}
+				_jobs.for_each([&] (Job &job) {
+					if (job.disposable())
+						_destroy(job); });
 
-					while (true) {
-						try {
-							packet = _block.alloc_packet(packet_count * _block_size);
-							break;
-						} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				if (!_flush(flush_all || !_write_back))
+					break;
+			}
+		}
 
-							while (!_tx_source->ready_to_submit())
-								_ep.wait_and_dispatch_one_io_signal();
+		/**
+		 * Copy valid cache content over data read from the device
+		 */
+		void _apply_cache(block_number_t first, block_count_t count, char *dst)
+		{
+			_cache.for_each([&] (Cache_block &block) {
+				if (block.valid() && block.number >= first
+				 && block.number < first + count)
+					Genode::memcpy(dst + (block.number - first)*_block_size,
+					               block.data, _block_size); });
+		}
 
-							if (packet_count > 1) {
-								packet_count /= 2;
-							}
-						}
+		bool _cached(block_number_t first, block_count_t count)
+		{
+			for (block_count_t i = 0; i < count; i++) {
+				Cache_block const *block = _cache.lookup(first + i);
+				if (!block || !block->valid())
+					return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Write whole blocks without staging them in the cache
+		 *
+		 * \return false if the write cannot be issued now
+		 */
+		bool _try_write_through(block_number_t first, block_count_t count,
+		                        char const *src)
+		{
+			/* cache blocks in flight are covered by the conflict check */
+			Job *job = _try_create_job(Purpose::WRITE, Block::Operation::Type::WRITE,
+			                           first, count, nullptr);
+			if (!job)
+				return false;
+
+			Genode::memcpy(job->data(), src, size_t(count*_block_size));
+
+			/* keep cached copies coherent, superseding pending modifications */
+			_cache.for_each([&] (Cache_block &block) {
+				if (block.valid() && block.number >= first
+				 && block.number < first + count) {
+					Genode::memcpy(block.data,
+					               src + (block.number - first)*_block_size,
+					               _block_size);
+					block.state = State::CLEAN;
+				}
+			});
+			return true;
+		}
+
+		/**
+		 * Release cache block whose read-modify-write fill failed
+		 *
+		 * \return true if the fill of the block failed
+		 */
+		bool _release_failed_fill(block_number_t number)
+		{
+			Cache_block *block = _cache.lookup(number);
+			if (!block || block->state != State::FAILED)
+				return false;
+
+			block->state = State::UNUSED;
+			return true;
+		}
+
+		/**
+		 * Stage partial or whole block in the cache
+		 *
+		 * \return false if the block is not available yet
+		 */
+		bool _try_write_cached(block_number_t number, size_t offset,
+		                       char const *src, size_t length)
+		{
+			Cache_block *block = _cache.lookup(number);
+
+			if (!block) {
+				block = _cache.alloc(number);
+				if (!block) {
+					_flush(true);
+					return false;
+				}
+
+				if (length < _block_size) {
+
+					/* read-modify-write, fetch original block content first */
+					if (!_try_create_job(Purpose::FILL, Block::Operation::Type::READ,
+					                     number, 1, block)) {
+						block->state = State::UNUSED;
+						return false;
 					}
+					block->state = State::FILLING;
+					return false;
+				}
+
+				block->state = State::CLEAN;
+			}
+
+			switch (block->state) {
+			case State::UNUSED:
+			case State::FILLING:
+			case State::FAILED:
+				return false;
+
+			case State::CLEAN:
+			case State::DIRTY:
+				block->state = State::DIRTY;
+				break;
 
-					Block::Packet_descriptor p(packet, op, nr, packet_count);
+			case State::FLUSHING:
+				block->redirty = true;
+				break;
+			}
+
+			Genode::memcpy(block->data + offset, src, length);
+			_cache.touch(*block);
+			return true;
+		}
 
-					if (write)
-						Genode::memcpy(_tx_source->packet_content(p), buf, packet_count * _block_size);
+		class Block_vfs_handle : public Single_vfs_handle
+		{
+			private:
 
-					_tx_source->submit_packet(p);
+				Data_file_system &_fs;
 
-					_block_for_ack();
+				/*
+				 * Read request as issued by 'queue_read'
+				 */
+				Job      *_read_job    = nullptr;
+				file_size _read_offset = 0;
+				size_t    _read_count  = 0;
 
-					p = _tx_source->get_acked_packet();
+				Job *_sync_job = nullptr;
 
-					if (!p.succeeded()) {
-						Genode::error("Could not read block(s)");
-						_tx_source->release_packet(p);
+				/*
+				 * Noncopyable
+				 */
+				Block_vfs_handle(Block_vfs_handle const &);
+				Block_vfs_handle &operator = (Block_vfs_handle const &);
+
+				size_t _clamped_read_count(size_t count) const
+				{
+					file_size const size = _fs._device_size();
+
+					if (seek() >= size)
 						return 0;
-					}
 
-					if (!write)
-						Genode::memcpy(buf, _tx_source->packet_content(p), packet_count * _block_size);
+					return size_t(Genode::min(file_size(count),
+					                          Genode::min(size - seek(),
+					                                      file_size(MAX_JOB_BYTES))));
+				}
+
+				block_number_t _first_block() const {
+					return _read_offset / _fs._block_size; }
 
-					_tx_source->release_packet(p);
-					return packet_count * _block_size;
+				block_count_t _num_blocks() const
+				{
+					return (_read_offset + _read_count - 1)/_fs._block_size
+					     - _first_block() + 1;
 				}
 
 			public:
 
-				Block_vfs_handle(Directory_service                 &ds,
-				                 File_io_service                   &fs,
-				                 Genode::Entrypoint                &ep,
-				                 Genode::Allocator                 &alloc,
-				                 char                              *block_buffer,
-				                 unsigned                          &block_buffer_count,
-				                 Block::Connection<>               &block,
-				                 size_t                             block_size,
-				                 Block::sector_t                    block_count,
-				                 Block::Session::Tx::Source        *tx_source,
-				                 bool                               writeable)
+				Block_vfs_handle(Directory_service &ds,
+				                 File_io_service   &fs,
+				                 Genode::Allocator &alloc,
+				                 Data_file_system  &data_fs)
 				:
-					Single_vfs_handle(ds, fs, alloc, 0),
-					_ep(ep),
-					_alloc(alloc),
-					_block_buffer(block_buffer),
-					_block_buffer_count(block_buffer_count),
-					_block(block),
-					_block_size(block_size),
-					_block_count(block_count),
-					_tx_source(tx_source),
-					_writeable(writeable)
+					Single_vfs_handle(ds, fs, alloc, 0), _fs(data_fs)
 				{ }
 
+				~Block_vfs_handle()
+				{
+					_fs._release(_read_job);
+					_fs._release(_sync_job);
+				}
+
+				bool queue_read(size_t count) override
+				{
+					size_t const clamped_count = _clamped_read_count(count);
+
+					if (_read_job) {
+						if (_read_offset == seek() && _read_count == clamped_count)
+							return true;
+
+						/* request superseded by a read at another position */
+						_fs._release(_read_job);
+						_read_job = nullptr;
+					}
+
+					_read_offset = seek();
+					_read_count  = clamped_count;
+
+					if (!_read_count || _fs._cached(_first_block(), _num_blocks()))
+						return true;
+
+					_read_job = _fs._try_create_job(Purpose::READ,
+					                                Block::Operation::Type::READ,
+					                                _first_block(), _num_blocks(),
+					                                nullptr);
+					if (!_read_job)
+						return false;
+
+					_fs._update_jobs();
+					return true;
+				}
+
 				Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 				{
-					file_size seek_offset = seek();
-
-					size_t count = dst.num_bytes;
-					size_t read = 0;
-
-					while (count > 0) {
-						file_size displ   = 0;
-						file_size blk_nr  = seek_offset / _block_size;
-
-						size_t length = 0;
-
-						displ = seek_offset % _block_size;
-
-						if ((displ + count) > _block_size)
-							length = size_t(_block_size - displ);
-						else
-							length = count;
-
-						/*
-						 * We take a shortcut and read the blocks all at once if the
-						 * offset is aligned on a block boundary and the count is a
-						 * multiple of the block size, e.g. 4K reads will be read at
-						 * once.
-						 *
-						 * XXX this is quite hackish because we have to omit partial
-						 * blocks at the end.
-						 */
-						if (displ == 0 && !(count < _block_size)) {
-							file_size bytes_left = count - (count % _block_size);
-
-							size_t const nbytes = _block_io(blk_nr, dst.start + read, bytes_left, false, true);
-							if (nbytes == 0) {
-								Genode::error("error while reading block:", blk_nr, " from block device");
-								return READ_ERR_INVALID;
-							}
-
-							read  += nbytes;
-							count -= nbytes;
-							seek_offset += nbytes;
+					out_count = 0;
 
-							continue;
-						}
+					if (!queue_read(dst.num_bytes))
+						return READ_QUEUED;
 
-						size_t const nbytes = _block_io(blk_nr, _block_buffer, _block_size, false);
-						if (nbytes != _block_size) {
-							Genode::error("error while reading block:", blk_nr, " from block device");
-							return READ_ERR_INVALID;
-						}
+					if (_read_job && !_read_job->completed()) {
+						_fs._update_jobs();
+						if (!_read_job->completed())
+							return READ_QUEUED;
+					}
+
+					size_t const count = Genode::min(dst.num_bytes, _read_count);
+
+					/* end of device */
+					if (!count)
+						return READ_OK;
+
+					block_number_t const first = _first_block();
+					block_count_t  const num   = _num_blocks();
+
+					/* all blocks are present in the cache */
+					if (!_read_job) {
+						for (block_count_t i = 0; i < num; i++) {
+							Cache_block const &block = *_fs._cache.lookup(first + i);
 
-						Genode::memcpy(dst.start + read, _block_buffer + displ, length);
+							file_size const block_start = (first + i)*_fs._block_size;
+							file_size const start = Genode::max(block_start, _read_offset);
+							file_size const end   = Genode::min(block_start + _fs._block_size,
+							                                    _read_offset + count);
 
-						read  += length;
-						count -= length;
-						seek_offset += length;
+							Genode::memcpy(dst.start + (start - _read_offset),
+							               block.data + (start - block_start),
+							               size_t(end - start));
+						}
+						out_count = count;
+						return READ_OK;
+					}
+
+					bool const ok = _read_job->success;
+					if (ok) {
+						/* cached blocks may be newer than the device content */
+						_fs._apply_cache(first, num, _read_job->data());
+						Genode::memcpy(dst.start,
+						               _read_job->data() + _read_offset % _fs._block_size,
+						               count);
 					}
 
-					out_count = read;
+					_fs._destroy(*_read_job);
+					_read_job = nullptr;
 
-					return READ_OK;
+					if (!ok) {
+						Genode::error("error while reading block:", first, " from block device");
+						return READ_ERR_IO;
+					}
 
+					out_count = count;
+					return READ_OK;
 				}
 
 				Write_result write(Const_byte_range_ptr const &src, size_t &out_count) override
 				{
-					if (!_writeable) {
+					out_count = 0;
+
+					if (!_fs._writeable) {
 						Genode::error("block device is not writeable");
 						return WRITE_ERR_INVALID;
 					}
 
-					file_size seek_offset = seek();
+					file_size const size = _fs._device_size();
+					size_t    const bs   = _fs._block_size;
 
-					size_t written = 0;
-					size_t count = src.num_bytes;
+					if (seek() >= size)
+						return WRITE_ERR_INVALID;
 
-					while (count > 0) {
-						file_size displ  = 0;
-						file_size blk_nr = seek_offset / _block_size;
+					size_t const count = size_t(Genode::min(file_size(src.num_bytes),
+					                                        size - seek()));
+					if (!count)
+						return WRITE_OK;
 
-						size_t length = 0;
+					size_t written  = 0;
+					bool   io_error = false;
 
-						displ = seek_offset % _block_size;
+					while (written < count) {
 
-						if ((displ + count) > _block_size)
-							length = size_t(_block_size - displ);
-						else
-							length = count;
+						file_size      const pos    = seek() + written;
+						block_number_t const number = pos / bs;
+						size_t         const offset = size_t(pos % bs);
+						size_t         const left   = count - written;
 
-						/*
-						 * We take a shortcut and write as much as possible without
-						 * using the block buffer if the offset is aligned on a block
-						 * boundary and the count is a multiple of the block size,
-						 * e.g. 4K writes will be written at once.
-						 *
-						 * XXX this is quite hackish because we have to omit partial
-						 * blocks at the end.
-						 */
-						if (displ == 0 && !(count < _block_size)) {
-							file_size bytes_left = count - (count % _block_size);
+						if (!_fs._write_back && offset == 0 && left >= bs) {
 
-							size_t const nbytes = _block_io(blk_nr, (void*)(src.start + written),
-							                                bytes_left, true, true);
-							if (nbytes == 0) {
-								Genode::error("error while write block:", blk_nr, " to block device");
-								return WRITE_ERR_INVALID;
-							}
+							block_count_t const num =
+								Genode::min(left, size_t(MAX_JOB_BYTES)) / bs;
 
-							written     += nbytes;
-							count       -= nbytes;
-							seek_offset += nbytes;
+							if (!_fs._try_write_through(number, num, src.start + written))
+								break;
 
+							written += size_t(num*bs);
 							continue;
 						}
 
-						/*
-						 * The offset is not aligned on a block boundary. Therefore
-						 * we need to read the block to the block buffer first and
-						 * put the buffer content at the right offset before we can
-						 * write the whole block back. In addition if length is less
-						 * than block size, we also have to read the block first.
-						 */
-						if (displ > 0 || length < _block_size)
-							_block_io(blk_nr, _block_buffer, _block_size, false);
-
-						Genode::memcpy(_block_buffer + displ, src.start + written, length);
-
-						size_t const nbytes = _block_io(blk_nr, _block_buffer, _block_size, true);
-						if (nbytes != _block_size) {
-							Genode::error("error while writing block:", blk_nr, " to block_device");
-							return WRITE_ERR_INVALID;
+						size_t const length = Genode::min(bs - offset, left);
+
+						if (!_fs._try_write_cached(number, offset, src.start + written, length)) {
+
+							/* a failed fill is reported once nothing else got written */
+							io_error = !written && _fs._release_failed_fill(number);
+							break;
 						}
 
-						written     += length;
-						count       -= length;
-						seek_offset += length;
+						written += length;
 					}
 
-					out_count = written;
+					_fs._update_jobs();
 
-					return WRITE_OK;
+					if (io_error)
+						return WRITE_ERR_IO;
+
+					if (!written)
+						return WRITE_ERR_WOULD_BLOCK;
 
+					out_count = written;
+					return WRITE_OK;
 				}
 
 				Sync_result sync() override
 				{
-					/*
-					 * Just in case bail if we cannot submit the packet.
-					 * (Since the plugin operates in a synchronous fashion
-					 * that should not happen.)
-					 */
-					if (!_tx_source->ready_to_submit()) {
-						Genode::error("vfs_block: could not sync blocks");
-						return SYNC_ERR_INVALID;
+					/* write back all modified blocks before syncing the device */
+					_fs._update_jobs(true);
+
+					bool writes_in_flight = false;
+					_fs._jobs.for_each([&] (Job const &job) {
+						if (job.writes() && !job.completed())
+							writes_in_flight = true; });
+
+					if (writes_in_flight || _fs._cache.count(State::DIRTY))
+						return SYNC_QUEUED;
+
+					if (!_sync_job) {
+						_sync_job = _fs._try_create_job(Purpose::SYNC,
+						                                Block::Operation::Type::SYNC,
+						                                0, _fs._info.block_count,
+						                                nullptr);
+						if (!_sync_job)
+							return SYNC_QUEUED;
+
+						_fs._update_jobs();
 					}
 
-					Block::Packet_descriptor p =
-						Block::Session::sync_all_packet_descriptor(
-							_block.info(), Block::Session::Tag { 0 });
-
-					_tx_source->submit_packet(p);
+					if (!_sync_job->completed())
+						return SYNC_QUEUED;
 
-					_block_for_ack();
+					bool const ok = _sync_job->success;
+					_fs._destroy(*_sync_job);
+					_sync_job = nullptr;
 
-					p = _tx_source->get_acked_packet();
-					_tx_source->release_packet(p);
+					if (_fs._write_error) {
+						_fs._write_error = false;
+						return SYNC_ERR_INVALID;
+					}
 
-					if (!p.succeeded()) {
+					if (!ok) {
 						/* only warn once if sync is not supported */
 						static bool print_sync_failed = true;
 						if (print_sync_failed) {
@@ -350,32 +856,49 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 
 	public:
 
+		struct Config
+		{
+			unsigned block_buffer_count;
+			bool     write_back;
+			unsigned max_jobs;
+		};
+
 		Data_file_system(Vfs::Env                   &env,
-		                 Block::Connection<>        &block,
+		                 Block_connection           &block,
 		                 Block::Session::Info const &info,
 		                 Name                 const &name,
-		                 unsigned                    block_buffer_count)
+		                 Config               const &config)
 		:
 			Single_file_system { Node_type::CONTINUOUS_FILE, name.string(),
 			                     info.writeable ? Node_rwx::rw() : Node_rwx::ro(),
 			                     Genode::Xml_node("<data/>") },
 			_env(env),
-			_block_buffer(0),
-			_block_buffer_count(block_buffer_count),
 			_block(block),
 			_info(info),
-			_tx_source(_block.tx()),
-			_writeable(_info.writeable)
-		{
-			_block_buffer = new (_env.alloc())
-				char[_block_buffer_count * _info.block_size];
-		}
+			_writeable(_info.writeable),
+			_write_back(config.write_back),
+			_max_jobs(Genode::max(config.max_jobs, 1U)),
+			_cache(_env.alloc(), _info.block_size, config.block_buffer_count)
+		{ }
 
 		~Data_file_system()
 		{
-			destroy(_env.alloc(), _block_buffer);
+			unsigned const dirty = _cache.count(State::DIRTY)
+			                     + _cache.count(State::FLUSHING);
+			if (dirty)
+				Genode::warning("vfs_block: discarding ", dirty, " unsynced blocks");
+
+			_block.dissolve_all_jobs([&] (Job &job) { _destroy(job); });
+
+			/* completed jobs not yet picked up by their handles */
+			_jobs.for_each([&] (Job &job) { _destroy(job); });
 		}
 
+		/**
+		 * Drive block I/O on the arrival of block-session signals
+		 */
+		void handle_io() { _update_jobs(); }
+
 		static char const *name()   { return "data"; }
 		char const *type() override { return "data"; }
 
@@ -391,16 +914,7 @@ class Vfs::Block_file_system::Data_file_system : public Single_file_system
 				return OPEN_ERR_UNACCESSIBLE;
 
 			try {
-				*out_handle = new (alloc) Block_vfs_handle(*this, *this,
-				                                           _env.env().ep(),
-				                                           alloc,
-				                                           _block_buffer,
-				                                           _block_buffer_count,
-				                                           _block,
-				                                           _info.block_size,
-				                                           _info.block_count,
-				                                           _tx_source,
-				                                           _info.writeable);
+				*out_handle = new (alloc) Block_vfs_handle(*this, *this, alloc, *this);
 				return OPEN_OK;
 			}
 			catch (Genode::Out_of_ram)  { return OPEN_ERR_OUT_OF_RAM; }
@@ -437,7 +951,7 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 
 	Genode::Allocator_avl _tx_block_alloc { &_env.alloc() };
 
-	Block::Connection<> _block {
+	Block_connection _block {
 		_env.env(), &_tx_block_alloc, 128*1024, _label.string() };
 
 	Block::Session::Info const _info { _block.info() };
@@ -445,7 +959,11 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 	Genode::Io_signal_handler<Local_factory> _block_signal_handler {
 		_env.env().ep(), *this, &Local_factory::_handle_block_signal };
 
-	void _handle_block_signal() { _env.user().wakeup_vfs_user(); }
+	void _handle_block_signal()
+	{
+		_data_fs.handle_io();
+		_env.user().wakeup_vfs_user();
+	}
 
 	Data_file_system _data_fs;
 	
@@ -471,9 +989,12 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 		return config.attribute_value("name", Name("block"));
 	}
 
-	static unsigned buffer_count(Xml_node config)
+	static Data_file_system::Config data_config(Xml_node config)
 	{
-		return config.attribute_value("block_buffer_count", 1U);
+		return {
+			.block_buffer_count = config.attribute_value("block_buffer_count", 1U),
+			.write_back         = config.attribute_value("write_back", false),
+			.max_jobs           = config.attribute_value("max_jobs", 16U) };
 	}
 
 	Local_factory(Vfs::Env &env, Xml_node config)
@@ -481,7 +1002,7 @@ struct Vfs::Block_file_system::Local_factory : File_system_factory
 		_label   { config.attribute_value("label", Label("")) },
 		_name    { name(config) },
 		_env     { env },
-		_data_fs { _env, _block, _info, name(config), buffer_count(config) }
+		_data_fs { _env, _block, _info, name(config), data_config(config) }
 	{
 		_block.sigh(_block_signal_handler);
 		_info_fs       .value(Info { _info });
@@ -20,6 +20,8 @@
 #include <base/allocator_avl.h>
 #include <base/id_space.h>
 #include <file_system_session/connection.h>
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Fs_file_system; }
 
@@ -54,6 +56,20 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 			::File_system::Packet_descriptor queued_read_packet { };
 			::File_system::Packet_descriptor queued_sync_packet { };
+
+			/*
+			 * Packet collecting adjacent small writes, allocated in the bulk
+			 * buffer while 'write_behind_len' is non-zero
+			 */
+			::File_system::Packet_descriptor write_behind_packet { };
+			size_t write_behind_len = 0;
+
+			/* inode of the file, obtained when buffering data the first time */
+			unsigned long write_behind_inode = 0;
+			bool          write_behind_inode_valid = false;
+
+			/* handle closed while its buffered data was not yet submitted */
+			bool close_pending = false;
 		};
 
 		struct Fs_vfs_handle;
@@ -143,6 +159,11 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			using Handle_state::queued_sync_packet;
 			using Handle_state::queued_sync_state;
 			using Handle_state::read_ready_state;
+			using Handle_state::write_behind_packet;
+			using Handle_state::write_behind_len;
+			using Handle_state::write_behind_inode;
+			using Handle_state::write_behind_inode_valid;
+			using Handle_state::close_pending;
 
 			Fs_file_system &_vfs_fs;
 
@@ -241,6 +262,10 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
 					return true;
 
+				/* the server must see the buffered data before the sync */
+				if (!_vfs_fs._flush_write_behind(*this))
+					return false;
+
 				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
 
 				/* if not ready to submit suggest retry */
@@ -292,6 +317,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
 				using ::File_system::Packet_descriptor;
 
+				if (!_vfs_fs._flush_write_behind(*this))
+					return false;
+
 				if (!source.ready_to_submit()) {
 					return false;
 				}
@@ -317,6 +345,10 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 			bool queue_read(size_t count) override
 			{
+				/* let readers observe data still buffered by any handle */
+				if (!_vfs_fs._flush_all_write_behind())
+					return false;
+
 				return _queue_read(count, seek());
 			}
 
@@ -483,6 +515,213 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			return Write_result::WRITE_OK;
 		}
 
+		/*
+		 * Write-behind buffering
+		 *
+		 * If configured via the 'write_behind' attribute, writes smaller than
+		 * the buffer size are appended to a per-handle packet as long as they
+		 * are adjacent. The packet is submitted once it is full, on sync,
+		 * read, truncate, close, a non-adjacent write, or after
+		 * 'write_behind_ms' milliseconds. If the packet cannot be submitted
+		 * at close time, the handle is kept until the submission succeeds.
+		 * The size reported by 'stat' includes the buffered data.
+		 */
+
+		size_t           const _write_behind_size;
+		Genode::uint64_t const _write_behind_us;
+
+		/* number of handles with buffered data */
+		unsigned _write_behind_pending = 0;
+
+		/* number of closed handles with buffered data not yet submitted */
+		unsigned _close_pending = 0;
+
+		Genode::Constructible<Timer::Connection> _write_behind_timer { };
+
+		bool _write_behind_timer_armed = false;
+
+		void _arm_write_behind_timer()
+		{
+			if (_write_behind_timer_armed || !_write_behind_timer.constructed())
+				return;
+
+			_write_behind_timer->trigger_once(_write_behind_us);
+			_write_behind_timer_armed = true;
+		}
+
+		/**
+		 * Submit buffered data of 'handle'
+		 *
+		 * \return false if the packet could not be submitted yet
+		 */
+		bool _flush_write_behind(Fs_vfs_handle &handle)
+		{
+			if (!handle.write_behind_len)
+				return true;
+
+			::File_system::Session::Tx::Source &source = *_fs.tx();
+			using ::File_system::Packet_descriptor;
+
+			if (!source.ready_to_submit())
+				return false;
+
+			Packet_descriptor const packet(handle.write_behind_packet,
+			                               handle.file_handle(),
+			                               Packet_descriptor::WRITE,
+			                               handle.write_behind_len,
+			                               handle.write_behind_packet.position());
+
+			handle.write_behind_packet = Packet_descriptor();
+			handle.write_behind_len    = 0;
+			_write_behind_pending--;
+
+			_submit_packet(packet);
+			return true;
+		}
+
+		void _close(Fs_vfs_handle &handle)
+		{
+			_fs.close(handle.file_handle());
+			destroy(handle.alloc(), &handle);
+		}
+
+		/**
+		 * Close handles once their buffered data is submitted
+		 */
+		void _complete_pending_closes()
+		{
+			while (_close_pending) {
+
+				Fs_vfs_handle *closable = nullptr;
+				bool           blocked  = false;
+
+				_handle_space.for_each<Fs_vfs_handle>([&] (Fs_vfs_handle &handle) {
+					if (closable || blocked || !handle.close_pending)
+						return;
+
+					if (_flush_write_behind(handle))
+						closable = &handle;
+					else
+						blocked = true;
+				});
+
+				if (!closable)
+					return;
+
+				_close_pending--;
+				_close(*closable);
+			}
+		}
+
+		/**
+		 * Return end of the data buffered for the node with 'inode'
+		 *
+		 * The server does not see buffered data before it is submitted, and
+		 * status requests may overtake submitted packets. Hence, the size
+		 * reported by the server is corrected by the buffered data.
+		 */
+		::File_system::file_size_t _write_behind_end(unsigned long const inode)
+		{
+			::File_system::file_size_t end = 0;
+
+			_handle_space.for_each<Fs_vfs_handle>([&] (Fs_vfs_handle &handle) {
+				if (handle.write_behind_len && handle.write_behind_inode_valid
+				 && handle.write_behind_inode == inode)
+					end = Genode::max(end, handle.write_behind_packet.position()
+					                     + handle.write_behind_len); });
+
+			return end;
+		}
+
+		bool _flush_all_write_behind()
+		{
+			if (!_write_behind_pending)
+				return true;
+
+			bool flushed = true;
+			_handle_space.for_each<Fs_vfs_handle>([&] (Fs_vfs_handle &handle) {
+				if (!_flush_write_behind(handle))
+					flushed = false; });
+
+			return flushed;
+		}
+
+		Write_result _write_behind(Fs_vfs_handle &handle, file_size const seek_offset,
+		                           Const_byte_range_ptr const &src, size_t &out_count)
+		{
+			::File_system::Session::Tx::Source &source = *_fs.tx();
+			using ::File_system::Packet_descriptor;
+
+			Packet_descriptor &packet = handle.write_behind_packet;
+
+			bool const appendable = handle.write_behind_len
+			                     && seek_offset == packet.position() + handle.write_behind_len
+			                     && handle.write_behind_len + src.num_bytes <= packet.size();
+
+			if (handle.write_behind_len && !appendable)
+				if (!_flush_write_behind(handle)) {
+					_write_would_block = true;
+					return Write_result::WRITE_ERR_WOULD_BLOCK;
+				}
+
+			if (!handle.write_behind_len) {
+
+				/* needed for reporting the file size including buffered data */
+				if (!handle.write_behind_inode_valid) {
+					try {
+						handle.write_behind_inode = _fs.status(handle.file_handle()).inode;
+						handle.write_behind_inode_valid = true;
+					}
+					catch (...) { return _write(handle, seek_offset, src, out_count); }
+				}
+
+				/* reclaim as much space in the packet stream as possible */
+				_handle_ack();
+
+				try {
+					packet = Packet_descriptor(source.alloc_packet(_write_behind_size),
+					                           handle.file_handle(),
+					                           Packet_descriptor::WRITE,
+					                           0, seek_offset);
+				}
+				catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+					_write_would_block = true;
+					return Write_result::WRITE_ERR_WOULD_BLOCK;
+				}
+
+				_write_behind_pending++;
+				_arm_write_behind_timer();
+			}
+
+			memcpy(source.packet_content(packet) + handle.write_behind_len,
+			       src.start, src.num_bytes);
+
+			handle.write_behind_len += src.num_bytes;
+			out_count = src.num_bytes;
+
+			/* a full buffer not submittable right now is left to the timeout */
+			if (handle.write_behind_len == packet.size())
+				_flush_write_behind(handle);
+
+			return Write_result::WRITE_OK;
+		}
+
+		void _handle_write_behind_timeout()
+		{
+			_write_behind_timer_armed = false;
+
+			if (!_flush_all_write_behind())
+				_arm_write_behind_timer();
+
+			_complete_pending_closes();
+
+			/* deferred wakeups are not processed for this signal */
+			_fs.tx()->wakeup();
+		}
+
+		Genode::Io_signal_handler<Fs_file_system> _write_behind_timeout_handler {
+			_env.env().ep(), *this, &Fs_file_system::_handle_write_behind_timeout };
+
 		void _handle_ack()
 		{
 			::File_system::Session::Tx::Source &source = *_fs.tx();
@@ -549,6 +788,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 			if (any_ack_handled)
 				_env.user().wakeup_vfs_user();
+
+			/* acknowledgements made room for pending write-behind data */
+			_complete_pending_closes();
 		}
 
 		Genode::Io_signal_handler<Fs_file_system> _signal_handler {
@@ -560,6 +802,15 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			return config.attribute_value("buffer_size", fs_default);
 		}
 
+		static size_t write_behind_size(Genode::Xml_node const &config)
+		{
+			size_t const size =
+				config.attribute_value("write_behind", Genode::Number_of_bytes(0));
+
+			/* the write-behind buffers must not monopolize the bulk buffer */
+			return min(size, buffer_size(config) / 8);
+		}
+
 	public:
 
 		Fs_file_system(Vfs::Env &env, Genode::Xml_node config)
@@ -569,7 +820,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			_fs(_env.env(), _fs_packet_alloc,
 			    _label,
 			    config.attribute_value("writeable", true),
-			    buffer_size(config))
+			    buffer_size(config)),
+			_write_behind_size(write_behind_size(config)),
+			_write_behind_us(config.attribute_value("write_behind_ms", 10U)*1000ULL)
 		{
 			if (config.has_attribute("root")) {
 				Genode::warning("vfs: <fs> node uses deprecated 'root' attribute.");
@@ -577,6 +830,11 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			}
 
 			_fs.sigh(_signal_handler);
+
+			if (_write_behind_size) {
+				_write_behind_timer.construct(_env.env());
+				_write_behind_timer->sigh(_write_behind_timeout_handler);
+			}
 		}
 
 		/*********************************
@@ -614,6 +872,11 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 			out.size   = status.size;
 			out.type   = _node_type(status.type);
+
+			/* account for buffered data, e.g., for the position of appends */
+			if (_write_behind_pending)
+				out.size = Genode::max(out.size, _write_behind_end(status.inode));
+
 			out.rwx    = _node_rwx(status.rwx);
 			out.inode  = status.inode;
 			out.device = (Genode::addr_t)this;
@@ -835,8 +1098,15 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		{
 			Fs_vfs_handle *fs_handle = static_cast<Fs_vfs_handle *>(vfs_handle);
 
-			_fs.close(fs_handle->file_handle());
-			destroy(fs_handle->alloc(), fs_handle);
+			/* keep the handle until its buffered data can be submitted */
+			if (!_flush_write_behind(*fs_handle)) {
+				fs_handle->close_pending = true;
+				_close_pending++;
+				_arm_write_behind_timer();
+				return;
+			}
+
+			_close(*fs_handle);
 		}
 
 		Watch_result watch(char const      *path,
@@ -893,6 +1163,15 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		{
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
+			if (src.num_bytes && src.num_bytes < _write_behind_size)
+				return _write_behind(handle, handle.seek(), src, out_count);
+
+			/* preserve the order of buffered and direct writes */
+			if (!_flush_write_behind(handle)) {
+				_write_would_block = true;
+				return Write_result::WRITE_ERR_WOULD_BLOCK;
+			}
+
 			return _write(handle, handle.seek(), src, out_count);
 		}
 
@@ -956,7 +1235,10 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			if (!_flush_write_behind(*handle))
+				return FTRUNCATE_ERR_INTERRUPT;
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
@@ -18,6 +18,7 @@
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -287,50 +288,68 @@ class Vfs::Tar_file_system : public File_system
 	using Path_element_token = Genode::Token<Scanner_policy_path_element>;
 
 
-	struct Node : List<Node>, List<Node>::Element
+	/**
+	 * FNV-1a hash of 'len' characters of 'str', continuing from 'hash'
+	 */
+	static unsigned _path_hash(unsigned hash, char const *str, size_t len)
 	{
-		char const *name;
-		Record const *record;
-
-		Node(char const *name, Record const *record) : name(name), record(record) { }
-
-		Node *lookup(char const *name)
-		{
-			Absolute_path lookup_path(name);
+		for (size_t i = 0; i < len; i++)
+			hash = (hash ^ (unsigned char)str[i])*16777619u;
+		return hash;
+	}
 
-			Node *parent_node = this;
-			Node *child_node;
+	enum : unsigned { ROOT_PATH_HASH = 2166136261u };
 
-			Path_element_token t(lookup_path.base());
 
-			while (t) {
+	struct Node : List<Node>, List<Node>::Element
+	{
+		char const *name;
+		Record const *record;
 
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
+		Node const *parent;
 
-				char path_element[MAX_PATH_LEN];
+		/* hash of the absolute path of the node, see 'Path_index' */
+		unsigned const path_hash;
 
-				t.string(path_element, sizeof(path_element));
+		Node(char const *name, Record const *record)
+		:
+			name(name), record(record), parent(nullptr),
+			path_hash(ROOT_PATH_HASH)
+		{ }
 
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
-					}
-				}
+		Node(char const *name, Record const *record, Node const &parent)
+		:
+			name(name), record(record), parent(&parent),
+			path_hash(_path_hash(_path_hash(parent.path_hash, "/", 1),
+			                     name, strlen(name)))
+		{ }
+
+		/*
+		 * Noncopyable
+		 */
+		Node(Node const &);
+		Node &operator = (Node const &);
+
+		/**
+		 * Return true if the node is located at the canonical 'path'
+		 *
+		 * \param len  length of 'path' without trailing slash
+		 */
+		bool located_at(char const *path, size_t len) const
+		{
+			for (Node const *node = this; node->parent; node = node->parent) {
 
-				if (!child_node)
-					return 0;
+				size_t const name_len = strlen(node->name);
+				if (len < name_len + 1)
+					return false;
 
-				t = t.next();
+				len -= name_len + 1;
+				if (path[len] != '/' || Genode::memcmp(path + len + 1, node->name, name_len))
+					return false;
 			}
-
-			return parent_node;
+			return len == 0;
 		}
 
-
 		Node const *lookup_child(int index) const
 		{
 			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
@@ -342,10 +361,10 @@ class Vfs::Tar_file_system : public File_system
 		}
 
 
-		file_size num_dirent()
+		file_size num_dirent() const
 		{
 			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
+			for (Node const *child_node = first(); child_node; child_node = child_node->next(), count++) ;
 			return count;
 		}
 
@@ -426,14 +445,14 @@ class Vfs::Tar_file_system : public File_system
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
+							child_node = new (_alloc) Node(name, record, *parent_node);
 						} else {
 
 							/* create a directory node without record */
 							Genode::size_t name_size = strlen(path_element) + 1;
 							char *name = (char*)_alloc.alloc(name_size);
 							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
+							child_node = new (_alloc) Node(name, 0, *parent_node);
 						}
 						parent_node->insert(child_node);
 					}
@@ -478,21 +497,118 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
+	/**
+	 * Index of all nodes by their absolute path
+	 *
+	 * The index is built once after scanning the archive. It is an
+	 * open-addressing hash table of node pointers with at least twice as
+	 * many slots as nodes. A lookup hashes the canonical path instead of
+	 * walking the sibling lists at each path element.
+	 */
+	class Path_index
+	{
+		private:
+
+			/*
+			 * Noncopyable
+			 */
+			Path_index(Path_index const &);
+			Path_index &operator = (Path_index const &);
+
+			Genode::Allocator &_alloc;
+
+			static size_t _count(Node const &node)
+			{
+				size_t count = 1;
+				for (Node const *child = node.first(); child; child = child->next())
+					count += _count(*child);
+				return count;
+			}
+
+			static size_t _capacity_for(size_t num_nodes)
+			{
+				size_t capacity = 1;
+				while (capacity < 2*num_nodes)
+					capacity <<= 1;
+				return capacity;
+			}
+
+			size_t const _capacity;
+
+			Node const ** const _slots =
+				(Node const **)_alloc.alloc(_capacity*sizeof(Node const *));
+
+			size_t _next(size_t i) const { return (i + 1) & (_capacity - 1); }
+
+			void _insert(Node const &node)
+			{
+				size_t i = node.path_hash & (_capacity - 1);
+				while (_slots[i])
+					i = _next(i);
+
+				_slots[i] = &node;
+
+				for (Node const *child = node.first(); child; child = child->next())
+					_insert(*child);
+			}
+
+		public:
+
+			Path_index(Genode::Allocator &alloc, Node const &root_node)
+			:
+				_alloc(alloc), _capacity(_capacity_for(_count(root_node)))
+			{
+				for (size_t i = 0; i < _capacity; i++)
+					_slots[i] = nullptr;
+
+				_insert(root_node);
+			}
+
+			~Path_index()
+			{
+				_alloc.free(_slots, _capacity*sizeof(Node const *));
+			}
+
+			Node const *lookup(char const *path) const
+			{
+				Absolute_path const lookup_path(path);
+
+				char const *p   = lookup_path.base();
+				size_t      len = strlen(p);
+
+				while (len && p[len - 1] == '/')
+					len--;
+
+				unsigned const hash = _path_hash(ROOT_PATH_HASH, p, len);
+
+				for (size_t i = hash & (_capacity - 1); _slots[i]; i = _next(i))
+					if (_slots[i]->path_hash == hash && _slots[i]->located_at(p, len))
+						return _slots[i];
+
+				return nullptr;
+			}
+	};
+
+	Genode::Constructible<Path_index> _path_index { };
+
+	Node const *_lookup(char const *path) const { return _path_index->lookup(path); }
+
+
 	struct Num_dirent_cache
 	{
-		Node     &root_node;
+		Tar_file_system &fs;
 		bool      valid;              /* true after first lookup */
 		char      key[256];           /* key used for lookup */
 		file_size cached_num_dirent;  /* cached value */
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+		Num_dirent_cache(Tar_file_system &fs)
+		: fs(fs), valid(false), cached_num_dirent(0) { }
 
 		file_size num_dirent(char const *path)
 		{
 			/* check for cache miss */
 			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
+				Node const *node = fs._lookup(path);
 				if (!node)
 					return 0;
 				copy_cstring(key, path, sizeof(key));
@@ -508,7 +624,7 @@ class Vfs::Tar_file_system : public File_system
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
@@ -522,9 +638,9 @@ class Vfs::Tar_file_system : public File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -541,9 +657,11 @@ class Vfs::Tar_file_system : public File_system
 			_env(env.env()), _alloc(env.alloc()),
 			_rom_name(config.attribute_value("name", Rom_name())),
 			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_cached_num_dirent(*this)
 		{
 			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+
+			_path_index.construct(_alloc, _root_node);
 		}
 
 		/*********************************
@@ -651,7 +769,7 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
@@ -680,7 +798,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node const *node = _lookup(path);
 			return node ? path : 0;
 		}
 
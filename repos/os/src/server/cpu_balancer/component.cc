@@ -402,6 +402,9 @@ void Cpu::Balancer::handle_timeout()
 
 		retry<Genode::Xml_generator::Buffer_exceeded>(env, [&] () {
 			Reporter::Xml_generator xml(*reporter, [&] () {
+				if (trace.constructed())
+					trace->report_load(xml);
+
 				list.for_each([&](auto &session) {
 					reset_report |= session.report_state(xml);
 				});
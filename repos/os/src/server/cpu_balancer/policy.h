@@ -16,6 +16,7 @@
 
 #include <base/affinity.h>
 #include <base/output.h>
+#include <util/xml_generator.h>
 
 #include "trace.h"
 
@@ -30,6 +31,7 @@ namespace Cpu
 	class Policy_pin;
 	class Policy_round_robin;
 	class Policy_max_utilize;
+	class Policy_load_balance;
 };
 
 class Cpu::Policy {
@@ -76,6 +78,11 @@ class Cpu::Policy {
 
 		virtual void print(Genode::Output &output) const = 0;
 
+		/**
+		 * Add policy-specific state to the thread node of the report
+		 */
+		virtual void report(Genode::Xml_generator &) const { }
+
 		virtual bool same_type(Name const &) const = 0;
 		virtual char const * string() const = 0;
 };
@@ -312,4 +319,139 @@ class Cpu::Policy_max_utilize : public Cpu::Policy
 			return "max-utilize"; }
 };
 
+class Cpu::Policy_load_balance : public Cpu::Policy
+{
+	private:
+
+		/*
+		 * Additional load in per-mille a migration must relieve the current
+		 * CPU from, modelling the cost of losing the cache state. Hardware
+		 * threads of the same core (same xpos) share caches and are cheaper.
+		 */
+		enum { COST_SIBLING = 50, COST_CORE = 150 };
+
+		/* number of intervals a thread stays on a CPU after a migration */
+		enum { COOLDOWN = 3 };
+
+		Execution_time _last { };
+		Execution_time _time { };
+
+		bool           _last_valid { false };
+		bool           _time_valid { false };
+
+		unsigned       _cooldown    { 0 };
+		unsigned       _utilization { 0 };  /* per-mille of current CPU */
+		unsigned       _migrations  { 0 };
+
+		Location       _from { };  /* origin of last migration, relative */
+
+		Execution_time _last_utilization() const
+		{
+			using Genode::uint64_t;
+
+			uint64_t ec = (_last.thread_context < _time.thread_context) ?
+			              _time.thread_context - _last.thread_context : 0;
+			uint64_t sc = (_last.scheduling_context < _time.scheduling_context) ?
+			              _time.scheduling_context - _last.scheduling_context : 0;
+			return Execution_time(ec, sc);
+		}
+
+		static unsigned _cost(Location const &from, Location const &to)
+		{
+			return (from.xpos() == to.xpos()) ? COST_SIBLING : COST_CORE;
+		}
+
+	public:
+
+		void config(Location const &) override { };
+		void thread_create(Location const &loc) override { location = loc; }
+
+		bool update(Location const &base, Location &current, Execution_time const &time) override {
+			_last       = _time;
+			_last_valid = _time_valid;
+
+			_time       = time;
+			_time_valid = true;
+
+			if (_cooldown)
+				_cooldown--;
+
+			return _update(base, current); }
+
+		bool migrate(Location const &base, Location &current, Trace * trace) override
+		{
+			if (!trace || !_last_valid || !_time_valid)
+				return false;
+
+			_utilization = trace->utilization(current, _last_utilization());
+
+			if (_cooldown || !_utilization)
+				return false;
+
+			unsigned const current_load = trace->load(current);
+
+			/* determine CPU with the least load including the migration cost */
+			Location to        { current };
+			unsigned best_load { current_load };
+
+			for (unsigned x = base.xpos(); x < base.xpos() + base.width(); x++) {
+				for (unsigned y = base.ypos(); y < base.ypos() + base.height(); y++) {
+
+					Location const loc(x, y);
+
+					if ((loc.xpos() == current.xpos()) && (loc.ypos() == current.ypos()))
+						continue;
+
+					unsigned const load = trace->load(loc) + _utilization
+					                    + _cost(current, loc);
+					if (load < best_load) {
+						best_load = load;
+						to        = loc;
+					}
+				}
+			}
+
+			/*
+			 * Migrate only if the thread ends up with less load on the target
+			 * CPU than is present on the current CPU. Thereby, a single thread
+			 * saturating a CPU is never moved around.
+			 */
+			if ((to.xpos() == current.xpos()) && (to.ypos() == current.ypos()))
+				return false;
+
+			trace->migrated(current, to, _utilization);
+
+			_from       = Location(current.xpos() - base.xpos(),
+			                       current.ypos() - base.ypos());
+			_cooldown   = COOLDOWN;
+			_migrations++;
+
+			current     = to;
+			_last_valid = false;
+			_time_valid = false;
+
+			return true;
+		}
+
+		void report(Genode::Xml_generator &xml) const override
+		{
+			xml.attribute("utilization", _utilization);
+			xml.attribute("migrations",  _migrations);
+
+			if (_migrations)
+				xml.node("migrated", [&] () {
+					xml.attribute("xpos", _from.xpos());
+					xml.attribute("ypos", _from.ypos()); });
+		}
+
+		void print(Genode::Output &output) const override {
+			Genode::print(output, "load-balance"); }
+
+		bool same_type(Name const &name) const override {
+			return name == "load-balance"; }
+
+		char const * string() const override {
+			return "load-balance"; }
+};
+
 #endif
@@ -73,11 +73,12 @@ void Cpu::Session::update_threads(Trace &trace, Session_label const &cpu_balance
 			if (_verbose)
 				log("[", _label, "] name='", name, "' request to",
 				    " migrate from ", current.xpos(), "x", current.ypos(),
-				    " to most idle CPU at ",
-				    migrate_to.xpos(), "x", migrate_to.ypos());
+				    " to ", migrate_to.xpos(), "x", migrate_to.ypos(),
+				    " policy=", policy.string());
+
+			_migrate(cap, migrate_to);
 
-			Cpu_thread_client thread(cap);
-			thread.affinity(migrate_to);
+			_report = true;
 		}
 
 		return false;
@@ -103,8 +104,7 @@ void Cpu::Session::update_threads()
 		if (!policy.migrate(_affinity.location(), migrate_to, nullptr))
 			return false;
 
-		Cpu_thread_client thread(cap);
-		thread.affinity(migrate_to);
+		_migrate(cap, migrate_to);
 
 		return false;
 	});
@@ -224,6 +224,8 @@ bool Cpu::Session::report_state(Xml_generator &xml)
 				xml.attribute("policy", policy.string());
 				if (enforced_policy)
 					xml.attribute("enforced", enforced_policy);
+
+				policy.report(xml);
 			});
 			return false;
 		});
@@ -22,6 +22,7 @@
 #include <base/rpc_server.h>
 #include <base/trace/types.h>
 #include <cpu_session/client.h>
+#include <cpu_thread/client.h>
 #include <os/reporter.h>
 
 #include "policy.h"
@@ -47,13 +48,14 @@ struct Cpu::Thread_client : Interface
 		Genode::Thread::Name   _name   { };
 		Subject_id             _id     { };
 
-		enum Policy_type { NONE, PIN, ROUND_ROBIN, MAX_UTIL };
+		enum Policy_type { NONE, PIN, ROUND_ROBIN, MAX_UTIL, LOAD_BALANCE };
 
 		Policy_type            _type { Policy_type::NONE };
 
 		Policy_pin             _policy_pin  { };
 		Policy_round_robin     _policy_rr   { };
 		Policy_max_utilize     _policy_max  { };
+		Policy_load_balance    _policy_load { };
 		Policy_none            _policy_none { };
 
 		bool                   _fix    { false };
@@ -66,6 +68,8 @@ struct Cpu::Thread_client : Interface
 				return _policy_rr;
 			case Policy_type::MAX_UTIL:
 				return _policy_max;
+			case Policy_type::LOAD_BALANCE:
+				return _policy_load;
 			case Policy_type::NONE:
 				return _policy_none;
 			}
@@ -113,6 +117,8 @@ class Cpu::Session : public Rpc_object<Cpu_session>
 				thread._type = Thread_client::Policy_type::ROUND_ROBIN;
 			else if (name == "max-utilize")
 				thread._type = Thread_client::Policy_type::MAX_UTIL;
+			else if (name == "load-balance")
+				thread._type = Thread_client::Policy_type::LOAD_BALANCE;
 			else
 				thread._type = Thread_client::Policy_type::NONE;
 
@@ -312,6 +318,22 @@ class Cpu::Session : public Rpc_object<Cpu_session>
 			return argbuf;
 		}
 
+		/**
+		 * Migrate thread to the CPU at the physical 'location'
+		 *
+		 * The affinity of a thread is specified relative to the location of
+		 * its CPU session.
+		 */
+		void _migrate(Thread_capability const &cap,
+		              Affinity::Location const &location)
+		{
+			Affinity::Location const &base = _affinity.location();
+
+			Cpu_thread_client(cap).affinity(
+				Affinity::Location(location.xpos() - base.xpos(),
+				                   location.ypos() - base.ypos(), 1, 1));
+		}
+
 		/*
 		 * Noncopyable
 		 */
@@ -48,6 +48,25 @@ void Cpu::Trace::_read_idle_times(bool skip_max_idle)
 			if (time.thread_context > max.thread_context ||
 			    time.scheduling_context > max.scheduling_context)
 				max = time;
+
+			/* the CPU is busy whenever it is not idle */
+			Genode::uint64_t const capacity = _time_value(max);
+			Genode::uint64_t const idle     = Genode::min(_time_value(time), capacity);
+
+			_load[x][y] = capacity ? unsigned((capacity - idle)*1000/capacity) : 0;
+		}
+	}
+}
+
+void Cpu::Trace::report_load(Genode::Xml_generator &xml) const
+{
+	for (unsigned x = 0; x < _space.width(); x++) {
+		for (unsigned y = 0; y < _space.height(); y++) {
+			xml.node("cpu", [&] () {
+				xml.attribute("xpos", x);
+				xml.attribute("ypos", y);
+				xml.attribute("load", _load[x][y]);
+			});
 		}
 	}
 }
@@ -16,6 +16,7 @@
 #define _TRACE_H_
 
 #include <util/reconstructible.h>
+#include <util/xml_generator.h>
 #include <trace_session/connection.h>
 
 namespace Cpu {
@@ -51,6 +52,21 @@ class Cpu::Trace
 
 		unsigned        _subject_id_reread { 0 };
 
+		/* modelled load in per-mille of the observed capacity of each CPU */
+		unsigned        _load[MAX_CORES][MAX_THREADS] { };
+
+		static Genode::uint64_t _time_value(Execution_time const &time)
+		{
+			return time.thread_context ? time.thread_context
+			                           : time.scheduling_context;
+		}
+
+		static bool _valid(Affinity::Location const &location)
+		{
+			return location.xpos() >= 0 && location.xpos() < MAX_CORES
+			    && location.ypos() >= 0 && location.ypos() < MAX_THREADS;
+		}
+
 		void _reconstruct(Genode::size_t const upgrade = 4 * 4096)
 		{
 			_ram_quota += upgrade;
@@ -114,6 +130,56 @@ class Cpu::Trace
 		}
 
 
+		/**
+		 * Return load of CPU in per-mille
+		 *
+		 * The load is derived from the idle time of the CPU during the last
+		 * interval compared to the maximum idle time observed, which
+		 * approximates the capacity of the CPU per interval. Migrations
+		 * reported via 'migrated' are accounted until the next update.
+		 */
+		unsigned load(Affinity::Location const &location) const
+		{
+			return _valid(location) ? _load[location.xpos()][location.ypos()] : 0;
+		}
+
+		/**
+		 * Return execution time consumed at 'location' in per-mille of the
+		 * CPU's capacity
+		 */
+		unsigned utilization(Affinity::Location const &location,
+		                     Execution_time const &time) const
+		{
+			if (!_valid(location))
+				return 0;
+
+			Genode::uint64_t const capacity =
+				_time_value(_idle_max[location.xpos()][location.ypos()]);
+
+			if (!capacity)
+				return 0;
+
+			return unsigned(Genode::min(_time_value(time), capacity)*1000/capacity);
+		}
+
+		/**
+		 * Account migration of a thread with 'utilization' in the load model
+		 */
+		void migrated(Affinity::Location const &from, Affinity::Location const &to,
+		              unsigned const utilization)
+		{
+			if (!_valid(from) || !_valid(to))
+				return;
+
+			unsigned &load_from = _load[from.xpos()][from.ypos()];
+			unsigned &load_to   = _load[to.xpos()][to.ypos()];
+
+			load_from -= Genode::min(load_from, utilization);
+			load_to    = Genode::min(load_to + utilization, 1000U);
+		}
+
+		void report_load(Genode::Xml_generator &) const;
+
 		Subject_id lookup_missing_id(Session_label const &,
 		                             Thread_name const &);
 
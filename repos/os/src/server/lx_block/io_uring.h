@@ -0,0 +1,346 @@
+/*
+ * \brief  Backend using the Linux io_uring interface
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The submission and completion rings are accessed directly via the raw
+ * system calls, which avoids the dependency on liburing. Completions are
+ * signalled through an eventfd, which is observed by a dedicated thread
+ * that forwards each wakeup as signal to the entrypoint.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LX_BLOCK__IO_URING_H_
+#define _LX_BLOCK__IO_URING_H_
+
+/* Genode includes */
+#include <base/thread.h>
+
+/* local includes */
+#include "job.h"
+
+/* libc includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+namespace Lx_block { class Io_uring_backend; }
+
+
+class Lx_block::Io_uring_backend : public Backend
+{
+	public:
+
+		struct Setup_failed : Exception { };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Io_uring_backend(Io_uring_backend const &);
+		Io_uring_backend &operator = (Io_uring_backend const &);
+
+		int const _fd;
+
+		static int _setup(unsigned entries, io_uring_params &params)
+		{
+			return (int)syscall(__NR_io_uring_setup, entries, &params);
+		}
+
+		static int _enter(int ring_fd, unsigned to_submit)
+		{
+			return (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, 0,
+			                    nullptr, 0);
+		}
+
+		static int _register(int ring_fd, unsigned opcode, void *arg, unsigned nr)
+		{
+			return (int)syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr);
+		}
+
+		static unsigned _load_acquire(unsigned const *ptr) {
+			return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+
+		static void _store_release(unsigned *ptr, unsigned value) {
+			__atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+
+		/*
+		 * The file descriptors and mappings are released by the destructors
+		 * of the members, which also applies if a later setup step fails.
+		 */
+
+		struct Fd
+		{
+			/*
+			 * Noncopyable
+			 */
+			Fd(Fd const &);
+			Fd &operator = (Fd const &);
+
+			int const value;
+
+			Fd(int value) : value(value) { if (value < 0) throw Setup_failed(); }
+
+			~Fd() { ::close(value); }
+		};
+
+		struct Mapping
+		{
+			/*
+			 * Noncopyable
+			 */
+			Mapping(Mapping const &);
+			Mapping &operator = (Mapping const &);
+
+			size_t const size;
+			void * const ptr;
+
+			/**
+			 * Constructor
+			 *
+			 * \param size  size of the mapping, 0 for no mapping
+			 */
+			Mapping(Fd const &fd, size_t size, off_t offset)
+			:
+				size(size),
+				ptr(size ? mmap(nullptr, size, PROT_READ | PROT_WRITE,
+				                MAP_SHARED | MAP_POPULATE, fd.value, offset)
+				         : nullptr)
+			{
+				if (ptr == MAP_FAILED)
+					throw Setup_failed();
+			}
+
+			~Mapping() { if (ptr) munmap(ptr, size); }
+		};
+
+		io_uring_params _params { };
+
+		Fd const _ring_fd;
+
+		size_t const _sq_size = _params.sq_off.array
+		                      + _params.sq_entries*sizeof(unsigned);
+		size_t const _cq_size = _params.cq_off.cqes
+		                      + _params.cq_entries*sizeof(io_uring_cqe);
+
+		bool const _single_mmap = _params.features & IORING_FEAT_SINGLE_MMAP;
+
+		size_t const _sq_map_size = _single_mmap ? max(_sq_size, _cq_size) : _sq_size;
+
+		Mapping const _sq_map   { _ring_fd, _sq_map_size, IORING_OFF_SQ_RING };
+		Mapping const _cq_map   { _ring_fd, _single_mmap ? 0 : _cq_size, IORING_OFF_CQ_RING };
+		Mapping const _sqes_map { _ring_fd, _params.sq_entries*sizeof(io_uring_sqe),
+		                          IORING_OFF_SQES };
+
+		char * const _sq_ptr = (char *)_sq_map.ptr;
+		char * const _cq_ptr = _single_mmap ? _sq_ptr : (char *)_cq_map.ptr;
+
+		io_uring_sqe * const _sqes = (io_uring_sqe *)_sqes_map.ptr;
+
+		unsigned *_sq_field(unsigned offset) { return (unsigned *)(_sq_ptr + offset); }
+		unsigned *_cq_field(unsigned offset) { return (unsigned *)(_cq_ptr + offset); }
+
+		unsigned * const _sq_tail  = _sq_field(_params.sq_off.tail);
+		unsigned   const _sq_mask  = *_sq_field(_params.sq_off.ring_mask);
+		unsigned * const _sq_array = _sq_field(_params.sq_off.array);
+		unsigned * const _cq_head  = _cq_field(_params.cq_off.head);
+		unsigned * const _cq_tail  = _cq_field(_params.cq_off.tail);
+		unsigned   const _cq_mask  = *_cq_field(_params.cq_off.ring_mask);
+
+		io_uring_cqe * const _cqes = (io_uring_cqe *)(_cq_ptr + _params.cq_off.cqes);
+
+		/* number of SQEs added to the ring but not yet passed to the kernel */
+		unsigned _unsubmitted = 0;
+
+		Fd const _event_fd { eventfd(0, EFD_CLOEXEC) };
+
+		/*
+		 * Thread forwarding the eventfd notifications as signals
+		 */
+		struct Notifier : Thread
+		{
+			int const       _event_fd;
+			Signal_context &_sigh;
+
+			bool _stop = false;
+
+			Notifier(Env &env, int event_fd, Signal_context &sigh)
+			:
+				Thread(env, "io_uring", 16*1024), _event_fd(event_fd), _sigh(sigh)
+			{ }
+
+			void entry() override
+			{
+				while (!__atomic_load_n(&_stop, __ATOMIC_ACQUIRE)) {
+					Genode::uint64_t value = 0;
+					if (::read(_event_fd, &value, sizeof(value)) == sizeof(value))
+						_sigh.local_submit();
+				}
+			}
+
+			/**
+			 * Wake up and join the started thread
+			 */
+			void stop()
+			{
+				__atomic_store_n(&_stop, true, __ATOMIC_RELEASE);
+
+				Genode::uint64_t const value = 1;
+				if (::write(_event_fd, &value, sizeof(value)) == sizeof(value))
+					join();
+			}
+		} _notifier;
+
+		void _fill(io_uring_sqe &sqe, Job &job)
+		{
+			Genode::memset(&sqe, 0, sizeof(sqe));
+
+			sqe.fd        = _fd;
+			sqe.user_data = (Genode::uint64_t)&job;
+
+			switch (job.type()) {
+
+			case Job::Type::READ:
+			case Job::Type::WRITE:
+				sqe.opcode = (job.type() == Job::Type::READ) ? IORING_OP_READ
+				                                             : IORING_OP_WRITE;
+				sqe.addr   = (Genode::uint64_t)(job.buffer + job.done);
+				sqe.len    = (uint32_t)(job.length - job.done);
+				sqe.off    = job.offset + job.done;
+				break;
+
+			case Job::Type::SYNC:
+				sqe.opcode      = IORING_OP_FSYNC;
+				sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+				break;
+
+			case Job::Type::TRIM:
+				sqe.opcode = IORING_OP_FALLOCATE;
+				sqe.off    = job.offset;
+				sqe.addr   = job.length;
+				sqe.len    = FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE;
+				break;
+
+			case Job::Type::INVALID:
+				sqe.opcode = IORING_OP_NOP;
+				break;
+			}
+		}
+
+		void _complete(Job &job, int result)
+		{
+			bool const payload = job.type() == Job::Type::READ
+			                  || job.type() == Job::Type::WRITE;
+
+			/* continue partial transfer */
+			if (payload && result > 0 && job.done + size_t(result) < job.length) {
+				job.done += size_t(result);
+				submit(job);
+				return;
+			}
+
+			if (payload && result > 0)
+				job.done += size_t(result);
+
+			if (payload)
+				job.success = (job.done == job.length);
+			else if (job.type() == Job::Type::TRIM)
+				job.success = (result == 0 || result == -EOPNOTSUPP);
+			else
+				job.success = (result == 0);
+
+			if (!job.success)
+				error(Block::Operation::type_name(job.type()), " at ",
+				      job.offset, " failed (result=", result, ")");
+
+			job.state = Job::State::COMPLETE;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param entries  number of submission-queue entries, which must
+		 *                 not be exceeded by the number of jobs in flight
+		 *
+		 * \throw Setup_failed  io_uring is not supported by the kernel
+		 */
+		Io_uring_backend(Env &env, int fd, Signal_context &completion_sigh,
+		                 unsigned entries)
+		:
+			_fd(fd),
+			_ring_fd(_setup(entries, _params)),
+			_notifier(env, _event_fd.value, completion_sigh)
+		{
+			/* 'IORING_OP_READ' and 'IORING_OP_WRITE' were added along with this feature */
+			if (!(_params.features & IORING_FEAT_RW_CUR_POS))
+				throw Setup_failed();
+
+			int event_fd = _event_fd.value;
+			if (_register(_ring_fd.value, IORING_REGISTER_EVENTFD, &event_fd, 1) < 0)
+				throw Setup_failed();
+
+			_notifier.start();
+		}
+
+		~Io_uring_backend()
+		{
+			/* the notifier must not block on the eventfd when it gets closed */
+			_notifier.stop();
+		}
+
+		char const *name() const override { return "io_uring"; }
+
+		void submit(Job &job) override
+		{
+			unsigned const tail  = *_sq_tail;
+			unsigned const index = tail & _sq_mask;
+
+			_fill(_sqes[index], job);
+			_sq_array[index] = index;
+
+			_store_release(_sq_tail, tail + 1);
+			_unsubmitted++;
+		}
+
+		void update() override
+		{
+			if (_unsubmitted) {
+				int const n = _enter(_ring_fd.value, _unsubmitted);
+				if (n > 0)
+					_unsubmitted -= min(_unsubmitted, unsigned(n));
+			}
+
+			unsigned       head = *_cq_head;
+			unsigned const tail = _load_acquire(_cq_tail);
+
+			for (; head != tail; head++) {
+				io_uring_cqe const &cqe = _cqes[head & _cq_mask];
+				_complete(*(Job *)cqe.user_data, cqe.res);
+			}
+
+			_store_release(_cq_head, head);
+
+			/* resubmissions of partial transfers */
+			if (_unsubmitted) {
+				int const n = _enter(_ring_fd.value, _unsubmitted);
+				if (n > 0)
+					_unsubmitted -= min(_unsubmitted, unsigned(n));
+			}
+		}
+};
+
+#endif /* _LX_BLOCK__IO_URING_H_ */
@@ -0,0 +1,156 @@
+/*
+ * \brief  Block-request job and backend interface
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LX_BLOCK__JOB_H_
+#define _LX_BLOCK__JOB_H_
+
+/* Genode includes */
+#include <base/log.h>
+#include <block/request.h>
+
+/* libc includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/falloc.h>
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+
+namespace Lx_block {
+
+	using namespace Genode;
+
+	struct Job;
+	struct Backend;
+
+	bool execute(int fd, Job &);
+}
+
+
+/**
+ * Block request in the state of being processed by a backend
+ */
+struct Lx_block::Job
+{
+	enum class State { FREE, SUBMITTED, COMPLETE };
+
+	State state = State::FREE;
+
+	Block::Request request { };
+
+	char            *buffer = nullptr;  /* payload in the packet-stream buffer */
+	size_t           length = 0;        /* size of payload or range in bytes */
+	Genode::uint64_t offset = 0;        /* byte offset within the backing file */
+
+	/* number of bytes already transferred, used for partial transfers */
+	size_t done = 0;
+
+	bool success = false;
+
+	using Type = Block::Operation::Type;
+
+	Type type() const { return request.operation.type; }
+
+	Job() { }
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Job(Job const &);
+		Job &operator = (Job const &);
+};
+
+
+/**
+ * Interface of the I/O backends
+ *
+ * Jobs are handed over via 'submit' and marked as 'COMPLETE' by 'update',
+ * which is called from the entrypoint whenever the completion signal
+ * registered at the backend is triggered.
+ */
+struct Lx_block::Backend : Interface
+{
+	virtual char const *name() const = 0;
+
+	/**
+	 * Start the processing of job
+	 */
+	virtual void submit(Job &) = 0;
+
+	/**
+	 * Issue submitted jobs and collect completed ones
+	 */
+	virtual void update() = 0;
+};
+
+
+/**
+ * Perform job synchronously
+ *
+ * \return true on success
+ */
+inline bool Lx_block::execute(int fd, Job &job)
+{
+	switch (job.type()) {
+
+	case Job::Type::READ:
+	case Job::Type::WRITE:
+
+		while (job.done < job.length) {
+
+			char  * const ptr   = job.buffer + job.done;
+			size_t  const count = job.length - job.done;
+			off_t   const pos   = off_t(job.offset + job.done);
+
+			ssize_t const n = (job.type() == Job::Type::READ)
+			                ? pread (fd, ptr, count, pos)
+			                : pwrite(fd, ptr, count, pos);
+			if (n == -1 && errno == EINTR)
+				continue;
+
+			if (n <= 0) {
+				error(Block::Operation::type_name(job.type()), " at ",
+				      job.offset, " failed (errno=", errno, ")");
+				return false;
+			}
+			job.done += size_t(n);
+		}
+		return true;
+
+	case Job::Type::SYNC:
+
+		return fdatasync(fd) == 0;
+
+	case Job::Type::TRIM:
+
+		/*
+		 * Trimming is merely a hint, hence a file system that does not
+		 * support punching holes is not treated as error.
+		 */
+		if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+		              off_t(job.offset), off_t(job.length)) == 0)
+			return true;
+
+		return errno == EOPNOTSUPP;
+
+	case Job::Type::INVALID:
+		break;
+	}
+	return false;
+}
+
+#endif /* _LX_BLOCK__JOB_H_ */
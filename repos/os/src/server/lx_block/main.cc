@@ -12,191 +12,438 @@
  */
 
 /* Genode includes */
+#include <base/attached_ram_dataspace.h>
 #include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 #include <base/heap.h>
 #include <base/log.h>
-#include <block/component.h>
-#include <block/driver.h>
+#include <block/request_stream.h>
+#include <root/root.h>
 #include <util/string.h>
 
+/* local includes */
+#include "io_uring.h"
+#include "thread_pool.h"
+
 /* libc includes */
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <sys/types.h>
 #include <sys/stat.h>
-#include <unistd.h>
-#include <fcntl.h>
 #include <stdio.h> /* perror */
 #pragma GCC diagnostic pop  /* restore -Wconversion warnings */
 
-static bool xml_attr_ok(Genode::Xml_node node, char const *attr)
-{
-	return node.attribute_value(attr, false);
+
+namespace Lx_block {
+
+	struct File;
+	struct Block_session_component;
+	struct Main;
+
+	enum { MAX_QUEUE_DEPTH = 256 };
 }
 
 
-class Lx_block_driver : public Block::Driver
+/**
+ * Backing file as configured
+ */
+struct Lx_block::File : Noncopyable
 {
-	private:
+	struct Could_not_open_file : Exception { };
+
+	using Name = String<256>;
 
-		Genode::Env &_env;
+	Xml_node const &_config;
 
-		Block::Session::Info const _info;
+	Name const name = _config.attribute_value("file", Name());
 
-		using File_name = Genode::String<256>;
+	/* bypass the page cache of the host */
+	bool const direct = _config.attribute_value("direct", false);
 
-		static File_name _file_name(Genode::Xml_node const &config)
-		{
-			return config.attribute_value("file", File_name());
+	Block::Session::Info const info = _init_info();
+
+	int const fd = _open();
+
+	Block::Session::Info _init_info() const
+	{
+		Number_of_bytes const default_block_size(512);
+
+		if (!_config.has_attribute("file")) {
+			error("mandatory file attribute missing");
+			throw Could_not_open_file();
 		}
 
-		static Block::Session::Info _init_info(Genode::Xml_node const &config)
-		{
-			Genode::Number_of_bytes const default_block_size(512);
+		struct stat st;
+		if (stat(name.string(), &st)) {
+			perror("stat");
+			throw Could_not_open_file();
+		}
 
-			if (!config.has_attribute("file")) {
-				Genode::error("mandatory file attribute missing");
-				throw Could_not_open_file();
-			}
+		if (!_config.has_attribute("block_size"))
+			warning("block size missing, assuming ", default_block_size);
+
+		size_t const block_size =
+			_config.attribute_value("block_size", default_block_size);
+
+		/*
+		 * Direct I/O requires buffers aligned to the logical block size of
+		 * the host's storage device, which is at most the page size.
+		 */
+		size_t const align_log2 = direct ? max(log2(block_size), 12U)
+		                                 : log2(block_size);
+		return {
+			.block_size  = block_size,
+			.block_count = st.st_size / block_size,
+			.align_log2  = align_log2,
+			.writeable   = _config.attribute_value("writeable", false)
+		};
+	}
 
-			struct stat st;
-			if (stat(_file_name(config).string(), &st)) {
-				perror("stat");
-				throw Could_not_open_file();
-			}
+	int _open() const
+	{
+		int const flags = (info.writeable ? O_RDWR : O_RDONLY)
+		                | (direct ? O_DIRECT : 0);
+
+		int const fd = open(name.string(), flags);
+		if (fd == -1) {
+			error("open ", name);
+			throw Could_not_open_file();
+		}
+		return fd;
+	}
+
+	File(Xml_node const &config) : _config(config)
+	{
+		log("Provide '", name, "' as block device "
+		    "block_size:  ", info.block_size, " "
+		    "block_count: ", info.block_count, " "
+		    "writeable:   ", info.writeable ? "yes" : "no",
+		    direct ? " direct" : "");
+	}
+
+	~File() { close(fd); }
+};
+
+
+struct Lx_block::Block_session_component : Rpc_object<Block::Session>,
+                                           private Block::Request_stream
+{
+	/*
+	 * Noncopyable
+	 */
+	Block_session_component(Block_session_component const &);
+	Block_session_component &operator = (Block_session_component const &);
+
+	Entrypoint &_ep;
+
+	using Block::Request_stream::with_requests;
+	using Block::Request_stream::with_content;
+	using Block::Request_stream::try_acknowledge;
+	using Block::Request_stream::wakeup_client_if_needed;
+
+	Info const _info;
+
+	Genode::uint64_t const _block_size = _info.block_size;
+
+	Backend &_backend;
+
+	Job * const    _jobs;
+	unsigned const _num_jobs;
+
+	/* a sync operation acts as barrier for all other requests */
+	bool _sync_in_flight = false;
+
+	unsigned _in_flight = 0;
+
+	Block_session_component(Region_map                &rm,
+	                        Entrypoint                &ep,
+	                        Dataspace_capability       ds,
+	                        Signal_context_capability  sigh,
+	                        Info                const &info,
+	                        Backend                   &backend,
+	                        Job                       *jobs,
+	                        unsigned                   num_jobs)
+	:
+		Request_stream { rm, ds, ep, sigh, info },
+		_ep { ep }, _info { info }, _backend { backend },
+		_jobs { jobs }, _num_jobs { num_jobs }
+	{
+		_ep.manage(*this);
+	}
+
+	~Block_session_component() { _ep.dissolve(*this); }
 
-			if (!config.has_attribute("block_size"))
-				Genode::warning("block size missing, assuming ", default_block_size);
+	Info info() const override { return Request_stream::info(); }
 
-			Genode::size_t const block_size =
-				config.attribute_value("block_size", default_block_size);
+	Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
 
-			return {
-				.block_size  = block_size,
-				.block_count = st.st_size / block_size,
-				.align_log2  = Genode::log2(block_size),
-				.writeable   = xml_attr_ok(config, "writeable")
-			};
+	bool _valid(Block::Request const &request) const
+	{
+		using Type = Block::Operation::Type;
+
+		Block::Operation const op = request.operation;
+
+		bool const in_range = op.count
+		                   && op.block_number + op.count <= _info.block_count;
+
+		switch (op.type) {
+		case Type::READ:  return in_range;
+		case Type::WRITE: return in_range && _info.writeable;
+		case Type::TRIM:  return in_range && _info.writeable;
+		case Type::SYNC:  return true;
+		default:          return false;
 		}
+	}
 
-		int _fd { -1 };
+	Job *_free_job()
+	{
+		for (unsigned i = 0; i < _num_jobs; i++)
+			if (_jobs[i].state == Job::State::FREE)
+				return &_jobs[i];
+		return nullptr;
+	}
 
-	public:
+	Job *_completed_job()
+	{
+		for (unsigned i = 0; i < _num_jobs; i++)
+			if (_jobs[i].state == Job::State::COMPLETE)
+				return &_jobs[i];
+		return nullptr;
+	}
 
-		struct Could_not_open_file : Genode::Exception { };
+	void _submit(Job &job, Block::Request const &request)
+	{
+		using Type = Block::Operation::Type;
+
+		job.request = request;
+		job.buffer  = nullptr;
+		job.done    = 0;
+		job.success = false;
+		job.offset  = request.operation.block_number*_block_size;
+		job.length  = size_t(request.operation.count*_block_size);
+		job.state   = Job::State::SUBMITTED;
+
+		if (Block::Operation::has_payload(request.operation.type))
+			with_content(request, [&] (void *ptr, size_t size) {
+				job.buffer = (char *)ptr;
+				job.length = size; });
+
+		if (request.operation.type == Type::SYNC) {
+			job.offset = 0;
+			job.length = 0;
+			_sync_in_flight = true;
+		}
 
-		Lx_block_driver(Genode::Env &env, Genode::Xml_node config)
-		:
-			Block::Driver(env.ram()),
-			_env(env),
-			_info(_init_info(config))
-		{
-			/* open file */
-			File_name const file_name = _file_name(config);
-			_fd = open(file_name.string(), _info.writeable ? O_RDWR : O_RDONLY);
-			if (_fd == -1) {
-				Genode::error("open ", file_name.string());
-				throw Could_not_open_file();
-			}
+		_in_flight++;
+		_backend.submit(job);
+	}
 
-			Genode::log("Provide '", file_name, "' as block device "
-			            "block_size:  ", _info.block_size, " "
-			            "block_count: ", _info.block_count, " "
-			            "writeable:   ", _info.writeable ? "yes" : "no");
+	void handle_requests()
+	{
+		for (;;) {
+
+			bool progress = false;
+
+			with_requests([&] (Block::Request request) {
+
+				using Response = Block::Request_stream::Response;
+
+				if (!_valid(request))
+					return Response::REJECTED;
+
+				if (_sync_in_flight)
+					return Response::RETRY;
+
+				bool const sync = (request.operation.type == Block::Operation::Type::SYNC);
+				if (sync && _in_flight)
+					return Response::RETRY;
+
+				Job * const job = _free_job();
+				if (!job)
+					return Response::RETRY;
+
+				_submit(*job, request);
+
+				progress = true;
+				return Response::ACCEPTED;
+			});
+
+			_backend.update();
+
+			try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+
+				Job * const job = _completed_job();
+				if (!job)
+					return;
+
+				Block::Request request = job->request;
+				request.success = job->success;
+				ack.submit(request);
+
+				if (request.operation.type == Block::Operation::Type::SYNC)
+					_sync_in_flight = false;
+
+				job->state = Job::State::FREE;
+				_in_flight--;
+				progress = true;
+			});
+
+			if (!progress)
+				break;
 		}
 
-		~Lx_block_driver() { close(_fd); }
+		wakeup_client_if_needed();
+	}
 
+	/**
+	 * Wait for completion of all jobs before the session is closed
+	 */
+	void drain()
+	{
+		for (;;) {
+			_backend.update();
+
+			bool submitted = false;
+			for (unsigned i = 0; i < _num_jobs; i++) {
+				if (_jobs[i].state == Job::State::SUBMITTED)
+					submitted = true;
+				if (_jobs[i].state == Job::State::COMPLETE)
+					_jobs[i].state = Job::State::FREE;
+			}
 
-		/*****************************
-		 ** Block::Driver interface **
-		 *****************************/
+			if (!submitted)
+				break;
 
-		Dma_buffer alloc_dma_buffer(Genode::size_t size, Genode::Cache) override
-		{
-			return { .ds = _env.ram().alloc(size), .dma_addr = 0 };
+			_ep.wait_and_dispatch_one_io_signal();
 		}
+	}
+};
+
 
-		Block::Session::Info info() const override { return _info; }
+struct Lx_block::Main : Rpc_object<Typed_root<Block::Session>>
+{
+	Env &_env;
 
-		void read(Block::sector_t           block_number,
-		          Genode::size_t            block_count,
-		          char                     *buffer,
-		          Block::Packet_descriptor &packet) override
-		{
-			Block::sector_t const offset = block_number * _info.block_size;
-			size_t          const count  = block_count  * _info.block_size;
+	Heap _heap { _env.ram(), _env.rm() };
 
-			ssize_t const n = pread(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pread");
-				throw Io_error();
-			}
+	Attached_rom_dataspace _config_rom { _env, "config" };
+
+	Xml_node const _config = _config_rom.xml();
 
-			ack_packet(packet);
+	File _file { _config };
+
+	/* the session stays writeable only if permitted by the configuration */
+	bool const _writeable = _file.info.writeable;
+
+	unsigned const _queue_depth =
+		min(max(_config.attribute_value("queue_depth", 32U), 1U),
+		    unsigned(MAX_QUEUE_DEPTH));
+
+	Io_signal_handler<Main> _request_handler {
+		_env.ep(), *this, &Main::_handle_requests };
+
+	using Backend_name = String<16>;
+
+	Backend_name const _backend_name =
+		_config.attribute_value("backend", Backend_name("auto"));
+
+	Constructible<Sync_backend>        _sync_backend     { };
+	Constructible<Thread_pool_backend> _thread_backend   { };
+	Constructible<Io_uring_backend>    _io_uring_backend { };
+
+	Backend &_init_backend()
+	{
+		if (_backend_name == "sync") {
+			_sync_backend.construct(_file.fd);
+			return *_sync_backend;
 		}
 
-		void write(Block::sector_t           block_number,
-		           Genode::size_t            block_count,
-		           char const               *buffer,
-		           Block::Packet_descriptor &packet) override
-		{
-			/* range check is done by Block::Driver */
-			if (!_info.writeable) {
-				throw Io_error();
+		if (_backend_name == "auto" || _backend_name == "io_uring") {
+			try {
+				_io_uring_backend.construct(_env, _file.fd, _request_handler,
+				                            _queue_depth);
+				return *_io_uring_backend;
+			}
+			catch (Io_uring_backend::Setup_failed) {
+				warning("io_uring unavailable, falling back to worker threads");
 			}
+		}
 
-			Block::sector_t  const offset = block_number * _info.block_size;
-			size_t           const count  = block_count  * _info.block_size;
+		unsigned const num_threads =
+			min(_config.attribute_value("threads", 8U), _queue_depth);
 
-			ssize_t const n = pwrite(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pwrite");
-				throw Io_error();
-			}
+		_thread_backend.construct(_env, _heap, _file.fd, _request_handler,
+		                          num_threads);
+		return *_thread_backend;
+	}
 
-			ack_packet(packet);
-		}
+	Backend &_backend = _init_backend();
 
-		void sync() override { }
-};
+	Job _jobs[MAX_QUEUE_DEPTH];
 
+	Constructible<Attached_ram_dataspace>  _block_ds      { };
+	Constructible<Block_session_component> _block_session { };
 
-struct Main
-{
-	Genode::Env  &_env;
-	Genode::Heap  _heap { _env.ram(), _env.rm() };
+	void _handle_requests()
+	{
+		if (!_block_session.constructed())
+			return;
 
-	Genode::Attached_rom_dataspace _config_rom { _env, "config" };
+		_block_session->handle_requests();
+	}
 
-	struct Factory : Block::Driver_factory
+	/*
+	 * Root interface
+	 */
+
+	Capability<Session> session(Root::Session_args const &args,
+	                            Affinity const &) override
 	{
-		Genode::Constructible<Lx_block_driver> _driver { };
+		if (_block_session.constructed())
+			throw Service_denied();
+
+		size_t const tx_buf_size =
+			Arg_string::find_arg(args.string(), "tx_buf_size").aligned_size();
+
+		Ram_quota const ram_quota = ram_quota_from_args(args.string());
 
-		Factory(Genode::Env &env, Genode::Xml_node config)
-		{
-			_driver.construct(env, config);
+		if (tx_buf_size > ram_quota.value) {
+			error("insufficient 'ram_quota', got ", ram_quota, ", need ",
+			      tx_buf_size);
+			throw Insufficient_ram_quota();
 		}
 
-		~Factory() { _driver.destruct(); }
+		Block::Session::Info info = _file.info;
+		info.writeable = _writeable
+		              && Arg_string::find_arg(args.string(), "writeable").bool_value(true);
 
-		/***********************
-		 ** Factory interface **
-		 ***********************/
+		_block_ds.construct(_env.ram(), _env.rm(), tx_buf_size);
+		_block_session.construct(_env.rm(), _env.ep(), _block_ds->cap(),
+		                         _request_handler, info, _backend,
+		                         _jobs, _queue_depth);
 
-		Block::Driver *create() override { return &*_driver; }
-		void destroy(Block::Driver *) override { }
-	} factory { _env, _config_rom.xml() };
+		return _block_session->cap();
+	}
+
+	void upgrade(Capability<Session>, Root::Upgrade_args const &) override { }
+
+	void close(Capability<Session> cap) override
+	{
+		if (!_block_session.constructed() || !(cap == _block_session->cap()))
+			return;
 
-	Block::Root root { _env.ep(), _heap, _env.rm(), factory,
-	                   xml_attr_ok(_config_rom.xml(), "writeable") };
+		_block_session->drain();
+		_block_session.destruct();
+		_block_ds.destruct();
+	}
 
-	Main(Genode::Env &env) : _env(env)
+	Main(Env &env) : _env(env)
 	{
-		_env.parent().announce(_env.ep().manage(root));
+		log("using ", _backend.name(), " backend with queue depth ", _queue_depth);
+
+		_env.parent().announce(_env.ep().manage(*this));
 	}
 };
 
 
-void Component::construct(Genode::Env &env) { static Main main(env); }
+void Component::construct(Genode::Env &env) { static Lx_block::Main main(env); }
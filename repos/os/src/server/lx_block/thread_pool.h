@@ -0,0 +1,185 @@
+/*
+ * \brief  Backends performing blocking file I/O
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LX_BLOCK__THREAD_POOL_H_
+#define _LX_BLOCK__THREAD_POOL_H_
+
+/* Genode includes */
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+
+/* local includes */
+#include "job.h"
+
+namespace Lx_block {
+
+	class Sync_backend;
+	class Thread_pool_backend;
+}
+
+
+/**
+ * Backend executing each job on the entrypoint
+ */
+class Lx_block::Sync_backend : public Backend
+{
+	private:
+
+		int const _fd;
+
+	public:
+
+		Sync_backend(int fd) : _fd(fd) { }
+
+		char const *name() const override { return "sync"; }
+
+		void submit(Job &job) override
+		{
+			job.success = execute(_fd, job);
+			job.state   = Job::State::COMPLETE;
+		}
+
+		void update() override { }
+};
+
+
+/**
+ * Backend distributing jobs to a pool of worker threads
+ */
+class Lx_block::Thread_pool_backend : public Backend
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_pool_backend(Thread_pool_backend const &);
+		Thread_pool_backend &operator = (Thread_pool_backend const &);
+
+		int const _fd;
+
+		Signal_context &_completion_sigh;
+
+		/*
+		 * Jobs are passed between the entrypoint and the workers via
+		 * bounded rings of job pointers, both protected by '_mutex'
+		 */
+		struct Ring
+		{
+			enum { CAPACITY = 256 };
+
+			Job     *_jobs[CAPACITY] { };
+			unsigned _head = 0, _tail = 0;
+
+			bool empty() const { return _head == _tail; }
+
+			void push(Job &job) { _jobs[_tail++ % CAPACITY] = &job; }
+
+			Job &pop() { return *_jobs[_head++ % CAPACITY]; }
+		};
+
+		Mutex     _mutex     { };
+		Semaphore _submitted { };
+		Ring      _pending   { };
+		Ring      _completed { };
+
+		struct Worker : Thread
+		{
+			Thread_pool_backend &_pool;
+
+			Worker(Env &env, Thread_pool_backend &pool, unsigned index)
+			:
+				Thread(env, Name("worker", index), 16*1024), _pool(pool)
+			{
+				start();
+			}
+
+			void entry() override
+			{
+				for (;;)
+					_pool._process_one_job();
+			}
+		};
+
+		void _process_one_job()
+		{
+			_submitted.down();
+
+			Job *job_ptr = nullptr;
+			{
+				Mutex::Guard guard(_mutex);
+				job_ptr = &_pending.pop();
+			}
+
+			bool const success = execute(_fd, *job_ptr);
+
+			{
+				Mutex::Guard guard(_mutex);
+				job_ptr->success = success;
+				_completed.push(*job_ptr);
+			}
+
+			_completion_sigh.local_submit();
+		}
+
+		Allocator &_alloc;
+
+		unsigned const _num_workers;
+
+		Worker **_workers = (Worker **)_alloc.alloc(_num_workers*sizeof(Worker *));
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_workers  number of worker threads, which is the maximum
+		 *                     number of jobs processed in parallel
+		 */
+		Thread_pool_backend(Env &env, Allocator &alloc, int fd,
+		                    Signal_context &completion_sigh, unsigned num_workers)
+		:
+			_fd(fd), _completion_sigh(completion_sigh), _alloc(alloc),
+			_num_workers(max(num_workers, 1U))
+		{
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i] = new (_alloc) Worker(env, *this, i);
+		}
+
+		/*
+		 * The workers block in their semaphore forever, hence the backend
+		 * lives as long as the component.
+		 */
+
+		char const *name() const override { return "threads"; }
+
+		void submit(Job &job) override
+		{
+			{
+				Mutex::Guard guard(_mutex);
+				_pending.push(job);
+			}
+			_submitted.up();
+		}
+
+		void update() override
+		{
+			Mutex::Guard guard(_mutex);
+
+			while (!_completed.empty())
+				_completed.pop().state = Job::State::COMPLETE;
+		}
+};
+
+#endif /* _LX_BLOCK__THREAD_POOL_H_ */
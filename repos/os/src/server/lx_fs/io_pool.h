@@ -0,0 +1,277 @@
+/*
+ * \brief  Pool of worker threads executing packet operations
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IO_POOL_H_
+#define _IO_POOL_H_
+
+/* Genode includes */
+#include <base/blockade.h>
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <util/fifo.h>
+
+/* local includes */
+#include "node.h"
+
+namespace Lx_fs {
+
+	struct Io_job;
+	class  Io_pool;
+
+	inline bool execute_io(File_system::Packet_descriptor &, Node &, char *content);
+}
+
+
+/**
+ * Execute READ, WRITE, or SYNC operation of 'packet' on 'node'
+ *
+ * The function updates the length and success state of the packet and may
+ * be called by any thread as long as 'node' is not accessed concurrently.
+ *
+ * \return false if the packet must not be acknowledged
+ */
+bool Lx_fs::execute_io(File_system::Packet_descriptor &packet, Node &node,
+                       char *content)
+{
+	size_t const length = packet.length();
+
+	/* resulting length */
+	size_t res_length = 0;
+	bool   succeeded  = false;
+
+	switch (packet.operation()) {
+
+	case File_system::Packet_descriptor::READ:
+
+		res_length = node.read(content, length, packet.position());
+
+		/* read data or EOF is a success */
+		succeeded = res_length || (packet.position() >= node.status().size);
+		break;
+
+	case File_system::Packet_descriptor::WRITE:
+
+		res_length = node.write(content, length, packet.position());
+
+		/* File system session can't handle partial writes */
+		if (res_length != length) {
+			/* don't acknowledge */
+			return false;
+		}
+		succeeded = true;
+		break;
+
+	case File_system::Packet_descriptor::SYNC:
+
+		succeeded = node.sync();
+		break;
+
+	default: break;
+	}
+
+	packet.length(res_length);
+	packet.succeeded(succeeded);
+	return true;
+}
+
+
+/**
+ * Packet operation tracked by a session
+ */
+struct Lx_fs::Io_job : Genode::Fifo<Io_job>::Element
+{
+	enum class State { FREE, WAITING, IN_FLIGHT, COMPLETE };
+
+	State state = State::FREE;
+
+	File_system::Packet_descriptor packet { };
+
+	/* arrival order, used to preserve the order of operations per handle */
+	unsigned long seq = 0;
+
+	/* whether the packet is acknowledged once completed */
+	bool ack = true;
+
+	/* members accessed by the worker, valid while the job is in flight */
+	Node                    *node    = nullptr;
+	char                    *content = nullptr;
+	Genode::Signal_context  *sigh    = nullptr;
+
+	/* members protected by the mutex of the pool */
+	bool               done   = false;
+	Genode::Blockade  *waiter = nullptr;
+
+	Io_job() { }
+
+	/*
+	 * Noncopyable
+	 */
+	Io_job(Io_job const &) = delete;
+	Io_job &operator = (Io_job const &) = delete;
+};
+
+
+/**
+ * Pool of worker threads shared by all sessions
+ *
+ * Once a job is executed, the worker submits the signal context of the job
+ * to let the session collect the result at the entrypoint.
+ */
+class Lx_fs::Io_pool
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Io_pool(Io_pool const &) = delete;
+		Io_pool &operator = (Io_pool const &) = delete;
+
+		Genode::Mutex        _mutex     { };
+		Genode::Semaphore    _submitted { };
+		Genode::Fifo<Io_job> _pending   { };
+
+		struct Worker : Genode::Thread
+		{
+			Io_pool &_pool;
+
+			Worker(Genode::Env &env, Io_pool &pool, unsigned index)
+			:
+				Genode::Thread(env, Name("io_worker", index), 16*1024),
+				_pool(pool)
+			{
+				start();
+			}
+
+			void entry() override
+			{
+				for (;;)
+					_pool._process_one_job();
+			}
+		};
+
+		void _process_one_job()
+		{
+			_submitted.down();
+
+			Io_job *job_ptr = nullptr;
+			{
+				Genode::Mutex::Guard guard(_mutex);
+				_pending.dequeue([&] (Io_job &job) { job_ptr = &job; });
+			}
+
+			if (!job_ptr)
+				return;
+
+			bool const ack = execute_io(job_ptr->packet, *job_ptr->node,
+			                            job_ptr->content);
+
+			/*
+			 * The signal is submitted while holding the mutex so that a
+			 * session waiting in 'wait' cannot vanish in between.
+			 */
+			Genode::Mutex::Guard guard(_mutex);
+
+			job_ptr->ack  = ack;
+			job_ptr->done = true;
+
+			if (job_ptr->waiter)
+				job_ptr->waiter->wakeup();
+
+			job_ptr->sigh->local_submit();
+		}
+
+		Genode::Allocator &_alloc;
+
+		unsigned const _num_workers;
+
+		Worker **_workers = (Worker **)_alloc.alloc(_num_workers*sizeof(Worker *));
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_workers  number of worker threads, which is the maximum
+		 *                     number of operations processed in parallel
+		 */
+		Io_pool(Genode::Env &env, Genode::Allocator &alloc, unsigned num_workers)
+		:
+			_alloc(alloc), _num_workers(Genode::max(num_workers, 1U))
+		{
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i] = new (_alloc) Worker(env, *this, i);
+		}
+
+		/*
+		 * The workers block in their semaphore forever, hence the pool
+		 * lives as long as the component.
+		 */
+
+		unsigned num_workers() const { return _num_workers; }
+
+		/**
+		 * Hand over job to the workers
+		 *
+		 * \param sigh  signal context submitted once the job is done
+		 */
+		void submit(Io_job &job, Node &node, char *content,
+		            Genode::Signal_context &sigh)
+		{
+			job.node    = &node;
+			job.content = content;
+			job.sigh    = &sigh;
+			job.done    = false;
+			job.waiter  = nullptr;
+			job.state   = Io_job::State::IN_FLIGHT;
+
+			{
+				Genode::Mutex::Guard guard(_mutex);
+				_pending.enqueue(job);
+			}
+			_submitted.up();
+		}
+
+		/**
+		 * Return true if the worker finished the in-flight 'job'
+		 */
+		bool done(Io_job &job)
+		{
+			Genode::Mutex::Guard guard(_mutex);
+			return job.done;
+		}
+
+		/**
+		 * Block until the in-flight 'job' is done
+		 */
+		void wait(Io_job &job)
+		{
+			Genode::Blockade blockade { };
+			{
+				Genode::Mutex::Guard guard(_mutex);
+				if (job.done)
+					return;
+
+				job.waiter = &blockade;
+			}
+
+			blockade.block();
+
+			/* synchronize with the worker leaving '_process_one_job' */
+			Genode::Mutex::Guard guard(_mutex);
+			job.waiter = nullptr;
+		}
+};
+
+#endif /* _IO_POOL_H_ */
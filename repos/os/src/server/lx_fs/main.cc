@@ -28,6 +28,7 @@
 
 /* local includes */
 #include "directory.h"
+#include "io_pool.h"
 #include "notifier.h"
 #include "open_node.h"
 #include "watch.h"
@@ -94,6 +95,12 @@ class Lx_fs::Session_component : private Session_resources,
 		using Dir_node       = File_system::Open_node<Directory>;
 		using Signal_handler = Genode::Signal_handler<Session_component>;
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &) = delete;
+		Session_component &operator = (Session_component const &) = delete;
+
 		Genode::Env                 &_env;
 		Directory                   &_root;
 		Id_space<File_system::Node>  _open_node_registry { };
@@ -102,19 +109,39 @@ class Lx_fs::Session_component : private Session_resources,
 		Signal_handler               _process_packet_dispatcher;
 		Notifier                    &_notifier;
 
+		/*
+		 * Pool of worker threads, or nullptr if packets are processed
+		 * synchronously
+		 */
+		Io_pool                     *_io_pool;
+
+		/*
+		 * Packets of the asynchronous mode, each job holds one packet
+		 * obtained from the packet stream until it is acknowledged
+		 */
+		Io_job        _jobs[File_system::Session::TX_QUEUE_SIZE];
+		unsigned long _job_seq = 0;
+
 		/******************************
 		 ** Packet-stream processing **
 		 ******************************/
 
 		/**
-		 * Perform packet operation
-		 *
-		 * \return true on success, false on failure
+		 * Return true if packet data is accessible
 		 */
-		void _process_packet_op(Packet_descriptor &packet, Open_node &open_node)
+		bool _valid_payload(Packet_descriptor const &packet)
 		{
-			size_t const length  = packet.length();
+			return tx_sink()->packet_valid(packet)
+			    && (packet.length() <= packet.size());
+		}
 
+		/**
+		 * Execute packet operation
+		 *
+		 * \return false if the packet must not be acknowledged
+		 */
+		bool _execute_packet_op(Packet_descriptor &packet, Open_node &open_node)
+		{
 			/* resulting length */
 			size_t res_length = 0;
 			bool succeeded = false;
@@ -122,28 +149,10 @@ class Lx_fs::Session_component : private Session_resources,
 			switch (packet.operation()) {
 
 			case Packet_descriptor::READ:
-				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
-					res_length = open_node.node().read((char *)tx_sink()->packet_content(packet), length,
-					                                   packet.position());
-
-					/* read data or EOF is a success */
-					succeeded = res_length || (packet.position() >= open_node.node().status().size);
-				}
-				break;
-
 			case Packet_descriptor::WRITE:
-				if (tx_sink()->packet_valid(packet) && (packet.length() <= packet.size())) {
-					res_length = open_node.node().write((char const *)tx_sink()->packet_content(packet),
-					                                    length,
-					                                    packet.position());
-
-					/* File system session can't handle partial writes */
-					if (res_length != length) {
-						/* don't acknowledge */
-						return;
-					}
-					succeeded = true;
-				}
+				if (_valid_payload(packet))
+					return execute_io(packet, open_node.node(),
+					                  (char *)tx_sink()->packet_content(packet));
 				break;
 
 			case Packet_descriptor::WRITE_TIMESTAMP:
@@ -161,7 +170,7 @@ class Lx_fs::Session_component : private Session_resources,
 				/* notify_listeners may bounce the packet back*/
 				open_node.node().notify_listeners();
 				/* otherwise defer acknowledgement of this packet */
-				return;
+				return false;
 
 			case Packet_descriptor::READ_READY:
 				succeeded = true;
@@ -170,16 +179,202 @@ class Lx_fs::Session_component : private Session_resources,
 
 			case Packet_descriptor::SYNC:
 
-				if (tx_sink()->packet_valid(packet)) {
-					succeeded = open_node.node().sync();
-				}
+				if (tx_sink()->packet_valid(packet))
+					return execute_io(packet, open_node.node(), nullptr);
 
 				break;
 			}
 
 			packet.length(res_length);
 			packet.succeeded(succeeded);
-			tx_sink()->acknowledge_packet(packet);
+			return true;
+		}
+
+		/**
+		 * Perform packet operation and acknowledge the packet
+		 */
+		void _process_packet_op(Packet_descriptor &packet, Open_node &open_node)
+		{
+			if (_execute_packet_op(packet, open_node))
+				tx_sink()->acknowledge_packet(packet);
+		}
+
+		/**
+		 * Return true if the packet operation can be executed by a worker
+		 *
+		 * Only file content is accessed by the workers. All other
+		 * operations are cheap and executed at the entrypoint.
+		 */
+		bool _async_op(Packet_descriptor const &packet, Open_node &open_node)
+		{
+			if (open_node.node().type_directory())
+				return false;
+
+			switch (packet.operation()) {
+			case Packet_descriptor::READ:
+			case Packet_descriptor::WRITE: return _valid_payload(packet);
+			case Packet_descriptor::SYNC:  return tx_sink()->packet_valid(packet);
+			default:                       return false;
+			}
+		}
+
+		template <typename FN>
+		void _for_each_job(Io_job::State state, FN const &fn)
+		{
+			for (Io_job &job : _jobs)
+				if (job.state == state)
+					fn(job);
+		}
+
+		/**
+		 * Return waiting job of 'handle' that arrived first, or nullptr
+		 */
+		Io_job *_next_waiting_job(Node_handle handle)
+		{
+			Io_job *next = nullptr;
+			_for_each_job(Io_job::State::WAITING, [&] (Io_job &job) {
+				if (job.packet.handle() == handle)
+					if (!next || job.seq < next->seq)
+						next = &job; });
+			return next;
+		}
+
+		/**
+		 * Start the waiting jobs of 'handle' in order of their arrival
+		 *
+		 * The operations of a handle are executed strictly one after
+		 * another, whereas different handles are served in parallel.
+		 */
+		void _dispatch_jobs(Node_handle handle)
+		{
+			bool in_flight = false;
+			_for_each_job(Io_job::State::IN_FLIGHT, [&] (Io_job &job) {
+				if (job.packet.handle() == handle)
+					in_flight = true; });
+
+			while (!in_flight) {
+
+				Io_job *job_ptr = _next_waiting_job(handle);
+				if (!job_ptr)
+					return;
+
+				Io_job &job = *job_ptr;
+
+				job.state = Io_job::State::COMPLETE;
+				job.ack   = true;
+
+				try {
+					_open_node_registry.apply<Open_node>(handle, [&] (Open_node &open_node) {
+
+						if (!_async_op(job.packet, open_node)) {
+							job.ack = _execute_packet_op(job.packet, open_node);
+							return;
+						}
+
+						char *content = (job.packet.operation() == Packet_descriptor::SYNC)
+						              ? nullptr
+						              : (char *)tx_sink()->packet_content(job.packet);
+
+						_io_pool->submit(job, open_node.node(), content,
+						                 _process_packet_dispatcher);
+						in_flight = true;
+					});
+				} catch (Id_space<File_system::Node>::Unknown_id const &) {
+					Genode::error("Invalid_handle");
+				}
+			}
+		}
+
+		/**
+		 * Mark jobs finished by the workers as complete
+		 */
+		void _collect_completed_jobs()
+		{
+			_for_each_job(Io_job::State::IN_FLIGHT, [&] (Io_job &job) {
+				if (!_io_pool->done(job))
+					return;
+
+				job.state = Io_job::State::COMPLETE;
+				_dispatch_jobs(job.packet.handle());
+			});
+		}
+
+		/**
+		 * Acknowledge complete jobs in order of their arrival
+		 */
+		void _acknowledge_completed_jobs()
+		{
+			for (;;) {
+
+				Io_job *first = nullptr;
+				_for_each_job(Io_job::State::COMPLETE, [&] (Io_job &job) {
+					if (!first || job.seq < first->seq)
+						first = &job; });
+
+				if (!first)
+					return;
+
+				if (first->ack) {
+					if (!tx_sink()->ready_to_ack())
+						return;
+
+					tx_sink()->acknowledge_packet(first->packet);
+				}
+
+				first->state = Io_job::State::FREE;
+			}
+		}
+
+		Io_job *_free_job()
+		{
+			for (Io_job &job : _jobs)
+				if (job.state == Io_job::State::FREE)
+					return &job;
+			return nullptr;
+		}
+
+		/**
+		 * Wait for the in-flight job of 'handle' and drop waiting ones
+		 */
+		void _discard_jobs(Node_handle handle)
+		{
+			_for_each_job(Io_job::State::IN_FLIGHT, [&] (Io_job &job) {
+				if (job.packet.handle() == handle) {
+					_io_pool->wait(job);
+					job.state = Io_job::State::COMPLETE;
+				}
+			});
+
+			_for_each_job(Io_job::State::WAITING, [&] (Io_job &job) {
+				if (job.packet.handle() == handle)
+					job.state = Io_job::State::COMPLETE; });
+		}
+
+		/**
+		 * Asynchronous counterpart of '_process_packets'
+		 */
+		void _process_packets_async()
+		{
+			_collect_completed_jobs();
+			_acknowledge_completed_jobs();
+
+			while (tx_sink()->packet_avail() && tx_sink()->ready_to_ack()) {
+
+				Io_job *job_ptr = _free_job();
+				if (!job_ptr)
+					break;
+
+				Io_job &job = *job_ptr;
+
+				job.packet = tx_sink()->get_packet();
+				job.packet.succeeded(false);
+				job.seq    = _job_seq++;
+				job.state  = Io_job::State::WAITING;
+
+				_dispatch_jobs(job.packet.handle());
+			}
+
+			_acknowledge_completed_jobs();
 		}
 
 		void _process_packet()
@@ -207,6 +402,11 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		void _process_packets()
 		{
+			if (_io_pool) {
+				_process_packets_async();
+				return;
+			}
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -297,7 +497,8 @@ class Lx_fs::Session_component : private Session_resources,
 		                  size_t               tx_buf_size,
 		                  char const          *root_dir,
 		                  bool                 writeable,
-		                  Notifier            &notifier)
+		                  Notifier            &notifier,
+		                  Io_pool             *io_pool)
 		:
 			Session_resources { env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size },
 			Session_rpc_object {_packet_ds.cap(), env.rm(), env.ep().rpc_ep() },
@@ -306,7 +507,8 @@ class Lx_fs::Session_component : private Session_resources,
 			_writeable { writeable },
 			_root_dir { root_dir },
 			_process_packet_dispatcher { env.ep(), *this, &Session_component::_process_packets },
-			_notifier { notifier }
+			_notifier { notifier },
+			_io_pool { io_pool }
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -321,6 +523,11 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		~Session_component()
 		{
+			/* the workers must not access any node or packet hereafter */
+			if (_io_pool)
+				_for_each_job(Io_job::State::IN_FLIGHT, [&] (Io_job &job) {
+					_io_pool->wait(job); });
+
 			List<List_element<Open_node>> node_list;
 
 			auto collect_fn = [&node_list, this] (Open_node &open_node) {
@@ -446,6 +653,9 @@ class Lx_fs::Session_component : private Session_resources,
 
 		void close(Node_handle handle) override
 		{
+			if (_io_pool)
+				_discard_jobs(handle);
+
 			_with_open_node(handle, [&] (Open_node &open_node) {
 				Node &node = open_node.node();
 				destroy(_alloc, &open_node);
@@ -547,6 +757,16 @@ class Lx_fs::Root : public Root_component<Session_component>
 		Genode::Attached_rom_dataspace  _config   { _env, "config" };
 		Notifier                        _notifier { _env };
 
+		/*
+		 * Packet operations on files are executed asynchronously by a
+		 * pool of worker threads if configured via the 'workers' attribute
+		 */
+		Genode::Heap _heap { _env.ram(), _env.rm() };
+
+		unsigned const _num_workers = _config.xml().attribute_value("workers", 0U);
+
+		Genode::Constructible<Io_pool> _io_pool { };
+
 		static inline bool writeable_from_args(char const *args)
 		{
 			return { Arg_string::find_arg(args, "writeable").bool_value(true) };
@@ -628,7 +848,9 @@ class Lx_fs::Root : public Root_component<Session_component>
 				                           Genode::Cap_quota { cap_quota },
 				                           tx_buf_size,
 				                           absolute_root_dir(root_dir).string(),
-				                           writeable, _notifier };
+				                           writeable, _notifier,
+				                           _io_pool.constructed() ? &*_io_pool
+				                                                  : nullptr };
 
 				auto ram_used { _env.pd().used_ram().value - initial_ram_usage };
 				auto cap_used { _env.pd().used_caps().value - initial_cap_usage };
@@ -681,7 +903,13 @@ class Lx_fs::Root : public Root_component<Session_component>
 		:
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
 			_env(env)
-		{ }
+		{
+			if (_num_workers) {
+				_io_pool.construct(_env, _heap, _num_workers);
+				Genode::log("asynchronous I/O using ", _io_pool->num_workers(),
+				            " worker threads");
+			}
+		}
 };
 
 
@@ -25,6 +25,7 @@
 
 /* Genode includes */
 #include <mixer/channel.h>
+#include <mixer/dsp.h>
 #include <os/reporter.h>
 #include <root/component.h>
 #include <util/retry.h>
@@ -41,6 +42,8 @@
 
 using Channel = Mixer::Channel;
 
+namespace Dsp = Mixer::Dsp;
+
 
 static constexpr int LEFT         = Channel::Number::LEFT;
 static constexpr int RIGHT        = Channel::Number::RIGHT;
@@ -311,25 +314,12 @@ class Audio_out::Mixer
 		void _mix_packet(Packet *out, Packet *in, bool clear,
 		                 float const out_vol, float const vol)
 		{
-			if (clear) {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i]  = (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			} else {
-				for_each_index(Audio_out::PERIOD, [&] (int const i) {
-					out->content()[i] += (in->content()[i] * vol);
-
-					if (out->content()[i] > 1) out->content()[i] = 1;
-					if (out->content()[i] < -1) out->content()[i] = -1;
-
-					out->content()[i] *= out_vol;
-				});
-			}
+			if (clear)
+				Dsp::scale_clipped(out->content(), in->content(),
+				                   Audio_out::PERIOD, vol, out_vol);
+			else
+				Dsp::mix_clipped(out->content(), in->content(),
+				                 Audio_out::PERIOD, vol, out_vol);
 
 			/* mark the packet as processed by invalidating it */
 			in->invalidate();
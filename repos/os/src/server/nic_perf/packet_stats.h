@@ -36,6 +36,8 @@ class Nic_perf::Packet_stats
 		unsigned _period_ms   { 0 };
 		float    _rx_mbit_sec { 0.0 };
 		float    _tx_mbit_sec { 0.0 };
+		size_t   _rx_pps      { 0 };
+		size_t   _tx_pps      { 0 };
 
 	public:
 
@@ -51,6 +53,8 @@ class Nic_perf::Packet_stats
 			_recv_bytes = 0;
 			_rx_mbit_sec = 0;
 			_tx_mbit_sec = 0;
+			_rx_pps = 0;
+			_tx_pps = 0;
 		}
 
 		void rx_packet(size_t bytes)
@@ -73,15 +77,19 @@ class Nic_perf::Packet_stats
 
 			_rx_mbit_sec = (float)(_recv_bytes * 8ULL) / (float)(period_ms*1000ULL);
 			_tx_mbit_sec = (float)(_sent_bytes * 8ULL) / (float)(period_ms*1000ULL);
+			_rx_pps      = (size_t)((_recv_cnt * 1000ULL) / period_ms);
+			_tx_pps      = (size_t)((_sent_cnt * 1000ULL) / period_ms);
 		}
 
 		void print(Output &out) const
 		{
 			Genode::print(out, "# Stats for session ", _label, "\n");
 			Genode::print(out, "  Received ", _recv_cnt, " packets in ",
-			              _period_ms, "ms at ", _rx_mbit_sec, "Mbit/s\n");
+			              _period_ms, "ms at ", _rx_mbit_sec, "Mbit/s (",
+			              _rx_pps, " packets/s)\n");
 			Genode::print(out, "  Sent     ", _sent_cnt, " packets in ",
-			              _period_ms, "ms at ", _tx_mbit_sec, "Mbit/s\n");
+			              _period_ms, "ms at ", _tx_mbit_sec, "Mbit/s (",
+			              _tx_pps, " packets/s)\n");
 		}
 
 };
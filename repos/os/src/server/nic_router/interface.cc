@@ -18,6 +18,7 @@
 #include <net/arp.h>
 #include <net/internet_checksum.h>
 #include <base/quota_guard.h>
+#include <nic/packet_allocator.h>
 
 /* local includes */
 #include <interface.h>
@@ -336,8 +337,17 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
                                      void                  *const  prot_base,
                                      size_t                 const  prot_size)
 {
-	_update_checksum(
-		prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
+	/*
+	 * The checksum of a frame with a partial checksum gets completed not
+	 * before leaving an interface without offloading. Until then, only the
+	 * pseudo-header sum must reflect the modified addresses.
+	 */
+	if (_rx_offload.csum_partial()) {
+		if (!update_pseudo_header_checksum(_rx_offload, &eth, size_guard.total_size()))
+			return;
+	} else
+		_update_checksum(
+			prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
 
 	ip.update_checksum(ip_icd);
 	domain.interfaces().for_each([&] (Interface &interface)
@@ -346,7 +356,7 @@ void Interface::_pass_prot_to_domain(Domain                       &domain,
 		if (!domain.use_arp()) {
 			eth.dst(interface._router_mac);
 		}
-		interface.send(eth, size_guard);
+		interface.send(eth, size_guard, _rx_offload);
 	});
 }
 
@@ -958,7 +968,7 @@ void Interface::_domain_broadcast(Ethernet_frame &eth,
 {
 	local_domain.interfaces().for_each([&] (Interface &interface) {
 		if (&interface != this) {
-			interface.send(eth, size_guard);
+			interface.send(eth, size_guard, _rx_offload);
 		}
 	});
 }
@@ -1426,7 +1436,7 @@ Packet_result Interface::_handle_ip(Ethernet_frame          &eth,
 			if (result.valid())
 				return;
 			remote_domain.interfaces().for_each([&] (Interface &interface) {
-				interface.send(eth, size_guard);
+				interface.send(eth, size_guard, _rx_offload);
 			});
 			result = packet_handled();
 		},
@@ -1639,6 +1649,31 @@ void Interface::_drop_packet(Packet_descriptor const &pkt, char const *reason)
 }
 
 
+Packet_result Interface::_handle_pkt_content(Packet_descriptor const &pkt)
+{
+	char   *eth_base { _sink.packet_content(pkt) };
+	size_t  eth_size { pkt.size() };
+
+	/* strip offload metadata, which is evaluated when passing the frame on */
+	_rx_offload = { };
+	if (_offload) {
+		if (eth_size <= sizeof(Offload_header))
+			return packet_drop("missing offload header");
+
+		_rx_offload = *(Offload_header const *)eth_base;
+		eth_base += sizeof(Offload_header);
+		eth_size -= sizeof(Offload_header);
+
+	} else if (eth_size > Nic::Packet_allocator::OFFSET_PACKET_SIZE) {
+
+		/* only super-frames of sessions with offloading may exceed the MTU */
+		return packet_drop("packet exceeds MTU");
+	}
+	Size_guard size_guard(eth_size);
+	return _handle_eth(eth_base, size_guard, pkt);
+}
+
+
 void Interface::_handle_pkt()
 {
 	Packet_descriptor const pkt = _sink.get_packet();
@@ -1646,8 +1681,7 @@ void Interface::_handle_pkt()
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
 	}
-	Size_guard size_guard(pkt.size());
-	Packet_result result = _handle_eth(_sink.packet_content(pkt), size_guard, pkt);
+	Packet_result result = _handle_pkt_content(pkt);
 	switch (result.type) {
 	case Packet_result::HANDLED: _ack_packet(pkt); break;
 	case Packet_result::POSTPONED: break;
@@ -1721,8 +1755,7 @@ void Interface::_continue_handle_eth(Packet_descriptor const &pkt)
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
 	}
-	Size_guard size_guard(pkt.size());
-	Packet_result result = _handle_eth(_sink.packet_content(pkt), size_guard, pkt);
+	Packet_result result = _handle_pkt_content(pkt);
 	switch (result.type) {
 	case Packet_result::HANDLED: _ack_packet(pkt); break;
 	case Packet_result::POSTPONED: _drop_packet(pkt, "postponed twice"); break;
@@ -1869,6 +1902,49 @@ void Interface::send(Ethernet_frame &eth,
 }
 
 
+void Interface::send(Ethernet_frame       &eth,
+                     Size_guard           &size_guard,
+                     Offload_header const &offload)
+{
+	size_t const size { size_guard.total_size() };
+
+	if (offload.complete()) {
+		send(eth, size_guard);
+		return;
+	}
+	if (_offload) {
+		_send(offload, size, [&] (void *pkt_base, Size_guard &) {
+			Genode::memcpy(pkt_base, (void *)&eth, size); });
+		return;
+	}
+	/* resolve offload metadata for a counter side without offloading */
+	switch (offload.gso()) {
+	case Offload_header::GSO_NONE:
+
+		send(size, [&] (void *pkt_base, Size_guard &) {
+			Genode::memcpy(pkt_base, (void *)&eth, size);
+			complete_checksum(offload, pkt_base, size);
+		});
+		return;
+
+	case Offload_header::GSO_TCPV4:
+
+		if (!for_each_tcp_segment(offload, &eth, size,
+			[&] (size_t seg_size, auto const &write_segment) {
+				send(seg_size, [&] (void *pkt_base, Size_guard &) {
+					write_segment(pkt_base); }); }))
+		{
+			_failed_to_send_packet_segment();
+		}
+		return;
+
+	default:
+
+		_failed_to_send_packet_segment();
+	}
+}
+
+
 void Interface::_send_submit_pkt(Packet_descriptor &pkt,
                                  void            * &pkt_base,
                                  size_t             pkt_size)
@@ -1903,7 +1979,8 @@ Interface::Interface(Genode::Entrypoint     &ep,
                      Interface_list         &interfaces,
                      Packet_stream_sink     &sink,
                      Packet_stream_source   &source,
-                     Interface_policy       &policy)
+                     Interface_policy       &policy,
+                     bool                    offload)
 :
 	_sink                      { sink },
 	_source                    { source },
@@ -1914,7 +1991,8 @@ Interface::Interface(Genode::Entrypoint     &ep,
 	_policy                    { policy },
 	_timer                     { timer },
 	_alloc                     { alloc },
-	_interfaces                { interfaces }
+	_interfaces                { interfaces },
+	_offload                   { offload }
 {
 	_interfaces.insert(this);
 	_config_ptr->with_report([&] (Report &r) { r.handle_interface_link_state(); });
@@ -2169,6 +2247,13 @@ void Interface::_failed_to_send_packet_alloc()
 }
 
 
+void Interface::_failed_to_send_packet_segment()
+{
+	if (_config_ptr->verbose()) {
+		log("[", *_domain_ptr, "] failed to send packet (segmentation failed)"); }
+}
+
+
 void Interface::handle_config_2()
 {
 	Domain_name const &new_domain_name = _policy.determine_domain_name();
@@ -26,6 +26,7 @@
 /* Genode includes */
 #include <net/dhcp.h>
 #include <net/icmp.h>
+#include <net/offload.h>
 
 namespace Genode { class Xml_generator; }
 
@@ -172,6 +173,8 @@ class Net::Interface : private Interface_list::Element
 		Interface_object_stats                _arp_stats                 { };
 		Interface_object_stats                _dhcp_stats                { };
 		unsigned long                         _dropped_fragm_ipv4        { 0 };
+		bool                           const  _offload;
+		Offload_header                        _rx_offload                { };
 
 		/*
 		 * Noncopyable
@@ -310,6 +313,8 @@ class Net::Interface : private Interface_list::Element
 
 		void _handle_pkt();
 
+		[[nodiscard]] Packet_result _handle_pkt_content(Packet_descriptor const &pkt);
+
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
 		Ipv4_address const &_router_ip() const;
@@ -364,6 +369,8 @@ class Net::Interface : private Interface_list::Element
 
 		void _failed_to_send_packet_alloc();
 
+		void _failed_to_send_packet_segment();
+
 		void _send_icmp_dst_unreachable(Ipv4_address_prefix const &local_intf,
 		                                Ethernet_frame      const &req_eth,
 		                                Ipv4_packet         const &req_ip,
@@ -377,24 +384,9 @@ class Net::Interface : private Interface_list::Element
 
 		void _refetch_domain_ready_state();
 
-	public:
-
-		Interface(Genode::Entrypoint     &ep,
-		          Cached_timer           &timer,
-		          Mac_address      const  router_mac,
-		          Genode::Allocator      &alloc,
-		          Mac_address      const  mac,
-		          Configuration          &config,
-		          Interface_list         &interfaces,
-		          Packet_stream_sink     &sink,
-		          Packet_stream_source   &source,
-		          Interface_policy       &policy);
-
-		virtual ~Interface();
-
-		void dhcp_allocation_expired(Dhcp_allocation &allocation);
-
-		void send(Genode::size_t pkt_size, auto const &write_to_pkt)
+		void _send(Offload_header const &offload,
+		           Genode::size_t        pkt_size,
+		           auto           const &write_to_pkt)
 		{
 			if (!link_state()) {
 				_failed_to_send_packet_link();
@@ -404,13 +396,20 @@ class Net::Interface : private Interface_list::Element
 				_failed_to_send_packet_submit();
 				return;
 			}
-			_source.alloc_packet_attempt(pkt_size).with_result(
+			/* with offloading, each packet starts with the offload header */
+			Genode::size_t const hdr_size { _offload ? sizeof(Offload_header) : 0 };
+
+			_source.alloc_packet_attempt(hdr_size + pkt_size).with_result(
 				[&] (Packet_descriptor pkt)
 				{
-					void *pkt_base { _source.packet_content(pkt) };
+					char *pkt_base { _source.packet_content(pkt) };
+					if (_offload)
+						*(Offload_header *)pkt_base = offload;
+
+					void *eth_base { pkt_base + hdr_size };
 					Size_guard size_guard(pkt_size);
-					write_to_pkt(pkt_base, size_guard);
-					_send_submit_pkt(pkt, pkt_base, pkt_size);
+					write_to_pkt(eth_base, size_guard);
+					_send_submit_pkt(pkt, eth_base, pkt_size);
 				},
 				[&] (Packet_stream_source::Alloc_packet_error)
 				{
@@ -419,9 +418,43 @@ class Net::Interface : private Interface_list::Element
 			);
 		}
 
+	public:
+
+		Interface(Genode::Entrypoint     &ep,
+		          Cached_timer           &timer,
+		          Mac_address      const  router_mac,
+		          Genode::Allocator      &alloc,
+		          Mac_address      const  mac,
+		          Configuration          &config,
+		          Interface_list         &interfaces,
+		          Packet_stream_sink     &sink,
+		          Packet_stream_source   &source,
+		          Interface_policy       &policy,
+		          bool                    offload);
+
+		virtual ~Interface();
+
+		void dhcp_allocation_expired(Dhcp_allocation &allocation);
+
+		void send(Genode::size_t pkt_size, auto const &write_to_pkt)
+		{
+			_send(Offload_header { }, pkt_size, write_to_pkt);
+		}
+
 		void send(Ethernet_frame &eth,
 		          Size_guard     &size_guard);
 
+		/**
+		 * Send frame with offload metadata
+		 *
+		 * The metadata is passed through if the interface supports
+		 * offloading. Otherwise, the frame gets segmented and its
+		 * checksums completed before sending.
+		 */
+		void send(Ethernet_frame       &eth,
+		          Size_guard           &size_guard,
+		          Offload_header const &offload);
+
 		Link_list &dissolved_links(L3_protocol const protocol);
 
 		Link_list &links(L3_protocol const protocol);
@@ -475,6 +508,7 @@ class Net::Interface : private Interface_list::Element
 		Configuration       const &config()                    const { return *_config_ptr; }
 		Mac_address         const &router_mac()                const { return _router_mac; }
 		Mac_address         const &mac()                       const { return _mac; }
+		bool                       offload()                   const { return _offload; }
 		Arp_waiter_list           &own_arp_waiters()                 { return _own_arp_waiters; }
 		Arp_waiter_list           &timed_out_arp_waiters()           { return _timed_out_arp_waiters; }
 		Signal_context_capability  pkt_stream_signal_handler() const { return _pkt_stream_signal_handler; }
@@ -137,8 +137,10 @@ Net::Nic_client_interface::Nic_client_interface(Env                 &env,
 	                              &Nic_client_interface::_handle_session_link_state },
 	_interface                  { env.ep(), timer, mac_address(), alloc,
 	                              Mac_address(), config, interfaces, *rx(), *tx(),
-	                              *this }
+	                              *this, Nic::Connection::offload() }
 {
+	Nic::Packet_allocator::enable_offload(_interface.offload());
+
 	/* install packet stream signal handlers */
 	rx_channel()->sigh_packet_avail(_interface.pkt_stream_signal_handler());
 	tx_channel()->sigh_ack_avail   (_interface.pkt_stream_signal_handler());
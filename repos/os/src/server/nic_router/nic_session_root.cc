@@ -237,7 +237,8 @@ Nic_session_component(Session_env                    &session_env,
                       Session_label            const &label,
                       Interface_list                 &interfaces,
                       Configuration                  &config,
-                      Ram_dataspace_capability const  ram_ds)
+                      Ram_dataspace_capability const  ram_ds,
+                      bool                     const  offload)
 :
 	Nic_session_component_base { session_env, tx_buf_size,rx_buf_size },
 	Session_rpc_object         { _session_env, _tx_buf.ds(), _rx_buf.ds(),
@@ -245,9 +246,11 @@ Nic_session_component(Session_env                    &session_env,
 	_interface_policy          { label, _session_env, config },
 	_interface                 { _session_env.ep(), timer, router_mac, _alloc,
 	                             mac, config, interfaces, *_tx.sink(),
-	                             *_rx.source(), _interface_policy },
+	                             *_rx.source(), _interface_policy, offload },
 	_ram_ds                    { ram_ds }
 {
+	_packet_alloc.enable_offload(offload);
+
 	_interface.attach_to_domain();
 
 	/* install packet stream signal handlers */
@@ -318,7 +321,8 @@ Nic_session_component *Net::Nic_session_root::_create_session(char const *args)
 								Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 								Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 								_timer, mac, *_router_mac, label, _interfaces,
-								*_config_ptr, ram_ds);
+								*_config_ptr, ram_ds,
+								Arg_string::find_arg(args, "offload").bool_value(false));
 						}
 						catch (...) {
 							_mac_alloc.free(mac);
@@ -143,7 +143,8 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		                      Genode::Session_label            const &label,
 		                      Interface_list                         &interfaces,
 		                      Configuration                          &config,
-		                      Genode::Ram_dataspace_capability const  ram_ds);
+		                      Genode::Ram_dataspace_capability const  ram_ds,
+		                      bool                             const  offload);
 
 
 		/******************
@@ -153,6 +154,7 @@ class Net::Nic_session_component : private Nic_session_component_base,
 		Mac_address mac_address() override { return _interface.mac(); }
 		bool link_state() override;
 		void link_state_sigh(Genode::Signal_context_capability sigh) override;
+		bool offload() override { return _interface.offload(); }
 
 
 		/***************
@@ -85,7 +85,8 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
                                                         Session_label            const &label,
                                                         Interface_list                 &interfaces,
                                                         Configuration                  &config,
-                                                        Ram_dataspace_capability const  ram_ds)
+                                                        Ram_dataspace_capability const  ram_ds,
+                                                        bool                     const  offload)
 :
 	Uplink_session_component_base { session_env, tx_buf_size,rx_buf_size },
 	Session_rpc_object            { _session_env, _tx_buf.ds(), _rx_buf.ds(),
@@ -93,9 +94,11 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
 	_interface_policy             { label, _session_env, config },
 	_interface                    { _session_env.ep(), timer, mac, _alloc,
 	                                Mac_address(), config, interfaces, *_tx.sink(),
-	                                *_rx.source(), _interface_policy },
+	                                *_rx.source(), _interface_policy, offload },
 	_ram_ds                       { ram_ds }
 {
+	_packet_alloc.enable_offload(offload);
+
 	_interface.attach_to_domain();
 
 	/* install packet stream signal handlers */
@@ -160,7 +163,8 @@ Net::Uplink_session_root::_create_session(char const *args)
 					session_at, session_env,
 					Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 					Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
-					_timer, mac, label, _interfaces, *_config_ptr, ram_ds);
+					_timer, mac, label, _interfaces, *_config_ptr, ram_ds,
+					Arg_string::find_arg(args, "offload").bool_value(false));
 			});
 	}
 	catch (Out_of_ram) {
@@ -106,7 +106,15 @@ class Net::Uplink_session_component : private Uplink_session_component_base,
 		                         Genode::Session_label            const &label,
 		                         Interface_list                         &interfaces,
 		                         Configuration                          &config,
-		                         Genode::Ram_dataspace_capability const  ram_ds);
+		                         Genode::Ram_dataspace_capability const  ram_ds,
+		                         bool                             const  offload);
+
+
+		/*********************
+		 ** Uplink::Session **
+		 *********************/
+
+		bool offload() override { return _interface.offload(); }
 
 
 		/***************
@@ -224,8 +224,7 @@ struct Mixer::Mix_signal : Audio_signal
 					Float_range_ptr input_dst(_input_buffer.values, dst.num_floats);
 					input_dst.clear();
 					result |= producer.produce_sample_data(sub_tw, input_dst);
-					input_dst.scale(volume.value);
-					dst.add(input_dst);
+					dst.add_scaled(input_dst, volume.value);
 				});
 			});
 
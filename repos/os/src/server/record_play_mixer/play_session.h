@@ -15,7 +15,6 @@
 #define _PLAY_SESSION_H_
 
 /* Genode includes */
-#include <util/formatted_output.h>
 #include <root/component.h>
 #include <base/session_object.h>
 #include <play_session/play_session.h>
@@ -23,6 +22,7 @@
 /* local includes */
 #include <types.h>
 #include <time_window_scheduler.h>
+#include <resampler.h>
 
 namespace Mixer { class Play_root; }
 
@@ -59,169 +59,41 @@ class Mixer::Play_session : public Session_object<Play::Session, Play_session>,
 
 		unsigned _expected_jitter_us = 0;
 
-		/*
-		 * Cached meta data fetched from shared buffer
-		 */
-		struct Slot
-		{
-			Clock     start, end;
-			unsigned  sample_start;
-			unsigned  num_samples;
-			Play::Seq seq;
-
-			unsigned duration_us = end.us_since(start);
-
-			bool _valid() const { return duration_us > 0 && num_samples > 1; }
-
-			unsigned dt() const
-			{
-				return _valid() ? duration_us / num_samples : 0;
-			}
-
-			bool contains(Clock t) const
-			{
-				return _valid() && !start.later_than(t)
-				                &&  t.earlier_than(end);
-			}
-
-			void with_index_for_t(Clock t, auto const &fn) const
-			{
-				if (!contains(t))
-					return;
-
-				unsigned const rel_t = t.us_since(start);
-				unsigned const index = (rel_t*num_samples) / duration_us;
+		Resampler _resampler { _buffer };
 
-				fn(index);
-			}
-
-			void with_time_window_at_index(unsigned i, auto const &fn) const
-			{
-				if (i >= num_samples || !_valid())
-					return;
-
-				Clock const t_start = start.after_us((i*duration_us) / num_samples);
-
-				fn(t_start, dt());
-			}
+		using Probe_result = Resampler::Probe_result;
 
-			float u_for_t(unsigned index, Clock t) const
-			{
-				float result = 0.5f;
-				with_time_window_at_index(index, [&] (Clock const t_start, unsigned dt) {
-					result = float(t.us_since(t_start))/float(dt); });
-
-				auto clamped = [] (float v) { return min(1.0f, max(0.0f, v)); };
-
-				return clamped(result);
-			}
-
-			void print(Output &out) const
-			{
-				Genode::print(out, Time_window { start.us(), end.us() }, " seq=", seq.value());
-			}
-		};
-
-		Slot _slots[Shared_buffer::NUM_SLOTS] { };
-
-		/**
-		 * Coordinate of a sample within the shared buffer
-		 */
-		struct Position
+		void _warn_about_missing_sample(Clock const t, Probe_result const probe_result)
 		{
-			unsigned slot_id;
-			unsigned index;    /* relative to the slot's 'sample_start' */
-
-			Position next(Play_session const &session) const
-			{
-				if (index + 1 < session._slots[slot_id].num_samples)
-					return {
-						.slot_id = slot_id,
-						.index   = index + 1,
-					};
-
-				/* proceed to next slot */
-				return {
-					.slot_id = (slot_id + 1) % Shared_buffer::NUM_SLOTS,
-					.index   = 0,
-				};
-			}
-		};
+			if (!_operations.once_in_a_while() || _stopped())
+				return;
 
-		struct Probe
-		{
-			float v[4] { };
-			float u = 0.0f;
-
-			Probe(Play_session const &session, Position pos, Clock t)
-			{
-				/*
-				 * Technically, the 'u' value ought to be computed between t1
-				 * and t2 (not between t0 and t1). Since the sample values are
-				 * taken in steps of dt, the u values are the same except when
-				 * dt is not constant (when crossing slot boundaries). However,
-				 * even in this case, u_01 approximates u_12.
-				 */
-				u = session._slots[pos.slot_id].u_for_t(pos.index, t);
-
-				for (unsigned i = 0; i < 4; i++, pos = pos.next(session)) {
-					unsigned const index = session._slots[pos.slot_id].sample_start + pos.index;
-					v[i] = session._buffer.samples[index % Shared_buffer::MAX_SAMPLES];
-				}
-			}
+			bool earlier_than_avail_samples = false,
+			     later_than_avail_samples   = false;
 
-			void print(Output &out) const
-			{
-				Genode::print(out, " ", v[0], " ", v[1], "   (u:", Right_aligned(6, u), ")"
-				                   " ", v[2], " ", v[3]);
-			}
-		};
-
-		enum class Probe_result { OK, MISSING, AMBIGUOUS };
-
-		Probe_result _with_start_position_at(Clock t, auto fn) const
-		{
-			Position pos { };
+			_resampler.for_each_slot([&] (Resampler::Slot const &slot) {
+				if (slot.duration_us) {
+					if (t.earlier_than(slot.start))
+						earlier_than_avail_samples = true;
 
-			unsigned matching_slots = 0;
-
-			for (unsigned slot_id = 0; slot_id < Shared_buffer::NUM_SLOTS; slot_id++) {
-				_slots[slot_id].with_index_for_t(t, [&] (unsigned index) {
-					matching_slots++;
-					pos = Position { .slot_id = slot_id,
-					                 .index   = index, }; }); }
+					if (slot.end.earlier_than(t))
+						later_than_avail_samples = true;
+				}
+			});
 
-			if (matching_slots == 1u) {
-				fn(pos);
-				return Probe_result::OK;
+			if (probe_result == Probe_result::MISSING) {
+				if (earlier_than_avail_samples) {
+					warning("required sample value is no longer available");
+					warning("(jitter config or period too high?)");
+				}
+				else if (later_than_avail_samples) {
+					warning("required sample is not yet available");
+					warning("(increase 'jitter_ms' config attribute?)");
+				}
 			}
 
-			if (matching_slots == 0u)
-				return Probe_result::MISSING;
-
-			return Probe_result::AMBIGUOUS;
-		}
-
-		Probe_result _with_interpolated_sample_value(Clock const t, auto const &fn) const
-		{
-			return _with_start_position_at(t, [&] (Position pos) {
-
-				Probe probe(*this, pos, t);
-
-				/* b-spline blending functions (u and v denote position v1 <-> v2) */
-				float const u  = probe.u, v = 1.0f - u,
-				            uu = u*u, uuu = u*uu,
-				            vv = v*v, vvv = v*vv;
-
-				float const b0 = vvv/6.0f,
-				            b1 = uuu/2.0f - uu + 4.0f/6.0f,
-				            b2 = vvv/2.0f - vv + 4.0f/6.0f,
-				            b3 = uuu/6.0f;
-
-				float const avg = b0*probe.v[0] + b1*probe.v[1] + b2*probe.v[2] + b3*probe.v[3];
-
-				fn(avg);
-			});
+			if (probe_result == Probe_result::AMBIGUOUS)
+				warning("ambiguous sample value for t=", float(t.us())/1000);
 		}
 
 	public:
@@ -254,94 +126,16 @@ class Mixer::Play_session : public Session_object<Play::Session, Play_session>,
 		 */
 		bool produce_sample_data(Time_window tw, Float_range_ptr &samples) override
 		{
-			bool result = false;
-
-			/*
-			 * Make local copy of meta data from shared buffer to ensure
-			 * operating on consistent values during 'produce_sample_data'.
-			 * Import slot meta data only if not currently modified by the
-			 * client.
-			 */
-			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++) {
-
-				Play::Session::Shared_buffer::Slot const &src = _buffer.slots[i];
-				Slot                                     &dst = _slots[i];
-
-				dst = { };
-
-				Play::Seq const acquired_seq = src.acquired_seq;
-
-				Slot const slot { .start        = Clock { src.time_window.start },
-				                  .end          = Clock { src.time_window.end   },
-				                  .sample_start = src.sample_start.index,
-				                  .num_samples  = src.num_samples.value(),
-				                  .seq          = src.acquired_seq };
-
-				Play::Seq const committed_seq = src.committed_seq;
-
-				if (acquired_seq.value() == committed_seq.value()) {
-					dst = slot;
-
-					if (_latest_seq < slot.seq)
-						_latest_seq = slot.seq;
-				}
-			}
-
-			auto anything_scheduled = [&]
-			{
-				for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++)
-					if (_slots[i].num_samples)
-						return true;
-				return false;
-			};
+			_resampler.import_slots([&] (Play::Seq const seq) {
+				if (_latest_seq < seq)
+					_latest_seq = seq; });
 
-			if (!anything_scheduled())
+			if (!_resampler.anything_scheduled())
 				return false;
 
-			for_each_sub_window<1>(tw, samples, [&] (Time_window sub_tw, Float_range_ptr &dst) {
-
-				Clock const t { sub_tw.start };
-
-				auto probe_result = _with_interpolated_sample_value(t,
-					[&] (float v) {
-						dst.start[0] = v;
-						result = true; });
-
-				if (probe_result == Probe_result::OK)
-					return;
-
-				if (_operations.once_in_a_while() && !_stopped()) {
-
-					bool earlier_than_avail_samples = false,
-					     later_than_avail_samples   = false;
-
-					for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++) {
-						if (_slots[i].duration_us) {
-							if (t.earlier_than(_slots[i].start))
-								earlier_than_avail_samples = true;
-
-							if (_slots[i].end.earlier_than(t))
-								later_than_avail_samples = true;
-						}
-					}
-
-					if (probe_result == Probe_result::MISSING) {
-						if (earlier_than_avail_samples) {
-							warning("required sample value is no longer available");
-							warning("(jitter config or period too high?)");
-						}
-						else if (later_than_avail_samples) {
-							warning("required sample is not yet available");
-							warning("(increase 'jitter_ms' config attribute?)");
-						}
-					}
-
-					if (probe_result == Probe_result::AMBIGUOUS)
-						warning("ambiguous sample value for t=", float(t.us())/1000);
-				}
-			});
-
-			return result;
+			return _resampler.resample(tw, samples,
+				[&] (Clock const t, Probe_result const probe_result) {
+					_warn_about_missing_sample(t, probe_result); });
 		}
 
 
@@ -0,0 +1,429 @@
+/*
+ * \brief  Interpolation of the sample values of a play session
+ * \author Norman Feske
+ * \date   2023-12-13
+ */
+
+/*
+ * Copyright (C) 2023-2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _RESAMPLER_H_
+#define _RESAMPLER_H_
+
+/* Genode includes */
+#include <util/formatted_output.h>
+#include <play_session/play_session.h>
+
+/* local includes */
+#include <types.h>
+
+namespace Mixer { class Resampler; }
+
+
+/**
+ * Resampler of the time-stamped sample values found in a shared buffer
+ *
+ * Output samples are produced in blocks. The slot holding the input
+ * samples is located once for a range of output samples that fall into the
+ * same slot. The sample values and interpolation positions are gathered per
+ * output sample whereas the cubic B-spline blending is evaluated for the
+ * whole block using vector operations.
+ */
+class Mixer::Resampler
+{
+	public:
+
+		using Shared_buffer = Play::Session::Shared_buffer;
+
+		enum class Probe_result { OK, MISSING, AMBIGUOUS };
+
+		/*
+		 * Cached meta data fetched from shared buffer
+		 */
+		struct Slot
+		{
+			Clock     start, end;
+			unsigned  sample_start;
+			unsigned  num_samples;
+			Play::Seq seq;
+
+			unsigned duration_us = end.us_since(start);
+
+			bool _valid() const { return duration_us > 0 && num_samples > 1; }
+
+			unsigned dt() const
+			{
+				return _valid() ? duration_us / num_samples : 0;
+			}
+
+			bool contains(Clock t) const
+			{
+				return _valid() && !start.later_than(t)
+				                &&  t.earlier_than(end);
+			}
+
+			void with_index_for_t(Clock t, auto const &fn) const
+			{
+				if (!contains(t))
+					return;
+
+				unsigned const rel_t = t.us_since(start);
+				unsigned const index = (rel_t*num_samples) / duration_us;
+
+				fn(index);
+			}
+
+			void with_time_window_at_index(unsigned i, auto const &fn) const
+			{
+				if (i >= num_samples || !_valid())
+					return;
+
+				Clock const t_start = start.after_us((i*duration_us) / num_samples);
+
+				fn(t_start, dt());
+			}
+
+			float u_for_t(unsigned index, Clock t) const
+			{
+				float result = 0.5f;
+				with_time_window_at_index(index, [&] (Clock const t_start, unsigned dt) {
+					result = float(t.us_since(t_start))/float(dt); });
+
+				auto clamped = [] (float v) { return min(1.0f, max(0.0f, v)); };
+
+				return clamped(result);
+			}
+
+			void print(Output &out) const
+			{
+				Genode::print(out, Time_window { start.us(), end.us() }, " seq=", seq.value());
+			}
+		};
+
+		/* number of output samples interpolated at once */
+		static constexpr unsigned BLOCK_SIZE = 64;
+
+	private:
+
+		Shared_buffer const &_buffer;
+
+		Slot _slots[Shared_buffer::NUM_SLOTS] { };
+
+		/**
+		 * Coordinate of a sample within the shared buffer
+		 */
+		struct Position
+		{
+			unsigned slot_id;
+			unsigned index;    /* relative to the slot's 'sample_start' */
+
+			Position next(Resampler const &resampler) const
+			{
+				if (index + 1 < resampler._slots[slot_id].num_samples)
+					return {
+						.slot_id = slot_id,
+						.index   = index + 1,
+					};
+
+				/* proceed to next slot */
+				return {
+					.slot_id = (slot_id + 1) % Shared_buffer::NUM_SLOTS,
+					.index   = 0,
+				};
+			}
+		};
+
+		struct Probe
+		{
+			float v[4] { };
+			float u = 0.0f;
+
+			Probe(Resampler const &resampler, Position pos, Clock t)
+			{
+				Slot const &slot = resampler._slots[pos.slot_id];
+
+				/*
+				 * Technically, the 'u' value ought to be computed between t1
+				 * and t2 (not between t0 and t1). Since the sample values are
+				 * taken in steps of dt, the u values are the same except when
+				 * dt is not constant (when crossing slot boundaries). However,
+				 * even in this case, u_01 approximates u_12.
+				 */
+				u = slot.u_for_t(pos.index, t);
+
+				/* common case of all four values residing in the same slot */
+				if (pos.index + 3 < slot.num_samples) {
+					unsigned const index = slot.sample_start + pos.index;
+					for (unsigned i = 0; i < 4; i++)
+						v[i] = resampler._buffer.samples[(index + i) % Shared_buffer::MAX_SAMPLES];
+					return;
+				}
+
+				for (unsigned i = 0; i < 4; i++, pos = pos.next(resampler)) {
+					unsigned const index = resampler._slots[pos.slot_id].sample_start + pos.index;
+					v[i] = resampler._buffer.samples[index % Shared_buffer::MAX_SAMPLES];
+				}
+			}
+
+			void print(Output &out) const
+			{
+				Genode::print(out, " ", v[0], " ", v[1], "   (u:", Right_aligned(6, u), ")"
+				                   " ", v[2], " ", v[3]);
+			}
+		};
+
+		/**
+		 * Interpolation inputs gathered for a block of output samples
+		 */
+		struct Block
+		{
+			using Vec = float __attribute__((vector_size(16)));
+
+			static constexpr unsigned LANES = sizeof(Vec)/sizeof(float);
+
+			static_assert(BLOCK_SIZE % LANES == 0);
+
+			float v0[BLOCK_SIZE] { }, v1[BLOCK_SIZE] { },
+			      v2[BLOCK_SIZE] { }, v3[BLOCK_SIZE] { }, u[BLOCK_SIZE] { };
+
+			unsigned count = 0;
+
+			bool full() const { return count == BLOCK_SIZE; }
+
+			void add(Probe const &probe)
+			{
+				v0[count] = probe.v[0];
+				v1[count] = probe.v[1];
+				v2[count] = probe.v[2];
+				v3[count] = probe.v[3];
+				u [count] = probe.u;
+				count++;
+			}
+
+			static Vec _load(float const *src)
+			{
+				Vec result;
+				__builtin_memcpy(&result, src, sizeof(result));
+				return result;
+			}
+
+			/**
+			 * Write interpolated values of the gathered samples to 'dst'
+			 */
+			void interpolate(float *dst)
+			{
+				for (unsigned i = 0; i < count; i += LANES) {
+
+					/* b-spline blending functions (u and v denote position v1 <-> v2) */
+					Vec const u  = _load(&this->u[i]), v = 1.0f - u,
+					          uu = u*u, uuu = u*uu,
+					          vv = v*v, vvv = v*vv;
+
+					Vec const b0 = vvv/6.0f,
+					          b1 = uuu/2.0f - uu + 4.0f/6.0f,
+					          b2 = vvv/2.0f - vv + 4.0f/6.0f,
+					          b3 = uuu/6.0f;
+
+					Vec const avg = b0*_load(&v0[i]) + b1*_load(&v1[i])
+					              + b2*_load(&v2[i]) + b3*_load(&v3[i]);
+
+					__builtin_memcpy(dst + i, &avg, min(LANES, count - i)*sizeof(float));
+				}
+				count = 0;
+			}
+		};
+
+		/**
+		 * Span of time within which the samples originate from one slot
+		 */
+		struct Run
+		{
+			bool     valid   = false;
+			unsigned slot_id = 0;
+			Clock    end { };  /* first point in time not covered */
+
+			bool covers(Clock t) const { return valid && t.earlier_than(end); }
+		};
+
+		Probe_result _with_start_position_at(Clock t, auto fn) const
+		{
+			Position pos { };
+
+			unsigned matching_slots = 0;
+
+			for (unsigned slot_id = 0; slot_id < Shared_buffer::NUM_SLOTS; slot_id++) {
+				_slots[slot_id].with_index_for_t(t, [&] (unsigned index) {
+					matching_slots++;
+					pos = Position { .slot_id = slot_id,
+					                 .index   = index, }; }); }
+
+			if (matching_slots == 1u) {
+				fn(pos);
+				return Probe_result::OK;
+			}
+
+			if (matching_slots == 0u)
+				return Probe_result::MISSING;
+
+			return Probe_result::AMBIGUOUS;
+		}
+
+		/**
+		 * Locate slot for time 't' and determine how long it stays the only match
+		 */
+		Probe_result _locate(Clock const t, Run &run) const
+		{
+			run = { };
+
+			Probe_result const result = _with_start_position_at(t, [&] (Position pos) {
+				run = { .valid   = true,
+				        .slot_id = pos.slot_id,
+				        .end     = _slots[pos.slot_id].end }; });
+
+			if (result != Probe_result::OK)
+				return result;
+
+			/* a slot starting within the run renders later samples ambiguous */
+			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++) {
+
+				Slot const &slot = _slots[i];
+
+				if (i != run.slot_id && slot._valid() && t.earlier_than(slot.start)
+				 && slot.start.earlier_than(run.end))
+					run.end = slot.start;
+			}
+			return result;
+		}
+
+	public:
+
+		Resampler(Shared_buffer const &buffer) : _buffer(buffer) { }
+
+		/**
+		 * Make local copy of meta data from shared buffer
+		 *
+		 * The local copy ensures operating on consistent values during the
+		 * resampling. Slot meta data is imported only if not currently
+		 * modified by the client. For each imported slot, 'fn' is called with
+		 * the slot's sequence number as argument.
+		 */
+		void import_slots(auto const &fn)
+		{
+			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++) {
+
+				Shared_buffer::Slot const &src = _buffer.slots[i];
+				Slot                      &dst = _slots[i];
+
+				dst = { };
+
+				Play::Seq const acquired_seq = src.acquired_seq;
+
+				Slot const slot { .start        = Clock { src.time_window.start },
+				                  .end          = Clock { src.time_window.end   },
+				                  .sample_start = src.sample_start.index,
+				                  .num_samples  = src.num_samples.value(),
+				                  .seq          = src.acquired_seq };
+
+				Play::Seq const committed_seq = src.committed_seq;
+
+				if (acquired_seq.value() == committed_seq.value()) {
+					dst = slot;
+					fn(slot.seq);
+				}
+			}
+		}
+
+		bool anything_scheduled() const
+		{
+			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++)
+				if (_slots[i].num_samples)
+					return true;
+			return false;
+		}
+
+		void for_each_slot(auto const &fn) const
+		{
+			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++)
+				fn(_slots[i]);
+		}
+
+		/**
+		 * Interpolate single sample value at time 't'
+		 *
+		 * The functor 'fn' is called with the sample value as argument.
+		 */
+		Probe_result with_interpolated_sample_value(Clock const t, auto const &fn) const
+		{
+			return _with_start_position_at(t, [&] (Position pos) {
+				Block block { };
+				block.add(Probe(*this, pos, t));
+
+				float value = 0.0f;
+				block.interpolate(&value);
+				fn(value);
+			});
+		}
+
+		/**
+		 * Fill 'samples' with the values interpolated for time window 'tw'
+		 *
+		 * Samples that cannot be determined are left untouched. For each of
+		 * those, 'missing_fn' is called with the sample time and the
+		 * 'Probe_result' as arguments.
+		 *
+		 * \return true if at least one sample value was produced
+		 */
+		bool resample(Time_window const tw, Float_range_ptr &samples,
+		              auto const &missing_fn) const
+		{
+			if (samples.num_floats == 0)
+				return false;
+
+			Clock const start { tw.start },
+			            end   { tw.end   };
+
+			/* time per sample in 1/1024 microseconds, see 'for_each_sub_window' */
+			uint32_t const ascent { (end.us_since(start) << 10) / samples.num_floats };
+
+			bool result = false;
+
+			Block    block { };
+			unsigned block_start = 0;  /* position of 'block' within 'samples' */
+			Run      run   { };
+
+			for (unsigned i = 0; i < samples.num_floats; i++) {
+
+				Clock const t = start.after_us((i*ascent) >> 10);
+
+				Probe_result const probe_result = run.covers(t) ? Probe_result::OK
+				                                                : _locate(t, run);
+				if (probe_result != Probe_result::OK) {
+					block.interpolate(samples.start + block_start);
+					missing_fn(t, probe_result);
+					continue;
+				}
+
+				if (block.count == 0)
+					block_start = i;
+
+				_slots[run.slot_id].with_index_for_t(t, [&] (unsigned index) {
+					block.add(Probe(*this, { .slot_id = run.slot_id,
+					                         .index   = index }, t)); });
+
+				if (block.full())
+					block.interpolate(samples.start + block_start);
+
+				result = true;
+			}
+
+			block.interpolate(samples.start + block_start);
+
+			return result;
+		}
+};
+
+#endif /* _RESAMPLER_H_ */
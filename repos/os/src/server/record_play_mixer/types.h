@@ -20,6 +20,7 @@
 #include <base/session_label.h>
 #include <base/attached_ram_dataspace.h>
 #include <record_session/record_session.h>
+#include <mixer/dsp.h>
 
 namespace Mixer {
 
@@ -102,17 +103,15 @@ namespace Mixer {
 				start[i] = 0.0f;
 		}
 
-		void add(Float_range_ptr const &other)
+		void add_scaled(Float_range_ptr const &other, float const factor)
 		{
-			size_t const limit = min(num_floats, other.num_floats);
-			for (unsigned i = 0; i < limit; i++)
-				start[i] += other.start[i];
+			Dsp::add_scaled(start, other.start,
+			                min(num_floats, other.num_floats), factor);
 		}
 
 		void scale(float const factor)
 		{
-			for (size_t i = 0; i < num_floats; i++)
-				start[i] *= factor;
+			Dsp::scale(start, num_floats, factor);
 		}
 	};
 
@@ -22,10 +22,13 @@
 #include <file_system_session/rpc_object.h>
 #include <root/component.h>
 #include <os/session_policy.h>
+#include <os/reporter.h>
+#include <timer_session/connection.h>
 #include <vfs/simple_env.h>
 
 /* local includes */
 #include "node.h"
+#include "scheduling.h"
 
 
 namespace Vfs_server {
@@ -38,6 +41,7 @@ namespace Vfs_server {
 	class Root;
 
 	using Session_queue       = Genode::Fifo<Session_component>;
+	using Session_registry    = Genode::Registry<Session_component>;
 	using Io_progress_handler = Genode::Entrypoint::Io_progress_handler;
 
 	/**
@@ -121,6 +125,63 @@ class Vfs_server::Session_component : private Session_resources,
 
 		bool _stalled = false;
 
+		Read_ahead_pool _read_ahead_pool;
+
+		Session_registry::Element _registry_element;
+
+		/*
+		 * Share of the packet processing, see 'Scheduling_policy'
+		 */
+		Scheduling_policy const &_scheduling;
+
+		unsigned const _weight;
+
+		/* budget left in the current round, negative if overdrawn */
+		Genode::int64_t _deficit = 0;
+
+		/* true if requests were deferred because the budget is exhausted */
+		bool _throttled = false;
+
+		Latency_clock &_latency_clock;
+
+		Latency_histogram _latency { };
+
+		/* time the head of the submit queue started waiting, 0 if unknown */
+		Genode::uint64_t _waiting_since_us = 0;
+
+		/**
+		 * Return start time of a request imported from the submit queue
+		 */
+		Genode::uint64_t _request_start_us()
+		{
+			if (!_latency_clock.latency_enabled())
+				return 0;
+
+			Genode::uint64_t const start = _waiting_since_us
+			                             ? _waiting_since_us
+			                             : _latency_clock.now_us();
+			_waiting_since_us = 0;
+			return start;
+		}
+
+		void _record_latency(Node &node, Packet_descriptor const &packet)
+		{
+			Genode::uint64_t const start_us = node.job_start_us();
+
+			if (!start_us || !_latency_clock.latency_enabled())
+				return;
+
+			/* requests waiting for events by design are not accounted */
+			if (packet.operation() == Packet_descriptor::READ_READY
+			 || packet.operation() == Packet_descriptor::CONTENT_CHANGED)
+				return;
+
+			Genode::uint64_t const now_us = _latency_clock.now_us();
+
+			_latency.record(now_us > start_us ? now_us - start_us : 0);
+			node.job_start_us(0);
+		}
+
 
 		/****************************
 		 ** Handle to node mapping **
@@ -180,12 +241,21 @@ class Vfs_server::Session_component : private Session_resources,
 				if (!_stream.ready_to_ack())
 					break;
 
+				/* defer remaining requests to the next round */
+				if (_scheduling.enabled() && _deficit <= 0) {
+					_throttled = true;
+					break;
+				}
+
 				Packet_descriptor packet = _stream.peek_packet();
 
 				auto drop_packet_from_submit_queue = [&] ()
 				{
 					_stream.try_get_packet();
 
+					if (_scheduling.enabled())
+						_deficit -= _scheduling.cost(packet);
+
 					overall_progress      = true;
 					progress_in_iteration = true;
 				};
@@ -218,6 +288,7 @@ class Vfs_server::Session_component : private Session_resources,
 
 						case Node::Submit_result::ACCEPTED:
 							_stalled = false;
+							node.job_start_us(_request_start_us());
 							if (!node.enqueued())
 								_active_nodes.enqueue(node);
 							drop_packet_from_submit_queue();
@@ -241,6 +312,11 @@ class Vfs_server::Session_component : private Session_resources,
 				if (!progress_in_iteration)
 					break;
 			}
+
+			if (_stream.packet_avail() && !_waiting_since_us
+			 && _latency_clock.latency_enabled())
+				_waiting_since_us = _latency_clock.now_us();
+
 			return overall_progress;
 		}
 
@@ -274,7 +350,9 @@ class Vfs_server::Session_component : private Session_resources,
 				}
 
 				if (node.acknowledgement_pending()) {
-					_stream.try_ack_packet(node.dequeue_acknowledgement());
+					Packet_descriptor const packet = node.dequeue_acknowledgement();
+					_record_latency(node, packet);
+					_stream.try_ack_packet(packet);
 					progress = true;
 				}
 
@@ -317,6 +395,8 @@ class Vfs_server::Session_component : private Session_resources,
 			 */
 			unsigned iterations = 200;
 
+			_throttled = false;
+
 			for (;;) {
 
 				if (--iterations == 0)
@@ -337,19 +417,47 @@ class Vfs_server::Session_component : private Session_resources,
 				overall_progress |= progress_in_iteration;
 			}
 
+			/* an idle session does not accumulate budget */
+			if (_scheduling.enabled() && !_stream.packet_avail())
+				_deficit = Genode::min(_deficit, (Genode::int64_t)0);
+
 			_stream.wakeup();
 
 			return overall_progress ? Process_packets_result::PROGRESS
 			                        : Process_packets_result::NONE;
 		}
 
+		/**
+		 * Grant the session its share for the next scheduling round
+		 */
+		void replenish_share()
+		{
+			if (!_scheduling.enabled())
+				return;
+
+			Genode::int64_t const share = (Genode::int64_t)(_scheduling.quantum*_weight);
+
+			_deficit = Genode::min(_deficit + share, share);
+		}
+
+		bool throttled() const { return _throttled; }
+
+		Genode::uint64_t latency_count() const { return _latency.count(); }
+
+		void generate_latency_report(Genode::Xml_generator &xml) const
+		{
+			xml.attribute("label",  _label);
+			xml.attribute("weight", _weight);
+			_latency.generate(xml);
+		}
+
 		/*
 		 * This method is called from 'handle_io_progress()' whenever the
 		 * session was active.
 		 */
 		bool no_longer_active() const
 		{
-			return _active_nodes.empty() && !_stalled;
+			return _active_nodes.empty() && !_stalled && !_throttled;
 		}
 
 		bool no_longer_idle() const
@@ -368,6 +476,8 @@ class Vfs_server::Session_component : private Session_resources,
 
 			if (no_longer_idle() || _stalled)
 				_active_sessions.enqueue(*this);
+			else if (_throttled && !enqueued())
+				_active_sessions.enqueue(*this);
 
 			if (progress == Process_packets_result::TOO_MUCH_PROGRESS)
 				Genode::Signal_transmitter(_packet_stream_handler).submit();
@@ -375,9 +485,11 @@ class Vfs_server::Session_component : private Session_resources,
 			/*
 			 * The activity of the session may have an unblocking effect on
 			 * other sessions. So we call the global 'Io_progress_handler' to
-			 * attempt the packet processing of all active sessions.
+			 * attempt the packet processing of all active sessions. A
+			 * throttled session is continued by the scheduling rounds of
+			 * the global handler.
 			 */
-			if (progress == Process_packets_result::PROGRESS)
+			if (progress == Process_packets_result::PROGRESS || _throttled)
 				_io_progress_handler.handle_io_progress();
 
 			_io.commit();
@@ -449,7 +561,14 @@ class Vfs_server::Session_component : private Session_resources,
 		                  Session_queue       &active_sessions,
 		                  Io_progress_handler &io_progress_handler,
 		                  char          const *root_path,
-		                  bool                 writeable)
+		                  bool                 writeable,
+		                  Read_ahead_stats    &read_ahead_stats,
+		                  Read_ahead_registry &read_ahead_registry,
+		                  size_t               read_ahead_window,
+		                  Session_registry    &registry,
+		                  Scheduling_policy const &scheduling,
+		                  unsigned             weight,
+		                  Latency_clock       &latency_clock)
 		:
 			Session_resources(env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size),
 			Session_rpc_object(_packet_ds.cap(), env.rm(), env.ep().rpc_ep()),
@@ -460,7 +579,13 @@ class Vfs_server::Session_component : private Session_resources,
 			_active_sessions(active_sessions),
 			_root_path(root_path),
 			_label(label),
-			_writeable(writeable)
+			_writeable(writeable),
+			_read_ahead_pool(_alloc, read_ahead_stats, read_ahead_registry,
+			                 read_ahead_window, _read_ahead_limit(ram_quota)),
+			_registry_element(registry, *this),
+			_scheduling(scheduling),
+			_weight(Genode::max(weight, 1U)),
+			_latency_clock(latency_clock)
 		{
 			_tx.sigh_packet_avail(_packet_stream_handler);
 			_tx.sigh_ready_to_ack(_packet_stream_handler);
@@ -479,11 +604,20 @@ class Vfs_server::Session_component : private Session_resources,
 				_active_sessions.remove(*this);
 		}
 
+		/**
+		 * Return share of 'ram_quota' available for read-ahead buffers
+		 */
+		static size_t _read_ahead_limit(Genode::Ram_quota ram_quota) {
+			return ram_quota.value/4; }
+
 		/**
 		 * Increase quotas
 		 */
-		void upgrade(Genode::Ram_quota ram) {
-			_ram_guard.upgrade(ram); }
+		void upgrade(Genode::Ram_quota ram)
+		{
+			_ram_guard.upgrade(ram);
+			_read_ahead_pool.upgrade_limit(_read_ahead_limit(ram));
+		}
 		void upgrade(Genode::Cap_quota caps) {
 			_cap_guard.upgrade(caps); }
 
@@ -534,7 +668,8 @@ class Vfs_server::Session_component : private Session_resources,
 				_assert_valid_name(name_str);
 
 				return File_handle {
-					dir.file(_node_space, _vfs, _alloc, name_str, fs_mode, create).value
+					dir.file(_node_space, _vfs, _alloc, _read_ahead_pool,
+					         name_str, fs_mode, create).value
 				};
 			});
 		}
@@ -755,7 +890,8 @@ class Vfs_server::Session_component : private Session_resources,
 
 
 class Vfs_server::Root : public Genode::Root_component<Session_component>,
-                         private Genode::Entrypoint::Io_progress_handler
+                         private Genode::Entrypoint::Io_progress_handler,
+                         private Latency_clock
 {
 	private:
 
@@ -779,12 +915,184 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 		Genode::Signal_handler<Root> _config_handler {
 			_env.ep(), *this, &Root::_config_update };
 
+		/*
+		 * Statistics of the read-ahead of all sessions
+		 */
+		Read_ahead_stats _read_ahead_stats { };
+
+		/*
+		 * Read-ahead buffers of all sessions
+		 */
+		Read_ahead_registry _read_ahead_registry { };
+
+		struct Read_ahead_report
+		{
+			Read_ahead_stats &_stats;
+
+			Timer::Connection _timer;
+
+			Genode::Expanding_reporter _reporter;
+
+			Timer::Periodic_timeout<Read_ahead_report> _timeout;
+
+			void _handle_timeout(Genode::Duration)
+			{
+				if (!_stats.changed)
+					return;
+
+				_stats.changed = false;
+
+				_reporter.generate([&] (Genode::Xml_generator &xml) {
+					xml.attribute("hits",           _stats.hits);
+					xml.attribute("fills",          _stats.fills);
+					xml.attribute("direct_reads",   _stats.direct_reads);
+					xml.attribute("hit_rate",       _stats.hit_rate_percent());
+					xml.attribute("filled_bytes",   _stats.filled_bytes);
+					xml.attribute("served_bytes",   _stats.served_bytes);
+					xml.attribute("buffered_bytes", _stats.buffered_bytes);
+				});
+			}
+
+			Read_ahead_report(Genode::Env &env, Read_ahead_stats &stats,
+			                  Genode::Microseconds interval)
+			:
+				_stats(stats), _timer(env),
+				_reporter(env, "read_ahead", "read_ahead"),
+				_timeout(_timer, *this, &Read_ahead_report::_handle_timeout, interval)
+			{
+				_stats.changed = true;
+			}
+		};
+
+		Genode::Constructible<Read_ahead_report> _read_ahead_report { };
+
+		Scheduling_policy _scheduling = Scheduling_policy::from_xml(_config_rom.xml());
+
+		Session_registry _sessions { };
+
+		/*
+		 * Report of the per-session request latencies
+		 */
+		struct Latency_report
+		{
+			Session_registry &_sessions;
+
+			Timer::Connection _timer;
+
+			Genode::Expanding_reporter _reporter;
+
+			Timer::Periodic_timeout<Latency_report> _timeout;
+
+			Genode::uint64_t _reported_count = ~0ULL;
+
+			void _handle_timeout(Genode::Duration)
+			{
+				Genode::uint64_t count = 0;
+				_sessions.for_each([&] (Session_component const &session) {
+					count += session.latency_count(); });
+
+				if (count == _reported_count)
+					return;
+
+				_reported_count = count;
+
+				_reporter.generate([&] (Genode::Xml_generator &xml) {
+					_sessions.for_each([&] (Session_component const &session) {
+						xml.node("session", [&] () {
+							session.generate_latency_report(xml); }); }); });
+			}
+
+			Latency_report(Genode::Env &env, Session_registry &sessions,
+			               Genode::Microseconds interval)
+			:
+				_sessions(sessions), _timer(env),
+				_reporter(env, "latency", "latency"),
+				_timeout(_timer, *this, &Latency_report::_handle_timeout, interval)
+			{ }
+
+			Genode::uint64_t now_us() {
+				return _timer.curr_time().trunc_to_plain_us().value; }
+		};
+
+		Genode::Constructible<Latency_report> _latency_report { };
+
+		/**
+		 * Latency_clock interface
+		 */
+		bool latency_enabled() const override { return _latency_report.constructed(); }
+
+		Genode::uint64_t now_us() override
+		{
+			return _latency_report.constructed() ? _latency_report->now_us() : 0;
+		}
+
+		/*
+		 * Report settings of the '<report>' config node
+		 */
+		struct Report_config
+		{
+			bool     read_ahead;
+			bool     latency;
+			unsigned interval_ms;
+
+			static Report_config from_xml(Genode::Xml_node const &config)
+			{
+				Report_config result { .read_ahead  = false,
+				                       .latency     = false,
+				                       .interval_ms = 1000 };
+
+				config.with_optional_sub_node("report", [&] (Genode::Xml_node const &report) {
+					result.read_ahead  = report.attribute_value("read_ahead",  false);
+					result.latency     = report.attribute_value("latency",     false);
+					result.interval_ms = report.attribute_value("interval_ms", 1000u); });
+
+				/* a zero interval disables all reports */
+				if (!result.interval_ms)
+					result.read_ahead = result.latency = false;
+
+				return result;
+			}
+		};
+
+		Report_config _report_config { .read_ahead  = false,
+		                               .latency     = false,
+		                               .interval_ms = 0 };
+
+		/*
+		 * The timer and report sessions of the reports are re-created only if
+		 * the corresponding report settings change.
+		 */
+		void _apply_report_config()
+		{
+			Report_config const config = Report_config::from_xml(_config_rom.xml());
+
+			bool const interval_changed = (config.interval_ms != _report_config.interval_ms);
+
+			Genode::Microseconds const interval { config.interval_ms*1000UL };
+
+			if (!config.read_ahead)
+				_read_ahead_report.destruct();
+			else if (!_read_ahead_report.constructed() || interval_changed)
+				_read_ahead_report.construct(_env, _read_ahead_stats, interval);
+
+			if (!config.latency)
+				_latency_report.destruct();
+			else if (!_latency_report.constructed() || interval_changed)
+				_latency_report.construct(_env, _sessions, interval);
+
+			_report_config = config;
+		}
+
 		void _config_update()
 		{
 			_config_rom.update();
 			_config_rom.xml().with_optional_sub_node("vfs", [&] (Xml_node const &config) {
 				_vfs_env.root_dir().apply_config(config); });
 
+			_apply_report_config();
+
+			_scheduling = Scheduling_policy::from_xml(_config_rom.xml());
+
 			/*
 			 * The VFS configuration change may result in watch notifications
 			 * generated by VFS plugins. Execute 'handle_io_progress' to
@@ -820,7 +1128,8 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 					break;
 				}
 
-				bool progress = false;
+				bool progress  = false;
+				bool throttled = false;
 
 				Session_queue still_active_sessions { };
 
@@ -828,6 +1137,8 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 					using Result = Session_component::Process_packets_result;
 
+					session.replenish_share();
+
 					switch (session.process_packets()) {
 
 					case Result::PROGRESS:
@@ -842,12 +1153,23 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 						break;
 					}
 
+					throttled |= session.throttled();
+
 					if (!session.no_longer_active())
 						still_active_sessions.enqueue(session);
 				});
 
 				_active_sessions = still_active_sessions;
 
+				/*
+				 * Finish the scheduling round to let pending signals of
+				 * other sessions be handled before the next one.
+				 */
+				if (throttled) {
+					yield = true;
+					break;
+				}
+
 				if (!progress)
 					break;
 			}
@@ -914,6 +1236,17 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 			Root_path const root_path = policy.attribute_value("root", Root_path());
 			session_root.import(root_path.string(), "/");
 
+			/*
+			 * Maximum read-ahead window per file handle, read-ahead is
+			 * disabled by default because each window consumes RAM of the
+			 * session quota
+			 */
+			size_t const read_ahead_window =
+				policy.attribute_value("read_ahead", Number_of_bytes(0));
+
+			/* share of the packet processing relative to other sessions */
+			unsigned const weight = policy.attribute_value("weight", 1U);
+
 			/*
 			 * Determine if the session is writeable.
 			 * Policy overrides client argument, both default to false.
@@ -953,7 +1286,10 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 				                  tx_buf_size, _vfs_env.root_dir(),
 				                  _vfs_env.io(),
 				                  _active_sessions, *this,
-				                  session_root.base(), writeable);
+				                  session_root.base(), writeable,
+				                  _read_ahead_stats, _read_ahead_registry,
+				                  read_ahead_window,
+				                  _sessions, _scheduling, weight, *this);
 
 			auto ram_used = _env.pd().used_ram().value - initial_ram_usage;
 			auto cap_used = _env.pd().used_caps().value - initial_cap_usage;
@@ -998,6 +1334,7 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 		{
 			_env.ep().register_io_progress_handler(*this);
 			_config_rom.sigh(_config_handler);
+			_apply_report_config();
 			env.parent().announce(env.ep().manage(*this));
 		}
 };
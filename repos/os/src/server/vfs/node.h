@@ -20,6 +20,7 @@
 #include <vfs/file_system.h>
 #include <os/path.h>
 #include <base/id_space.h>
+#include <base/registry.h>
 
 /* Local includes */
 #include "assert.h"
@@ -41,6 +42,12 @@ namespace Vfs_server {
 	class File;
 	class Symlink;
 
+	struct Read_ahead_stats;
+	struct Read_ahead_buffer;
+	class  Read_ahead_pool;
+
+	using Read_ahead_registry = Genode::Registry<Read_ahead_buffer>;
+
 	using Node_space = Genode::Id_space<Node>;
 	using Node_queue = Genode::Fifo<Node>;
 
@@ -83,6 +90,134 @@ namespace Vfs_server {
 }
 
 
+/**
+ * Counters of the read-ahead of sequentially read files
+ */
+struct Vfs_server::Read_ahead_stats
+{
+	Genode::uint64_t hits;          /* reads served from a read-ahead buffer */
+	Genode::uint64_t fills;         /* backend reads filling a buffer */
+	Genode::uint64_t direct_reads;  /* backend reads without read-ahead */
+	Genode::uint64_t filled_bytes;
+	Genode::uint64_t served_bytes;
+
+	size_t buffered_bytes;          /* size of all allocated buffers */
+
+	bool changed;
+
+	unsigned hit_rate_percent() const
+	{
+		Genode::uint64_t const total = hits + fills + direct_reads;
+		return total ? unsigned((hits*100)/total) : 0;
+	}
+};
+
+
+/**
+ * Handle holding a read-ahead buffer
+ *
+ * The buffers of all sessions are registered at a server-wide registry so
+ * that writing to a file through any handle discards the data buffered for
+ * the other handles of the file.
+ */
+struct Vfs_server::Read_ahead_buffer : Genode::Interface
+{
+	/**
+	 * Discard buffered data if the handle refers to the file at 'path'
+	 */
+	virtual void invalidate_read_ahead(char const *path) = 0;
+};
+
+
+/**
+ * Session-local allocator of read-ahead buffers
+ *
+ * The buffers are allocated from the session's heap. Their total size is
+ * limited to a fraction of the session's RAM quota so that read-ahead never
+ * starves the session of quota needed for opening nodes.
+ */
+class Vfs_server::Read_ahead_pool
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Read_ahead_pool(Read_ahead_pool const &);
+		Read_ahead_pool &operator = (Read_ahead_pool const &);
+
+		Genode::Allocator &_alloc;
+
+		Read_ahead_stats &_stats;
+
+		Read_ahead_registry &_registry;
+
+		size_t const _max_window;
+
+		size_t _limit;
+		size_t _used = 0;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param max_window  maximum buffer size per file handle,
+		 *                    0 disables the read-ahead
+		 * \param limit       maximum total size of the session's buffers
+		 */
+		Read_ahead_pool(Genode::Allocator &alloc, Read_ahead_stats &stats,
+		                Read_ahead_registry &registry,
+		                size_t max_window, size_t limit)
+		:
+			_alloc(alloc), _stats(stats), _registry(registry),
+			_max_window(max_window), _limit(limit)
+		{ }
+
+		size_t max_window() const { return _max_window; }
+
+		Read_ahead_stats &stats() { return _stats; }
+
+		Read_ahead_registry &registry() { return _registry; }
+
+		/**
+		 * Discard data buffered for the file at 'path' by any session
+		 */
+		void invalidate(char const *path)
+		{
+			_registry.for_each([&] (Read_ahead_buffer &buffer) {
+				buffer.invalidate_read_ahead(path); });
+		}
+
+		void upgrade_limit(size_t bytes) { _limit += bytes; }
+
+		/**
+		 * Allocate buffer
+		 *
+		 * \return nullptr if the limit or the session quota is exceeded
+		 */
+		char *try_alloc(size_t size)
+		{
+			if (_used + size > _limit)
+				return nullptr;
+
+			return _alloc.try_alloc(size).convert<char *>(
+				[&] (void *ptr) {
+					_used                += size;
+					_stats.buffered_bytes += size;
+					return (char *)ptr; },
+				[&] (Genode::Allocator::Alloc_error) { return nullptr; });
+		}
+
+		void free(char *ptr, size_t size)
+		{
+			_alloc.free(ptr, size);
+			_used                -= size;
+			_stats.buffered_bytes -= size;
+		}
+};
+
+
 class Vfs_server::Node : Node_space::Element, Node_queue::Element
 {
 	private:
@@ -116,6 +251,9 @@ class Vfs_server::Node : Node_space::Element, Node_queue::Element
 
 		Read_ready_state _read_ready_state { Read_ready_state::DONT_CARE };
 
+		/* time the current job started waiting, 0 if not recorded */
+		Genode::uint64_t _job_start_us = 0;
+
 	public:
 
 		friend Node_queue;
@@ -208,6 +346,13 @@ class Vfs_server::Node : Node_space::Element, Node_queue::Element
 			return Packet_descriptor();
 		}
 
+		/**
+		 * Record start time of the job submitted last, for latency statistics
+		 */
+		void job_start_us(Genode::uint64_t us) { _job_start_us = us; }
+
+		Genode::uint64_t job_start_us() const { return _job_start_us; }
+
 		/**
 		 * Return true if node was written to
 		 */
@@ -308,6 +453,11 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 	protected:
 
 		Submit_result _submit_read_at(file_offset seek_offset)
+		{
+			return _submit_read_at(seek_offset, _packet.length());
+		}
+
+		Submit_result _submit_read_at(file_offset seek_offset, size_t length)
 		{
 			if (!(_mode & READ_ONLY))
 				return Submit_result::DENIED;
@@ -315,7 +465,7 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 			_handle.seek(seek_offset);
 
 			bool const queuing_succeeded =
-				_handle.fs().queue_read(&_handle, _packet.length());
+				_handle.fs().queue_read(&_handle, length);
 
 			if (queuing_succeeded)
 				_packet_in_progress = true;
@@ -694,7 +844,7 @@ struct Vfs_server::Symlink : Io_node
 };
 
 
-class Vfs_server::File : public Io_node
+class Vfs_server::File : public Io_node, private Read_ahead_buffer
 {
 	private:
 
@@ -742,6 +892,203 @@ class Vfs_server::File : public Io_node
 
 		bool _watch_read_ready = false;
 
+		/*
+		 * Read-ahead
+		 *
+		 * Once the client reads a continuous file sequentially, each backend
+		 * read fetches a window of data beyond the requested range into a
+		 * buffer. Subsequent requests are answered from the buffer without
+		 * involving the backend. The window grows with each fill up to the
+		 * maximum configured for the session. Any non-sequential access,
+		 * write, or truncation discards the buffer. Writes and truncations
+		 * through other handles of the server discard the buffered data.
+		 */
+
+		enum { SEQUENTIAL_READS_THRESHOLD = 2 };
+
+		Read_ahead_pool &_read_ahead_pool;
+
+		enum class Read_ahead_type { UNKNOWN, ENABLED, DISABLED };
+
+		Read_ahead_type _read_ahead_type = Read_ahead_type::UNKNOWN;
+
+		char       *_ra_buf      = nullptr;
+		size_t      _ra_capacity = 0;      /* allocated size of '_ra_buf' */
+		size_t      _ra_window   = 0;      /* size of the current fill */
+		file_offset _ra_start    = 0;      /* file offset of buffered data */
+		size_t      _ra_len      = 0;      /* number of valid buffered bytes */
+		bool        _ra_filling  = false;  /* current READ job fills buffer */
+		bool        _ra_outdated = false;  /* file changed during the fill */
+
+		Genode::Constructible<Read_ahead_registry::Element> _ra_registration { };
+
+		file_offset _next_read_pos    = 0;
+		unsigned    _sequential_reads = 0;
+
+		void _release_read_ahead_buffer()
+		{
+			if (_ra_buf)
+				_read_ahead_pool.free(_ra_buf, _ra_capacity);
+
+			_ra_buf      = nullptr;
+			_ra_capacity = 0;
+			_ra_window   = 0;
+			_ra_len      = 0;
+
+			_ra_registration.destruct();
+		}
+
+		/**
+		 * Discard read-ahead data of all handles after changing the file
+		 */
+		void _content_changed()
+		{
+			_release_read_ahead_buffer();
+			_read_ahead_pool.invalidate(Node::path());
+		}
+
+		bool _read_ahead_applicable()
+		{
+			if (_read_ahead_type == Read_ahead_type::UNKNOWN) {
+				_read_ahead_type = Read_ahead_type::DISABLED;
+
+				/* reading ahead of transactional files would lose data */
+				_with_stat([&] (Stat const &stat) {
+					if (stat.type == Vfs::Node_type::CONTINUOUS_FILE)
+						_read_ahead_type = Read_ahead_type::ENABLED; });
+			}
+			return _read_ahead_type == Read_ahead_type::ENABLED;
+		}
+
+		/**
+		 * Return size of the next read-ahead window, or 0 if not applicable
+		 */
+		size_t _next_read_ahead_window(size_t length)
+		{
+			size_t const max_window = _read_ahead_pool.max_window();
+
+			if (_sequential_reads < SEQUENTIAL_READS_THRESHOLD
+			 || 2*length > max_window || !_read_ahead_applicable())
+				return 0;
+
+			/* start with twice the request size, double with each fill */
+			size_t const window = _ra_window ? 2*_ra_window : 2*length;
+
+			return Genode::min(max_window, window);
+		}
+
+		bool _ensure_read_ahead_capacity(size_t size)
+		{
+			if (_ra_capacity >= size)
+				return true;
+
+			_release_read_ahead_buffer();
+
+			_ra_buf = _read_ahead_pool.try_alloc(size);
+			if (!_ra_buf)
+				return false;
+
+			_ra_capacity = size;
+			_ra_registration.construct(_read_ahead_pool.registry(),
+			                           static_cast<Read_ahead_buffer &>(*this));
+			return true;
+		}
+
+		Submit_result _submit_read(file_offset pos)
+		{
+			size_t const length = _packet.length();
+
+			Read_ahead_stats &stats = _read_ahead_pool.stats();
+
+			_sequential_reads = (pos == _next_read_pos) ? _sequential_reads + 1 : 0;
+			_next_read_pos    = pos + length;
+
+			_ra_filling = false;
+
+			if (!(mode() & READ_ONLY))
+				return Submit_result::DENIED;
+
+			/* answer request from read-ahead buffer */
+			if (_ra_len && pos >= _ra_start && pos + length <= _ra_start + _ra_len) {
+
+				Genode::memcpy(_payload_ptr.ptr, _ra_buf + (pos - _ra_start), length);
+				_acknowledge_as_success(length);
+
+				stats.hits++;
+				stats.served_bytes += length;
+				stats.changed = true;
+
+				return Submit_result::ACCEPTED;
+			}
+
+			if (_sequential_reads == 0)
+				_release_read_ahead_buffer();
+
+			size_t const window = _next_read_ahead_window(length);
+
+			if (window && _ensure_read_ahead_capacity(window)) {
+
+				Submit_result const result = _submit_read_at(pos, window);
+
+				if (result == Submit_result::ACCEPTED) {
+					_ra_filling  = true;
+					_ra_outdated = false;
+					_ra_window   = window;
+					_ra_start    = pos;
+					_ra_len      = 0;
+				}
+				return result;
+			}
+
+			Submit_result const result = _submit_read_at(pos);
+
+			if (result == Submit_result::ACCEPTED) {
+				stats.direct_reads++;
+				stats.changed = true;
+			}
+			return result;
+		}
+
+		void _execute_read_ahead_fill()
+		{
+			size_t out_count = 0;
+
+			Byte_range_ptr dst { _ra_buf, _ra_window };
+
+			switch (_handle.fs().complete_read(&_handle, dst, out_count)) {
+
+			case Read_result::READ_OK:
+				{
+					size_t const count = Genode::min(out_count, _packet.length());
+
+					Genode::memcpy(_payload_ptr.ptr, _ra_buf, count);
+					_acknowledge_as_success(count);
+
+					/* keep data only if the file was not changed meanwhile */
+					_ra_len      = _ra_outdated ? 0 : out_count;
+					_ra_filling  = false;
+					_ra_outdated = false;
+
+					Read_ahead_stats &stats = _read_ahead_pool.stats();
+					stats.fills++;
+					stats.filled_bytes += out_count;
+					stats.changed = true;
+					break;
+				}
+
+			case Read_result::READ_ERR_IO:
+			case Read_result::READ_ERR_INVALID:
+				_release_read_ahead_buffer();
+				_ra_filling = false;
+				_acknowledge_as_failure();
+				break;
+
+			case Read_result::READ_ERR_WOULD_BLOCK:
+			case Read_result::READ_QUEUED:
+				break;
+			}
+		}
+
 	protected:
 
 		static Vfs_handle &_open(Vfs::File_system  &vfs, Genode::Allocator &alloc,
@@ -760,19 +1107,38 @@ class Vfs_server::File : public Io_node
 		File(Node_space        &space,
 		     Vfs::File_system  &vfs,
 		     Genode::Allocator &alloc,
+		     Read_ahead_pool   &read_ahead_pool,
 		     char       const  *path,
 		     Mode               mode,
 		     bool               create)
 		:
 			Io_node(space, path, mode, _open(vfs, alloc, path, mode, create)),
-			_leaf_path(vfs.leaf_path(Node::path()))
+			_leaf_path(vfs.leaf_path(Node::path())),
+			_read_ahead_pool(read_ahead_pool)
 		{ }
 
+		~File() { _release_read_ahead_buffer(); }
+
 		void truncate(file_size_t size)
 		{
+			_content_changed();
+
 			assert_truncate(_handle.fs().ftruncate(&_handle, size));
 		}
 
+		/*********************************
+		 ** Read_ahead_buffer interface **
+		 *********************************/
+
+		void invalidate_read_ahead(char const *path) override
+		{
+			if (Genode::strcmp(path, Node::path()))
+				return;
+
+			_ra_len      = 0;
+			_ra_outdated = _ra_filling;
+		}
+
 		Submit_result submit_job(Packet_descriptor packet, Payload_ptr payload_ptr) override
 		{
 			_import_job(packet, payload_ptr);
@@ -782,8 +1148,10 @@ class Vfs_server::File : public Io_node
 
 			switch (packet.operation()) {
 
-			case Packet_descriptor::READ:            return _submit_read_at(_seek_pos());
-			case Packet_descriptor::WRITE:           return _submit_write_at(_seek_pos());
+			case Packet_descriptor::READ:            return _submit_read(_seek_pos());
+			case Packet_descriptor::WRITE:
+				_release_read_ahead_buffer();
+				return _submit_write_at(_seek_pos());
 			case Packet_descriptor::SYNC:            return _submit_sync();
 			case Packet_descriptor::READ_READY:      return _submit_read_ready();
 			case Packet_descriptor::CONTENT_CHANGED: return _submit_content_changed();
@@ -807,6 +1175,10 @@ class Vfs_server::File : public Io_node
 
 					size_t const consumed = _execute_write(src, _write_pos);
 
+					/* handles may have read the file since the submission */
+					if (consumed)
+						_content_changed();
+
 					if (consumed == src.num_bytes) {
 						_acknowledge_as_success(src.num_bytes);
 						break;
@@ -839,8 +1211,14 @@ class Vfs_server::File : public Io_node
 					break;
 				}
 
+			case Packet_descriptor::READ:
+				if (_ra_filling)
+					_execute_read_ahead_fill();
+				else
+					_execute_read();
+				break;
+
 			/* generic */
-			case Packet_descriptor::READ:            _execute_read(); break;
 			case Packet_descriptor::SYNC:            _execute_sync(); break;
 			case Packet_descriptor::WRITE_TIMESTAMP: _execute_write_timestamp(); break;
 
@@ -977,12 +1355,13 @@ struct Vfs_server::Directory : Io_node
 		Node_space::Id file(Node_space        &space,
 		                    Vfs::File_system  &vfs,
 		                    Genode::Allocator &alloc,
+		                    Read_ahead_pool   &read_ahead_pool,
 		                    char        const *path,
 		                    Mode               mode,
 		                    bool               create)
 		{
 			File &file = *new (alloc)
-				File(space, vfs, alloc,
+				File(space, vfs, alloc, read_ahead_pool,
 				     Path(path, Node::path()).base(), mode, create);
 
 			return file.id();
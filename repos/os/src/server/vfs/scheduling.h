@@ -0,0 +1,172 @@
+/*
+ * \brief  Scheduling of packet processing across sessions of the VFS server
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _VFS__SCHEDULING_H_
+#define _VFS__SCHEDULING_H_
+
+/* Genode includes */
+#include <util/xml_generator.h>
+#include <util/xml_node.h>
+#include <file_system_session/file_system_session.h>
+
+namespace Vfs_server {
+
+	struct Scheduling_policy;
+	class  Latency_histogram;
+	struct Latency_clock;
+}
+
+
+/**
+ * Policy of sharing the packet processing among sessions
+ *
+ * With the 'BYTES' or 'OPERATIONS' mode, sessions are served in deficit
+ * round-robin order. In each round, a session may import requests worth
+ * its quantum multiplied by its weight. A session that exhausted its share
+ * keeps the remaining requests in its submit queue until the next round.
+ */
+struct Vfs_server::Scheduling_policy
+{
+	enum class Mode { NONE, BYTES, OPERATIONS };
+
+	/* minimum cost of a request in the 'BYTES' mode */
+	static constexpr Genode::size_t MIN_BYTES_COST = 512;
+
+	Mode mode = Mode::NONE;
+
+	Genode::size_t quantum = 0;
+
+	bool enabled() const { return mode != Mode::NONE; }
+
+	Genode::size_t cost(::File_system::Packet_descriptor const &packet) const
+	{
+		if (mode == Mode::BYTES)
+			return Genode::max(packet.length(), MIN_BYTES_COST);
+
+		return 1;
+	}
+
+	/**
+	 * Obtain policy from '<scheduling>' node of the configuration
+	 *
+	 * The 'quantum' attribute defaults to 128 KiB in the 'BYTES' mode and
+	 * to 32 operations in the 'OPERATIONS' mode.
+	 */
+	static Scheduling_policy from_xml(Genode::Xml_node const &config)
+	{
+		Scheduling_policy result { };
+
+		config.with_optional_sub_node("scheduling", [&] (Genode::Xml_node const &node) {
+
+			using Mode_name = Genode::String<16>;
+			Mode_name const mode = node.attribute_value("mode", Mode_name("none"));
+
+			Genode::size_t default_quantum = 0;
+
+			if (mode == "bytes") {
+				result.mode     = Mode::BYTES;
+				default_quantum = 128*1024;
+			}
+			else if (mode == "operations") {
+				result.mode     = Mode::OPERATIONS;
+				default_quantum = 32;
+			}
+			else if (mode != "none")
+				Genode::warning("unknown scheduling mode '", mode, "'");
+
+			result.quantum = node.attribute_value("quantum",
+				Genode::Number_of_bytes(default_quantum));
+		});
+
+		if (result.enabled() && !result.quantum)
+			result.mode = Mode::NONE;
+
+		return result;
+	}
+};
+
+
+/**
+ * Distribution of request latencies in power-of-four buckets
+ */
+class Vfs_server::Latency_histogram
+{
+	public:
+
+		/* upper bound of the first bucket */
+		static constexpr Genode::uint64_t MIN_US = 64;
+
+		/* the last bucket covers all latencies of one second or more */
+		static constexpr unsigned NUM_BUCKETS = 9;
+
+	private:
+
+		Genode::uint64_t _buckets[NUM_BUCKETS] { };
+
+		Genode::uint64_t _count  = 0;
+		Genode::uint64_t _max_us = 0;
+		Genode::uint64_t _sum_us = 0;
+
+		static Genode::uint64_t _bucket_limit_us(unsigned i) {
+			return MIN_US << (2*i); }
+
+	public:
+
+		void record(Genode::uint64_t us)
+		{
+			unsigned i = 0;
+			while (i + 1 < NUM_BUCKETS && us >= _bucket_limit_us(i))
+				i++;
+
+			_buckets[i]++;
+			_count++;
+			_sum_us += us;
+			_max_us  = Genode::max(_max_us, us);
+		}
+
+		Genode::uint64_t count() const { return _count; }
+
+		void generate(Genode::Xml_generator &xml) const
+		{
+			xml.attribute("requests", _count);
+			xml.attribute("avg_us",   _count ? _sum_us/_count : 0);
+			xml.attribute("max_us",   _max_us);
+
+			for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+				xml.node("bucket", [&] () {
+					if (i + 1 < NUM_BUCKETS)
+						xml.attribute("below_us", _bucket_limit_us(i));
+					xml.attribute("count", _buckets[i]);
+				});
+			}
+		}
+};
+
+
+/**
+ * Interface for obtaining timestamps for the latency statistics
+ */
+struct Vfs_server::Latency_clock : Genode::Interface
+{
+	/**
+	 * Return true if latencies should be recorded
+	 */
+	virtual bool latency_enabled() const = 0;
+
+	/**
+	 * Return current time in microseconds
+	 */
+	virtual Genode::uint64_t now_us() = 0;
+};
+
+#endif /* _VFS__SCHEDULING_H_ */
@@ -0,0 +1,205 @@
+/*
+ * \brief  Benchmark of the audio mixers
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * For a configurable number of play sessions, one second of audio is
+ * rendered in periods of 5 ms. The CPU time is measured for the block
+ * resampler used by the mixer and for the interpolation of each sample
+ * individually.
+ *
+ * The throughput of the mixing kernels shared by both mixers is reported
+ * in samples per second for the architecture-specific and the fallback
+ * implementation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+#include <mixer/dsp.h>
+
+/* record-play-mixer includes */
+#include <resampler.h>
+
+namespace Test {
+
+	using namespace Mixer;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _sessions = max(_config.xml().attribute_value("sessions", 8u), 1u);
+
+	/* sample rates of the clients and the mixer output */
+	unsigned const _play_rate_hz   = _config.xml().attribute_value("play_rate_hz",   44100u);
+	unsigned const _record_rate_hz = _config.xml().attribute_value("record_rate_hz", 48000u);
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	using Shared_buffer = Resampler::Shared_buffer;
+
+	static constexpr unsigned PERIOD_US = 5000;
+
+	/**
+	 * Client-side state of a play session
+	 */
+	struct Session
+	{
+		Shared_buffer &buffer;
+		Resampler      resampler { buffer };
+
+		Session(Shared_buffer &buffer, unsigned seed, unsigned rate_hz)
+		:
+			buffer(buffer)
+		{
+			/* populate slots with consecutive periods */
+			unsigned const num_samples = (rate_hz*PERIOD_US)/1000000;
+
+			for (unsigned i = 0; i < Shared_buffer::NUM_SLOTS; i++) {
+				Shared_buffer::Slot &slot = buffer.slots[i];
+				slot.acquired_seq  = Play::Seq(i + 1);
+				slot.time_window   = { .start = i*PERIOD_US, .end = (i + 1)*PERIOD_US };
+				slot.sample_start  = { (i*num_samples) % Shared_buffer::MAX_SAMPLES };
+				slot.num_samples   = Play::Num_samples(num_samples);
+				slot.committed_seq = Play::Seq(i + 1);
+			}
+
+			for (unsigned i = 0; i < Shared_buffer::MAX_SAMPLES; i++)
+				buffer.samples[i] = float((i*seed) % 1000)/1000.0f - 0.5f;
+
+			resampler.import_slots([] (Play::Seq) { });
+		}
+	};
+
+	Registry<Registered_no_delete<Session>> _registry { };
+
+	Sample_buffer<512> _output { };
+
+	/**
+	 * Render one second of audio for each session using 'fn'
+	 *
+	 * \return  CPU time in microseconds
+	 */
+	uint64_t _measure(auto const &fn)
+	{
+		unsigned const periods       = 1000000/PERIOD_US;
+		unsigned const period_frames = (_record_rate_hz*PERIOD_US)/1000000;
+
+		/* skip the last slots, which lack the samples ahead */
+		unsigned const usable_periods = Shared_buffer::NUM_SLOTS - 2;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < periods; i++) {
+
+			unsigned const t = (i % usable_periods)*PERIOD_US;
+			Time_window const tw { .start = t, .end = t + PERIOD_US };
+
+			_registry.for_each([&] (Session &session) {
+				Float_range_ptr dst(_output.values, period_frames);
+				fn(session.resampler, tw, dst);
+			});
+		}
+		return _timer.elapsed_us() - start_us;
+	}
+
+	/* number of times the periods of all sessions are mixed by a kernel */
+	static constexpr unsigned KERNEL_ROUNDS = 20000;
+
+	Sample_buffer<512> _input { };
+
+	/**
+	 * Mix the input of each session into '_output' using kernel 'fn'
+	 *
+	 * \return  number of samples processed per second of CPU time
+	 */
+	uint64_t _kernel_rate(auto const &fn)
+	{
+		unsigned const n = _output.CAPACITY;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < KERNEL_ROUNDS; i++)
+			for (unsigned j = 0; j < _sessions; j++)
+				fn(_output.values, _input.values, n);
+
+		uint64_t const us = max(_timer.elapsed_us() - start_us, uint64_t(1));
+
+		return (uint64_t(KERNEL_ROUNDS)*_sessions*n*1000000)/us;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- audio-mixer benchmark ---");
+
+		for (unsigned i = 0; i < _sessions; i++)
+			new (_heap) Registered_no_delete<Session>(_registry,
+			                                          *new (_heap) Shared_buffer { },
+			                                          i + 7, _play_rate_hz);
+
+		uint64_t const block_us = _measure(
+			[&] (Resampler const &resampler, Time_window tw, Float_range_ptr &dst) {
+				resampler.resample(tw, dst, [] (Clock, Resampler::Probe_result) { }); });
+
+		uint64_t const single_us = _measure(
+			[&] (Resampler const &resampler, Time_window tw, Float_range_ptr &dst) {
+				for_each_sub_window<1>(tw, dst, [&] (Time_window sub_tw, Float_range_ptr &sample) {
+					resampler.with_interpolated_sample_value(Clock { sub_tw.start },
+						[&] (float v) { sample.start[0] = v; }); }); });
+
+		log(_sessions, " sessions, ", _play_rate_hz, " Hz -> ", _record_rate_hz, " Hz, "
+		    "CPU time per second of audio:");
+		log("  block resampler:  ", block_us,  " us");
+		log("  single samples:   ", single_us, " us");
+
+		for (unsigned i = 0; i < _input.CAPACITY; i++)
+			_input.values[i] = float((i*13) % 1000)/500.0f - 1.0f;
+
+		uint64_t const mix_rate = _kernel_rate(
+			[&] (float *dst, float const *src, unsigned n) {
+				Dsp::mix_clipped(dst, src, n, 0.5f, 0.9f); });
+
+		uint64_t const mix_slow_rate = _kernel_rate(
+			[&] (float *dst, float const *src, unsigned n) {
+				Dsp::Slow::mix_clipped(dst, src, n, 0.5f, 0.9f); });
+
+		uint64_t const add_rate = _kernel_rate(
+			[&] (float *dst, float const *src, unsigned n) {
+				Dsp::add_scaled(dst, src, n, 0.5f);
+				Dsp::scale(dst, n, 0.5f); });
+
+		uint64_t const add_slow_rate = _kernel_rate(
+			[&] (float *dst, float const *src, unsigned n) {
+				Dsp::Slow::add_scaled(dst, src, n, 0.5f);
+				Dsp::Slow::scale(dst, n, 0.5f); });
+
+		log("mixing kernels, samples per second of CPU time:");
+		log("  mix clipped:      ", mix_rate,      " (fallback ", mix_slow_rate, ")");
+		log("  add scaled:       ", add_rate,      " (fallback ", add_slow_rate, ")");
+
+		log("--- finished audio-mixer benchmark ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,199 @@
+/*
+ * \brief  Benchmark of the heap with and without size classes
+ * \author Genode Labs
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Random;
+	struct Main;
+}
+
+
+/**
+ * Xorshift pseudo-random number generator
+ */
+struct Test::Random
+{
+	uint64_t _state = 0x2545f4914f6cdd1dULL;
+
+	uint64_t next()
+	{
+		_state ^= _state << 13;
+		_state ^= _state >> 7;
+		_state ^= _state << 17;
+		return _state;
+	}
+
+	/**
+	 * Return block size biased towards small sizes
+	 */
+	size_t block_size(size_t max_size)
+	{
+		uint64_t const r = next();
+		return 1 + ((r & 3) ? (r >> 8) % 128 : (r >> 8) % max_size);
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_blocks =
+		_config.xml().attribute_value("blocks", 20000u);
+
+	unsigned const _rounds =
+		_config.xml().attribute_value("rounds", 20u);
+
+	size_t const _max_size =
+		_config.xml().attribute_value("max_size", (size_t)Heap::MAX_SIZE_CLASS);
+
+	Heap _array_heap { _env.ram(), _env.rm() };
+
+	struct Block { void *ptr; size_t size; };
+
+	Block * const _blocks =
+		(Block *)_array_heap.alloc(sizeof(Block)*_num_blocks);
+
+	static size_t _backing_store(Heap const &heap)
+	{
+		size_t total = 0;
+		heap.for_each_region([&] (void *, size_t size) { total += size; });
+		return total;
+	}
+
+	void _log_rate(char const *brief, uint64_t ops, uint64_t us)
+	{
+		log("  ", brief, ": ", ops, " operations in ", us/1000, " ms (",
+		    (ops*1000)/max(us, (uint64_t)1), " ops/ms)");
+	}
+
+	/**
+	 * Allocate all blocks and free them in allocation order
+	 */
+	void _measure_throughput(Heap &heap)
+	{
+		Random random { };
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned round = 0; round < _rounds; round++) {
+
+			for (unsigned i = 0; i < _num_blocks; i++) {
+				size_t const size = random.block_size(_max_size);
+				_blocks[i] = { heap.alloc(size), size };
+			}
+
+			for (unsigned i = 0; i < _num_blocks; i++)
+				heap.free(_blocks[i].ptr, _blocks[i].size);
+		}
+
+		_log_rate("alloc/free", 2ull*_rounds*_num_blocks,
+		          _timer.elapsed_us() - start_us);
+	}
+
+	/**
+	 * Randomly replace blocks of a live set and measure fragmentation
+	 */
+	void _measure_churn(Heap &heap)
+	{
+		Random random { };
+
+		size_t live = 0;
+
+		for (unsigned i = 0; i < _num_blocks; i++) {
+			size_t const size = random.block_size(_max_size);
+			_blocks[i] = { heap.alloc(size), size };
+			live += size;
+		}
+
+		uint64_t const ops      = uint64_t(_rounds)*_num_blocks;
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (uint64_t n = 0; n < ops; n++) {
+
+			Block &block = _blocks[random.next() % _num_blocks];
+
+			heap.free(block.ptr, block.size);
+			live -= block.size;
+
+			size_t const size = random.block_size(_max_size);
+			block = { heap.alloc(size), size };
+			live += size;
+		}
+
+		uint64_t const us = _timer.elapsed_us() - start_us;
+
+		size_t const backing_store = _backing_store(heap);
+
+		_log_rate("churn", 2*ops, us);
+		log("  live: ", live/1024, " KiB, backing store: ", backing_store/1024,
+		    " KiB, overhead: ", ((backing_store - live)*100)/max(live, (size_t)1), "%");
+
+		for (unsigned i = 0; i < _num_blocks; i++)
+			heap.free(_blocks[i].ptr, _blocks[i].size);
+	}
+
+	void _run(char const *brief, bool size_classes)
+	{
+		Heap heap { _env.ram(), _env.rm() };
+
+		heap.size_classes(size_classes);
+
+		log(brief, ":");
+
+		_measure_throughput(heap);
+		_measure_churn(heap);
+
+		heap.for_each_size_class([&] (Heap::Size_class_info const &info) {
+			if (info.chunks)
+				log("  size class ", info.slot_size, ": ",
+				    info.chunks, " chunks, ",
+				    info.used_slots, "/", info.total_slots, " slots used"); });
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- heap benchmark (", _num_blocks, " blocks, ", _rounds, " rounds, "
+		    "max size ", _max_size, ") ---");
+
+		_run("AVL allocator", false);
+		_run("size classes",  true);
+
+		_array_heap.free(_blocks, sizeof(Block)*_num_blocks);
+
+		log("--- finished heap benchmark ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,209 @@
+/*
+ * \brief  Benchmark for the route resolution of the sandbox library
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The benchmark generates a '<route>' node with many service-specific rules,
+ * each accompanied by a label-prefix rule, followed by a wildcard fallback.
+ * It resolves a large number of session requests against the indexed
+ * 'Route_model' and compares the result with a linear traversal of the
+ * route node as a reference.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/child.h>
+#include <os/session_policy.h>
+#include <os/buffered_xml.h>
+#include <timer_session/connection.h>
+
+/* sandbox-internal includes */
+#include <types.h>
+#include <utils.h>
+#include <route_model.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _num_services =
+		_config.xml().attribute_value("services", 200u);
+
+	unsigned const _num_queries =
+		_config.xml().attribute_value("queries", 100000u);
+
+	using Name = Child_policy::Name;
+
+	Name const _child_name { "bench" };
+
+	struct Bench_service : Service
+	{
+		Bench_service(Name const &name) : Service(name) { }
+
+		void initiate_request(Session_state &) override { }
+	};
+
+	Bench_service _child_service  { "child"  };
+	Bench_service _parent_service { "parent" };
+
+	static Service::Name _service_name(unsigned i) {
+		return { "Service_", i }; }
+
+	Session_label _label(unsigned i) const {
+		return { _child_name, " -> client_", i, " -> session" }; }
+
+	Constructible<Buffered_xml> _route { };
+
+	void _generate_route(Xml_generator &xml)
+	{
+		for (unsigned i = 0; i < _num_services; i++) {
+			xml.node("service", [&] {
+				xml.attribute("name", _service_name(i));
+				xml.attribute("label_prefix", String<32>("client_", i));
+				xml.node("child", [&] {
+					xml.attribute("name", String<32>("server_", i)); });
+			});
+			xml.node("service", [&] {
+				xml.attribute("name", _service_name(i));
+				xml.node("parent", [&] { });
+			});
+		}
+		xml.node("any-service", [&] {
+			xml.node("parent", [&] { }); });
+	}
+
+	Child_policy::Route _route_to_target(Xml_node const &target,
+	                                     Session_label const &label)
+	{
+		Service &service = target.has_type("child") ? (Service &)_child_service
+		                                            : (Service &)_parent_service;
+		return { service, label, Session::Diag { false } };
+	}
+
+	/**
+	 * Reference implementation traversing the route node linearly
+	 */
+	Child_policy::Route _resolve_linear(Service::Name const &service,
+	                                    Session_label const &label)
+	{
+		Constructible<Child_policy::Route> route { };
+
+		_route->xml().for_each_sub_node([&] (Xml_node const &rule) {
+			if (route.constructed())
+				return;
+
+			if (Sandbox::service_node_matches(rule, label, _child_name, service))
+				rule.for_each_sub_node([&] (Xml_node const &target) {
+					if (!route.constructed())
+						route.construct(_route_to_target(target, label)); });
+		});
+
+		if (!route.constructed())
+			throw Service_denied();
+
+		return *route;
+	}
+
+	struct Result
+	{
+		uint64_t us;
+		unsigned child_routes;
+	};
+
+	template <typename FN>
+	Result _measure(FN const &resolve_fn)
+	{
+		unsigned child_routes = 0;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < _num_queries; i++) {
+
+			/* every second query is routed to a child server */
+			unsigned const service = (i / 2) % _num_services;
+			unsigned const client  = (i & 1) ? service : service + 1;
+
+			Child_policy::Route const route =
+				resolve_fn(_service_name(service), _label(client));
+
+			if (&route.service == &_child_service)
+				child_routes++;
+		}
+
+		return { _timer.elapsed_us() - start_us, child_routes };
+	}
+
+	void _report(char const *brief, Result const &result)
+	{
+		uint64_t const us = max(result.us, 1ull);
+
+		log(brief, ": ", _num_queries, " queries in ", us / 1000, " ms, ",
+		    (uint64_t(_num_queries)*1000*1000) / us, " queries/s, ",
+		    result.child_routes, " routed to child");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		size_t const xml_size = 128*_num_services + 4096;
+		char * const xml_buf  = (char *)_heap.alloc(xml_size);
+
+		Xml_generator xml(xml_buf, xml_size, "route", [&] {
+			_generate_route(xml); });
+
+		_route.construct(_heap, Xml_node(xml_buf, xml.used()));
+		_heap.free(xml_buf, xml_size);
+
+		log("route node with ", 2*_num_services + 1, " rules");
+
+		Sandbox::Route_model route_model(_heap, _route->xml());
+
+		Result const indexed = _measure([&] (Service::Name const &service,
+		                                     Session_label const &label) {
+			Sandbox::Route_model::Query const query(_child_name, service, label);
+			return route_model.resolve(query, [&] (Xml_node const &target) {
+				return _route_to_target(target, label); });
+		});
+
+		Result const linear = _measure([&] (Service::Name const &service,
+		                                    Session_label const &label) {
+			return _resolve_linear(service, label); });
+
+		_report("indexed", indexed);
+		_report("linear",  linear);
+
+		if (indexed.child_routes != linear.child_routes) {
+			error("route mismatch between indexed and linear resolution");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("done");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,4 @@
+TARGET  = test-sandbox_route
+SRC_CC  = main.cc
+LIBS   += base
+INC_DIR += $(REP_DIR)/src/lib/sandbox
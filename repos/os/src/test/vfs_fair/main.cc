@@ -0,0 +1,243 @@
+/*
+ * \brief  Test of the weighted scheduling of the VFS server
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test is started twice. The instance with the 'heavy' role keeps the
+ * submit queue of its session filled with large writes. The instance with
+ * the 'light' role issues small reads one at a time and measures their
+ * latencies. It fails if the maximum latency exceeds the configured bound.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/allocator_avl.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/sleep.h>
+#include <file_system_session/connection.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace File_system;
+
+	using Packet_descriptor = File_system::Packet_descriptor;
+
+	struct Heavy;
+	struct Light;
+	struct Main;
+}
+
+
+/**
+ * Client that keeps its submit queue filled with writes
+ */
+struct Test::Heavy : Noncopyable
+{
+	Env &_env;
+
+	enum { CHUNK_SIZE = 64*1024, TX_BUF_SIZE = 16*CHUNK_SIZE };
+
+	Allocator_avl _avl_alloc;
+
+	File_system::Connection _fs { _env, _avl_alloc, "/", true, TX_BUF_SIZE };
+
+	File_system::Session::Tx::Source &_tx { *_fs.tx() };
+
+	Dir_handle  const _dir    { _fs.dir("/", false) };
+	File_handle const _handle { _fs.file(_dir, "heavy", WRITE_ONLY, true) };
+
+	Io_signal_handler<Heavy> _handler { _env.ep(), *this, &Heavy::_handle_io };
+
+	unsigned long _acked = 0;
+
+	void _handle_io()
+	{
+		while (_tx.ack_avail()) {
+			_tx.release_packet(_tx.get_acked_packet());
+			_acked++;
+		}
+
+		while (_tx.ready_to_submit()) {
+
+			bool const submitted = _tx.alloc_packet_attempt(CHUNK_SIZE).convert<bool>(
+				[&] (Packet_descriptor const &p) {
+					_tx.submit_packet(Packet_descriptor(p, _handle,
+					                                    Packet_descriptor::WRITE,
+					                                    CHUNK_SIZE, 0));
+					return true; },
+				[&] (auto) { return false; });
+
+			if (!submitted)
+				break;
+		}
+	}
+
+	Heavy(Env &env, Allocator &alloc) : _env(env), _avl_alloc(&alloc)
+	{
+		_fs.sigh(_handler);
+		_handle_io();
+	}
+};
+
+
+/**
+ * Client that measures the latency of small reads
+ */
+struct Test::Light : Noncopyable
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Allocator_avl _avl_alloc;
+
+	File_system::Connection _fs { _env, _avl_alloc, "/", true, 16*1024 };
+
+	File_system::Session::Tx::Source &_tx { *_fs.tx() };
+
+	Io_signal_handler<Light> _handler { _env.ep(), *this, &Light::_handle_io };
+
+	void _handle_io() { }
+
+	Dir_handle  const _dir    { _fs.dir("/", false) };
+	File_handle const _handle { _fs.file(_dir, "light", READ_WRITE, true) };
+
+	enum { REQUEST_SIZE = 512 };
+
+	/**
+	 * Submit packet and wait for its acknowledgement
+	 *
+	 * \return true if the operation succeeded
+	 */
+	bool _transfer(Packet_descriptor::Opcode op)
+	{
+		Packet_descriptor const packet(_tx.alloc_packet(REQUEST_SIZE), _handle,
+		                               op, REQUEST_SIZE, 0);
+		_tx.submit_packet(packet);
+
+		while (!_tx.ack_avail())
+			_env.ep().wait_and_dispatch_one_io_signal();
+
+		Packet_descriptor const ack = _tx.get_acked_packet();
+		bool const succeeded = ack.succeeded();
+
+		_tx.release_packet(ack);
+		return succeeded;
+	}
+
+	uint64_t _now_us() { return _timer.curr_time().trunc_to_plain_us().value; }
+
+	uint64_t max_us = 0;
+	uint64_t sum_us = 0;
+
+	/**
+	 * Issue 'count' reads spaced by 'interval_ms'
+	 *
+	 * \return false if a read failed
+	 */
+	bool measure(unsigned count, uint64_t interval_ms)
+	{
+		if (!_transfer(Packet_descriptor::WRITE))
+			return false;
+
+		for (unsigned i = 0; i < count; i++) {
+
+			_timer.msleep(interval_ms);
+
+			uint64_t const start_us = _now_us();
+
+			if (!_transfer(Packet_descriptor::READ))
+				return false;
+
+			uint64_t const latency_us = _now_us() - start_us;
+
+			max_us  = max(max_us, latency_us);
+			sum_us += latency_us;
+		}
+		return true;
+	}
+
+	Light(Env &env, Allocator &alloc) : _env(env), _avl_alloc(&alloc)
+	{
+		_fs.sigh(_handler);
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Constructible<Heavy> _heavy { };
+	Constructible<Light> _light { };
+
+	void _exit(int value)
+	{
+		_env.parent().exit(value);
+		sleep_forever();
+	}
+
+	void _run_light(Xml_node const &config)
+	{
+		unsigned const count          = config.attribute_value("requests",       100u);
+		uint64_t const interval_ms    = config.attribute_value("interval_ms",    10ull);
+		uint64_t const max_latency_ms = config.attribute_value("max_latency_ms", 100ull);
+
+		_light.construct(_env, _heap);
+
+		if (!_light->measure(count, interval_ms)) {
+			error("request failed");
+			_exit(-1);
+		}
+
+		log("requests=", count, " avg_us=", _light->sum_us/max(count, 1u),
+		    " max_us=", _light->max_us);
+
+		if (_light->max_us > max_latency_ms*1000) {
+			error("maximum latency exceeds ", max_latency_ms, " ms");
+			_exit(-1);
+		}
+
+		log("--- vfs fair scheduling test finished ---");
+		_exit(0);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		using Role = String<16>;
+		Role const role = config.attribute_value("role", Role());
+
+		if (role == "heavy")
+			_heavy.construct(_env, _heap);
+
+		else if (role == "light")
+			_run_light(config);
+
+		else {
+			error("unknown role '", role, "'");
+			_exit(-1);
+		}
+	}
+};
+
+
+void Component::construct(Genode::Env &env)
+{
+	static Test::Main main(env);
+}
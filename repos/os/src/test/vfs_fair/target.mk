@@ -0,0 +1,3 @@
+TARGET = test-vfs_fair
+SRC_CC = main.cc
+LIBS   = base
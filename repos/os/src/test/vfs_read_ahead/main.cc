@@ -0,0 +1,192 @@
+/*
+ * \brief  Test of the read-ahead of the VFS server
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The test reads a file sequentially through one handle, which lets the
+ * VFS server buffer data ahead of the read position. It then modifies the
+ * file through another handle of the same session, through a handle of
+ * another session, and truncates it, expecting each change to be visible
+ * to the reading handle.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/allocator_avl.h>
+#include <base/sleep.h>
+#include <file_system_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace File_system;
+
+	using Packet_descriptor = File_system::Packet_descriptor;
+
+	struct Client;
+	struct Main;
+}
+
+
+/**
+ * File-system session with synchronous packet transfers
+ */
+struct Test::Client : Noncopyable
+{
+	Env &_env;
+
+	Allocator_avl _avl_alloc;
+
+	File_system::Connection _fs;
+
+	File_system::Session::Tx::Source &_tx { *_fs.tx() };
+
+	Io_signal_handler<Client> _handler { _env.ep(), *this, &Client::_handle_io };
+
+	void _handle_io() { }
+
+	Dir_handle const _dir { _fs.dir("/", false) };
+
+	Client(Env &env, Allocator &alloc, size_t tx_buf_size)
+	:
+		_env(env), _avl_alloc(&alloc),
+		_fs(_env, _avl_alloc, "/", true, tx_buf_size)
+	{
+		_fs.sigh(_handler);
+	}
+
+	File_handle file(char const *name, Mode mode, bool create) {
+		return _fs.file(_dir, name, mode, create); }
+
+	void truncate(File_handle handle, file_size_t size) {
+		_fs.truncate(handle, size); }
+
+	/**
+	 * Submit packet and wait for its acknowledgement
+	 *
+	 * \return number of transferred bytes, or 0 if the operation failed
+	 */
+	size_t transfer(File_handle handle, Packet_descriptor::Opcode op,
+	                seek_off_t pos, char *buf, size_t length)
+	{
+		Packet_descriptor const packet(_tx.alloc_packet(length), handle, op,
+		                               length, pos);
+
+		if (op == Packet_descriptor::WRITE)
+			memcpy(_tx.packet_content(packet), buf, length);
+
+		_tx.submit_packet(packet);
+
+		while (!_tx.ack_avail())
+			_env.ep().wait_and_dispatch_one_io_signal();
+
+		Packet_descriptor const ack = _tx.get_acked_packet();
+
+		size_t const count = ack.succeeded() ? min(ack.length(), length) : 0;
+
+		if (op == Packet_descriptor::READ)
+			memcpy(buf, _tx.packet_content(ack), count);
+
+		_tx.release_packet(ack);
+		return count;
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	enum { FILE_SIZE = 64*1024, CHUNK_SIZE = 4*1024 };
+
+	char _buf[CHUNK_SIZE] { };
+
+	/* session of the reading handle A and the writing handle B */
+	Client _client { _env, _heap, 32*1024 };
+
+	File_handle const _handle_b { _client.file("file", READ_WRITE, true) };
+	File_handle const _handle_a { _client.file("file", READ_ONLY,  false) };
+
+	/* another session writing to the same file */
+	Client _other_client { _env, _heap, 32*1024 };
+
+	File_handle const _other_handle { _other_client.file("file", WRITE_ONLY, false) };
+
+	void _fail(auto &&... args)
+	{
+		error(args...);
+		_env.parent().exit(-1);
+		sleep_forever();
+	}
+
+	void _fill(Client &client, File_handle handle, char c)
+	{
+		for (size_t pos = 0; pos < FILE_SIZE; pos += CHUNK_SIZE) {
+			memset(_buf, c, CHUNK_SIZE);
+			if (client.transfer(handle, Packet_descriptor::WRITE,
+			                    pos, _buf, CHUNK_SIZE) != CHUNK_SIZE)
+				_fail("writing at ", pos, " failed");
+		}
+	}
+
+	/**
+	 * Read chunk at 'pos' through handle A and check its content
+	 */
+	void _expect(size_t pos, char c, size_t expected_length = CHUNK_SIZE)
+	{
+		size_t const count = _client.transfer(_handle_a, Packet_descriptor::READ,
+		                                      pos, _buf, CHUNK_SIZE);
+		if (count != expected_length)
+			_fail("read ", count, " bytes at ", pos, ", expected ", expected_length);
+
+		for (size_t i = 0; i < count; i++)
+			if (_buf[i] != c)
+				_fail("unexpected content '", Char(_buf[i]), "' at ", pos + i,
+				      ", expected '", Char(c), "'");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_fill(_client, _handle_b, 'a');
+
+		/* sequential reads make the server buffer data beyond 16 KiB */
+		for (size_t pos = 0; pos < 16*1024; pos += CHUNK_SIZE)
+			_expect(pos, 'a');
+
+		_fill(_client, _handle_b, 'b');
+		log("wrote file through other handle");
+
+		for (size_t pos = 16*1024; pos < 32*1024; pos += CHUNK_SIZE)
+			_expect(pos, 'b');
+
+		_fill(_other_client, _other_handle, 'c');
+		log("wrote file through other session");
+
+		for (size_t pos = 32*1024; pos < 48*1024; pos += CHUNK_SIZE)
+			_expect(pos, 'c');
+
+		_other_client.truncate(_other_handle, 0);
+		log("truncated file through other session");
+
+		_expect(48*1024, 0, 0);
+
+		log("--- vfs read-ahead test finished ---");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env)
+{
+	static Test::Main main(env);
+}
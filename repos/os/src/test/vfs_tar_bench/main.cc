@@ -0,0 +1,153 @@
+/*
+ * \brief  Benchmark of path lookups in the tar VFS plugin
+ * \author Genode Labs
+ * \date   2026-10-18
+ *
+ * The archive is expected to contain the files 'd<i>/f<j>' for each
+ * directory i < 'dirs' and file j < 'files' as generated by the run script.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <vfs/simple_env.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Timer::Connection _timer { _env };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _dirs   = _config.xml().attribute_value("dirs",   100u);
+	unsigned const _files  = _config.xml().attribute_value("files",  100u);
+	unsigned const _rounds = _config.xml().attribute_value("rounds", 4u);
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	uint64_t const _mount_start_us = _timer.elapsed_us();
+
+	Vfs::Simple_env _vfs_env { _env, _heap, _config.xml().sub_node("vfs") };
+
+	uint64_t const _mount_us = _timer.elapsed_us() - _mount_start_us;
+
+	Vfs::File_system &_root_dir = _vfs_env.root_dir();
+
+	using Path = String<32>;
+
+	/**
+	 * Call 'fn' for each file path in an order scattered over directories
+	 */
+	template <typename FN>
+	void _for_each_path(char const *prefix, FN const &fn)
+	{
+		unsigned const num = _dirs*_files;
+
+		auto gcd = [] (unsigned a, unsigned b) {
+			while (b) { unsigned const t = a % b; a = b; b = t; }
+			return a; };
+
+		/* stride coprime to 'num', visiting each path once */
+		unsigned stride = 7919;
+		while (gcd(num, stride) != 1)
+			stride++;
+
+		for (unsigned i = 0, n = 0; n < num; n++, i = (i + stride) % num)
+			fn(Path("/", prefix, "d", i / _files, "/f", i % _files));
+	}
+
+	void _log_rate(char const *brief, uint64_t ops, uint64_t us)
+	{
+		log("  ", brief, ": ", ops, " operations in ", us/1000, " ms (",
+		    (ops*1000)/max(us, (uint64_t)1), " ops/ms)");
+	}
+
+	template <typename FN>
+	void _measure(char const *brief, FN const &fn)
+	{
+		uint64_t ops = 0;
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned round = 0; round < _rounds; round++)
+			ops += fn();
+
+		_log_rate(brief, ops, _timer.elapsed_us() - start_us);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- tar VFS benchmark (", _dirs*_files, " files, ",
+		    _rounds, " rounds) ---");
+
+		log("  mount: ", _mount_us/1000, " ms");
+
+		_measure("stat", [&] {
+			unsigned ops = 0;
+			_for_each_path("", [&] (Path const &path) {
+				Vfs::Directory_service::Stat stat { };
+				if (_root_dir.stat(path.string(), stat) != Vfs::Directory_service::STAT_OK)
+					error("stat of ", path, " failed");
+				ops++;
+			});
+			return ops;
+		});
+
+		_measure("stat of missing files", [&] {
+			unsigned ops = 0;
+			_for_each_path("missing/", [&] (Path const &path) {
+				Vfs::Directory_service::Stat stat { };
+				if (_root_dir.stat(path.string(), stat) == Vfs::Directory_service::STAT_OK)
+					error("stat of ", path, " unexpectedly succeeded");
+				ops++;
+			});
+			return ops;
+		});
+
+		_measure("open/close", [&] {
+			unsigned ops = 0;
+			_for_each_path("", [&] (Path const &path) {
+				Vfs::Vfs_handle *handle = nullptr;
+				if (_root_dir.open(path.string(), Vfs::Directory_service::OPEN_MODE_RDONLY,
+				                   &handle, _heap) != Vfs::Directory_service::OPEN_OK) {
+					error("open of ", path, " failed");
+					return;
+				}
+				handle->close();
+				ops++;
+			});
+			return ops;
+		});
+
+		log("--- finished tar VFS benchmark ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-vfs_tar_bench
+SRC_CC = main.cc
+LIBS   = base vfs